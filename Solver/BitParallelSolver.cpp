@@ -0,0 +1,288 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <bit>
+#include <stdexcept>
+
+#include "BitParallelSolver.hpp"
+
+namespace sat {
+    template<std::size_t Words>
+    BitParallelSolver<Words>::BitParallelSolver(const std::vector<Clause> &clauses, unsigned numVariables)
+        : numVariables(numVariables), occurrenceBegin(2 * static_cast<std::size_t>(numVariables) + 1, 0) {
+        if (numVariables > 64 * Words) {
+            throw std::invalid_argument("Too many variables for the bit-parallel solver");
+        }
+
+        positive.reserve(clauses.size());
+        negative.reserve(clauses.size());
+        std::vector<const Clause *> kept;
+        for (const auto &clause: clauses) {
+            Mask p{};
+            Mask n{};
+            for (Literal l: clause) {
+                const auto x = var(l).get();
+                auto &mask = l.sign() == 1 ? p : n;
+                mask[x / 64] |= std::uint64_t{1} << (x % 64);
+            }
+
+            bool tautology = false;
+            int size = 0;
+            for (std::size_t w = 0; w < Words; ++w) {
+                tautology |= (p[w] & n[w]) != 0;
+                size += std::popcount(p[w]) + std::popcount(n[w]);
+            }
+
+            if (tautology) {
+                continue;
+            }
+
+            if (size == 0) {
+                emptyClause = true;
+                continue;
+            }
+
+            // units are assigned before the search, all other clauses are only visited through their literals
+            if (size == 1) {
+                units.emplace_back(clause.front());
+                continue;
+            }
+
+            positive.emplace_back(p);
+            negative.emplace_back(n);
+            kept.emplace_back(&clause);
+        }
+
+        for (const auto *clause: kept) {
+            for (Literal l: *clause) {
+                ++occurrenceBegin[l.get() + 1];
+            }
+        }
+
+        for (std::size_t l = 1; l < occurrenceBegin.size(); ++l) {
+            occurrenceBegin[l] += occurrenceBegin[l - 1];
+        }
+
+        occurrences.resize(occurrenceBegin.back());
+        auto fill = occurrenceBegin;
+        for (std::uint32_t c = 0; c < kept.size(); ++c) {
+            for (Literal l: *kept[c]) {
+                occurrences[fill[l.get()]++] = c;
+            }
+        }
+    }
+
+    template<std::size_t Words>
+    bool BitParallelSolver<Words>::isTrue(Literal l) const noexcept {
+        const auto x = var(l).get();
+        const auto &mask = l.sign() == 1 ? trueVariables : falseVariables;
+        return (mask[x / 64] >> (x % 64)) & 1;
+    }
+
+    template<std::size_t Words>
+    bool BitParallelSolver<Words>::isFalse(Literal l) const noexcept {
+        return isTrue(l.negate());
+    }
+
+    template<std::size_t Words>
+    void BitParallelSolver<Words>::assign(Literal l) {
+        const auto x = var(l).get();
+        auto &mask = l.sign() == 1 ? trueVariables : falseVariables;
+        mask[x / 64] |= std::uint64_t{1} << (x % 64);
+        trail.emplace_back(l);
+    }
+
+    template<std::size_t Words>
+    auto BitParallelSolver<Words>::freeLiteral(std::size_t clause) const noexcept -> std::pair<unsigned, Literal> {
+        const auto &p = positive[clause];
+        const auto &n = negative[clause];
+        std::uint64_t satisfied = 0;
+        unsigned numFree = 0;
+        std::uint64_t firstPositive = 0;
+        std::uint64_t firstNegative = 0;
+        std::size_t word = Words;
+        for (std::size_t w = 0; w < Words; ++w) {
+            const auto free = ~(trueVariables[w] | falseVariables[w]);
+            satisfied |= (p[w] & trueVariables[w]) | (n[w] & falseVariables[w]);
+            numFree += static_cast<unsigned>(std::popcount(p[w] & free) + std::popcount(n[w] & free));
+            if (word == Words && ((p[w] | n[w]) & free) != 0) {
+                word = w;
+                firstPositive = p[w] & free;
+                firstNegative = n[w] & free;
+            }
+        }
+
+        if (satisfied != 0) {
+            return {std::numeric_limits<unsigned>::max(), Literal(0)};
+        }
+
+        if (numFree == 0) {
+            return {0, Literal(0)};
+        }
+
+        const auto base = static_cast<unsigned>(64 * word);
+        // the lowest free variable of the clause, with the sign it has in the clause
+        const auto positiveBit = firstPositive != 0 ? std::countr_zero(firstPositive) : 64;
+        const auto negativeBit = firstNegative != 0 ? std::countr_zero(firstNegative) : 64;
+        return {numFree, positiveBit < negativeBit ? pos(base + static_cast<unsigned>(positiveBit))
+                                                   : neg(base + static_cast<unsigned>(negativeBit))};
+    }
+
+    template<std::size_t Words>
+    bool BitParallelSolver<Words>::propagate() {
+        while (propagationHead < trail.size()) {
+            // only clauses containing the negation of an assigned literal can become unit or falsified
+            const auto falsified = trail[propagationHead++].negate().get();
+            for (auto i = occurrenceBegin[falsified]; i < occurrenceBegin[falsified + 1]; ++i) {
+                const auto [numFree, literal] = freeLiteral(occurrences[i]);
+                if (numFree == 0) {
+                    return false;
+                }
+
+                if (numFree == 1) {
+                    assign(literal);
+                    ++statistics.propagations;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template<std::size_t Words>
+    bool BitParallelSolver<Words>::pickBranch() noexcept {
+        unsigned shortest = std::numeric_limits<unsigned>::max();
+        for (std::size_t c = 0; c < positive.size() && shortest > 2; ++c) {
+            const auto [numFree, literal] = freeLiteral(c);
+            if (numFree < shortest) {
+                shortest = numFree;
+                branch = literal;
+            }
+        }
+
+        return shortest != std::numeric_limits<unsigned>::max();
+    }
+
+    template<std::size_t Words>
+    SolverResult BitParallelSolver<Words>::solve(std::uint64_t conflictLimit) {
+        if (emptyClause) {
+            return SolverResult::Unsat;
+        }
+
+        if (terminated()) {
+            return SolverResult::Unknown;
+        }
+
+        trueVariables = {};
+        falseVariables = {};
+        trail.clear();
+        propagationHead = 0;
+        decisions.clear();
+        for (auto unit: units) {
+            if (isFalse(unit)) {
+                return SolverResult::Unsat;
+            }
+
+            if (!isTrue(unit)) {
+                assign(unit);
+            }
+        }
+
+        const auto conflictsBefore = statistics.conflicts;
+        bool consistent = propagate();
+        while (!consistent || pickBranch()) {
+            if (consistent) {
+                decisions.push_back({trueVariables, falseVariables, trail.size(), branch, false});
+                ++statistics.decisions;
+                assign(branch);
+            } else {
+                if (statistics.conflicts - conflictsBefore >= conflictLimit || terminated()) {
+                    return SolverResult::Unknown;
+                }
+
+                ++statistics.conflicts;
+
+                // chronological backtracking to the last decision whose other branch is still open
+                while (!decisions.empty() && decisions.back().flipped) {
+                    decisions.pop_back();
+                }
+
+                if (decisions.empty()) {
+                    return SolverResult::Unsat;
+                }
+
+                auto &decision = decisions.back();
+                decision.flipped = true;
+                trueVariables = decision.trueVariables;
+                falseVariables = decision.falseVariables;
+                trail.erase(trail.begin() + static_cast<std::ptrdiff_t>(decision.trailSize), trail.end());
+                propagationHead = trail.size();
+                assign(decision.literal.negate());
+            }
+
+            consistent = propagate();
+        }
+
+        model.assign(numVariables, TruthValue::False);
+        for (unsigned x = 0; x < numVariables; ++x) {
+            if ((trueVariables[x / 64] >> (x % 64)) & 1) {
+                model[x] = TruthValue::True;
+            }
+        }
+
+        return SolverResult::Sat;
+    }
+
+    template<std::size_t Words>
+    void BitParallelSolver<Words>::setTerminationFlag(const std::atomic_bool *flag) noexcept {
+        terminationFlag = flag;
+    }
+
+    template<std::size_t Words>
+    bool BitParallelSolver<Words>::terminated() const noexcept {
+        return terminationFlag != nullptr && terminationFlag->load(std::memory_order_relaxed);
+    }
+
+    template<std::size_t Words>
+    auto BitParallelSolver<Words>::getModel() const noexcept -> const std::vector<TruthValue> & {
+        return model;
+    }
+
+    template<std::size_t Words>
+    auto BitParallelSolver<Words>::getStatistics() const noexcept -> const BitParallelStatistics & {
+        return statistics;
+    }
+
+    template class BitParallelSolver<1>;
+    template class BitParallelSolver<2>;
+    template class BitParallelSolver<4>;
+
+    namespace {
+        template<std::size_t Words>
+        auto runBitParallel(const std::vector<Clause> &clauses, unsigned numVariables, std::uint64_t conflictLimit,
+                            const std::atomic_bool *terminationFlag)
+            -> std::tuple<SolverResult, std::vector<TruthValue>, BitParallelStatistics> {
+            BitParallelSolver<Words> solver(clauses, numVariables);
+            solver.setTerminationFlag(terminationFlag);
+            const auto result = solver.solve(conflictLimit);
+            return {result, solver.getModel(), solver.getStatistics()};
+        }
+    }
+
+    auto solveBitParallel(const std::vector<Clause> &clauses, unsigned numVariables, std::uint64_t conflictLimit,
+                          const std::atomic_bool *terminationFlag)
+        -> std::tuple<SolverResult, std::vector<TruthValue>, BitParallelStatistics> {
+        if (numVariables <= 64) {
+            return runBitParallel<1>(clauses, numVariables, conflictLimit, terminationFlag);
+        }
+
+        if (numVariables <= 128) {
+            return runBitParallel<2>(clauses, numVariables, conflictLimit, terminationFlag);
+        }
+
+        return runBitParallel<4>(clauses, numVariables, conflictLimit, terminationFlag);
+    }
+}
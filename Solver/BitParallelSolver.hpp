@@ -0,0 +1,139 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @file BitParallelSolver.hpp
+* @brief Contains the bit-parallel search engine for formulas with few variables
+*/
+
+#ifndef BITPARALLELSOLVER_HPP
+#define BITPARALLELSOLVER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "basic_structures.hpp"
+#include "Clause.hpp"
+#include "Solver.hpp"
+
+namespace sat {
+    /// largest number of variables supported by the BitParallelSolver
+    inline constexpr unsigned MaxBitParallelVariables = 256;
+
+    /**
+     * @brief Statistics of the bit-parallel search
+     */
+    struct BitParallelStatistics {
+        std::uint64_t decisions = 0;
+        std::uint64_t conflicts = 0;
+        std::uint64_t propagations = 0;
+    };
+
+    /**
+     * @brief Complete search for formulas with at most 64 * Words variables in which clauses and the assignment are
+     * bitmasks.
+     * @details @copybrief
+     * Each clause is stored as a mask of its positive and a mask of its negative variables, the assignment as a mask
+     * of true and a mask of false variables. A clause is satisfied if (positive & true) | (negative & false) is not
+     * empty, its free literals are (positive | negative) & ~(true | false) and a population count of these tells
+     * whether the clause is falsified, unit or open. Unit propagation checks the clauses containing the negation of
+     * each assigned literal, without watch lists or counters to maintain or undo. The masks of all clauses are stored
+     * in two contiguous arrays and the word loops are vectorized by the compiler (Words = 4 fills an AVX2 register).
+     * The search is a DPLL procedure that branches on a literal of a shortest open clause (one scan over the masks of
+     * all clauses per decision) and restores the assignment of a decision level by copying the two masks saved at the
+     * decision.
+     * @tparam Words number of 64 bit words per mask (1, 2 or 4)
+     */
+    template<std::size_t Words>
+    class BitParallelSolver {
+        using Mask = std::array<std::uint64_t, Words>;
+
+        struct Decision {
+            Mask trueVariables;
+            Mask falseVariables;
+            std::size_t trailSize;
+            Literal literal;
+            bool flipped;
+        };
+
+        unsigned numVariables;
+        std::vector<Mask> positive;
+        std::vector<Mask> negative;
+        std::vector<std::uint32_t> occurrenceBegin; ///< clauses containing l are occurrences[occurrenceBegin[l], ...)
+        std::vector<std::uint32_t> occurrences;
+        std::vector<Literal> units;
+        Mask trueVariables{};
+        Mask falseVariables{};
+        std::vector<Literal> trail;
+        std::size_t propagationHead = 0;
+        Literal branch = Literal(0);
+        bool emptyClause = false;
+        std::vector<Decision> decisions;
+        std::vector<TruthValue> model;
+        BitParallelStatistics statistics;
+        const std::atomic_bool *terminationFlag = nullptr;
+
+        bool isTrue(Literal l) const noexcept;
+        bool isFalse(Literal l) const noexcept;
+        void assign(Literal l);
+        auto freeLiteral(std::size_t clause) const noexcept -> std::pair<unsigned, Literal>;
+        bool propagate();
+        bool pickBranch() noexcept;
+        bool terminated() const noexcept;
+
+    public:
+        /**
+         * Ctor
+         * @param clauses clauses of the formula
+         * @param numVariables number of variables in the formula
+         * @throws std::invalid_argument if the formula has more than 64 * Words variables
+         */
+        BitParallelSolver(const std::vector<Clause> &clauses, unsigned numVariables);
+
+        /**
+         * Runs the search
+         * @param conflictLimit the search is interrupted after this number of conflicts
+         * @return SolverResult::Sat if a model was found (accessible via getModel()), SolverResult::Unsat if the
+         * formula is unsatisfiable, SolverResult::Unknown if the search was interrupted
+         */
+        SolverResult solve(std::uint64_t conflictLimit = std::numeric_limits<std::uint64_t>::max());
+
+        /**
+         * Sets a flag that is polled during the search. Once the flag is set, solve() returns SolverResult::Unknown
+         * @param flag termination flag (nullptr to disable). Must outlive the search or be reset
+         */
+        void setTerminationFlag(const std::atomic_bool *flag) noexcept;
+
+        /**
+         * Gets the model found by the search
+         * @return vector of truth values for each variable (empty if no model was found)
+         */
+        auto getModel() const noexcept -> const std::vector<TruthValue> &;
+
+        /**
+         * Gets the search statistics
+         * @return statistics
+         */
+        auto getStatistics() const noexcept -> const BitParallelStatistics &;
+    };
+
+    /**
+     * Solves a formula with the BitParallelSolver using the smallest mask width that fits the variables
+     * @param clauses clauses of the formula
+     * @param numVariables number of variables in the formula (at most MaxBitParallelVariables)
+     * @param conflictLimit the search is interrupted after this number of conflicts
+     * @param terminationFlag the search is interrupted once this flag is set (nullptr: never)
+     * @return search result, model (empty unless the result is SolverResult::Sat) and statistics
+     * @throws std::invalid_argument if the formula has more than MaxBitParallelVariables variables
+     */
+    auto solveBitParallel(const std::vector<Clause> &clauses, unsigned numVariables,
+                          std::uint64_t conflictLimit = std::numeric_limits<std::uint64_t>::max(),
+                          const std::atomic_bool *terminationFlag = nullptr)
+        -> std::tuple<SolverResult, std::vector<TruthValue>, BitParallelStatistics>;
+}
+
+#endif //BITPARALLELSOLVER_HPP
@@ -0,0 +1,278 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <utility>
+
+#include "CardinalityConstraints.hpp"
+
+namespace sat {
+    namespace {
+        std::uint64_t hashLiterals(const std::vector<unsigned> &literals) noexcept {
+            std::uint64_t hash = 14695981039346656037ull;
+            for (auto l: literals) {
+                hash = (hash ^ l) * 1099511628211ull;
+            }
+
+            return hash;
+        }
+
+        /**
+         * Calls f with every subset of the given size of {0, ..., n - 1} (indices in increasing order) until f returns
+         * false
+         * @return false if f returned false, true otherwise
+         */
+        template<typename F>
+        bool forEachSubset(std::size_t n, std::size_t size, F &&f) {
+            if (size > n) {
+                return true;
+            }
+
+            std::vector<std::size_t> indices(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                indices[i] = i;
+            }
+
+            while (true) {
+                if (!f(indices)) {
+                    return false;
+                }
+
+                auto i = size;
+                while (i > 0 && indices[i - 1] == n - size + i - 1) {
+                    --i;
+                }
+
+                if (i == 0) {
+                    return true;
+                }
+
+                ++indices[i - 1];
+                for (auto j = i; j < size; ++j) {
+                    indices[j] = indices[j - 1] + 1;
+                }
+            }
+        }
+    }
+
+    auto findCardinalities(const std::vector<Clause> &clauses,
+                           unsigned maxBound) -> std::vector<CardinalityConstraint> {
+        std::size_t numLiterals = 0;
+        for (const auto &clause: clauses) {
+            for (Literal l: clause) {
+                numLiterals = std::max<std::size_t>(numLiterals, l.get() + 2);
+            }
+        }
+
+        std::vector<CardinalityConstraint> constraints;
+        std::vector<char> used(clauses.size(), 0);
+        std::vector<std::vector<unsigned>> sorted(clauses.size());
+        std::vector<unsigned> stamps(numLiterals, 0);
+        std::vector<unsigned> sharedMembers(numLiterals, 0);
+        std::vector<unsigned> tokens(numLiterals, 0);
+        unsigned token = 0;
+        unsigned stamp = 0;
+        for (unsigned bound = 1; bound <= maxBound; ++bound) {
+            const auto size = bound + 1;
+            std::vector<std::pair<std::uint64_t, std::size_t>> index; ///< sorted by the hash of the literals
+            std::vector<std::vector<std::size_t>> occurrences(numLiterals);
+            std::vector<std::size_t> candidates;
+            for (std::size_t i = 0; i < clauses.size(); ++i) {
+                if (clauses[i].size() != size) {
+                    continue;
+                }
+
+                auto &literals = sorted[i];
+                literals.clear();
+                for (Literal l: clauses[i]) {
+                    literals.emplace_back(l.get());
+                }
+
+                std::ranges::sort(literals);
+                if (std::ranges::adjacent_find(literals, [](auto a, auto b) { return a / 2 == b / 2; }) !=
+                    literals.end()) {
+                    continue;
+                }
+
+                candidates.emplace_back(i);
+                index.emplace_back(hashLiterals(literals), i);
+                for (auto l: literals) {
+                    occurrences[l].emplace_back(i);
+                }
+            }
+
+            std::ranges::sort(index);
+            // index of an unused clause with the given literals
+            const auto find = [&](const std::vector<unsigned> &literals) -> std::optional<std::size_t> {
+                const auto hash = hashLiterals(literals);
+                auto it = std::ranges::lower_bound(index, hash, {}, [](const auto &entry) { return entry.first; });
+                for (; it != index.end() && it->first == hash; ++it) {
+                    if (!used[it->second] && sorted[it->second] == literals) {
+                        return it->second;
+                    }
+                }
+
+                return {};
+            };
+
+            std::vector<unsigned> members;
+            std::vector<unsigned> extensions;
+            std::vector<unsigned> key;
+            for (auto seed: candidates) {
+                if (used[seed]) {
+                    continue;
+                }
+
+                // the constraint is grown by literals that share a clause with every literal of the seed
+                members = sorted[seed];
+                ++stamp;
+                for (auto l: members) {
+                    stamps[l] = stamps[l ^ 1] = stamp;
+                }
+
+                extensions.clear();
+                for (auto l: members) {
+                    ++token;
+                    for (auto c: occurrences[l]) {
+                        for (auto e: sorted[c]) {
+                            if (!used[c] && stamps[e] != stamp && tokens[e] != token) {
+                                tokens[e] = token;
+                                if (sharedMembers[e]++ == 0) {
+                                    extensions.emplace_back(e);
+                                }
+                            }
+                        }
+                    }
+                }
+
+                const auto seedSize = members.size();
+                for (auto e: extensions) {
+                    const bool all = sharedMembers[e] == seedSize && stamps[e] != stamp &&
+                                     forEachSubset(members.size(), bound, [&](const auto &subset) {
+                                         key.clear();
+                                         for (auto i: subset) {
+                                             key.emplace_back(members[i]);
+                                         }
+
+                                         key.emplace_back(e);
+                                         std::ranges::sort(key);
+                                         return find(key).has_value();
+                                     });
+
+                    if (all) {
+                        members.emplace_back(e);
+                        stamps[e] = stamps[e ^ 1] = stamp;
+                    }
+                }
+
+                for (auto e: extensions) {
+                    sharedMembers[e] = 0;
+                }
+
+                if (members.size() < size + 1) {
+                    continue;
+                }
+
+                CardinalityConstraint constraint{.literals = {}, .bound = bound, .clauses = {}};
+                forEachSubset(members.size(), size, [&](const auto &subset) {
+                    key.clear();
+                    for (auto i: subset) {
+                        key.emplace_back(members[i]);
+                    }
+
+                    std::ranges::sort(key);
+                    const auto clause = find(key);
+                    used[*clause] = 1;
+                    constraint.clauses.emplace_back(*clause);
+                    return true;
+                });
+
+                for (auto l: members) {
+                    constraint.literals.emplace_back(Literal(l).negate());
+                }
+
+                constraints.emplace_back(std::move(constraint));
+            }
+        }
+
+        return constraints;
+    }
+
+    bool countingConflict(const std::vector<CardinalityConstraint> &constraints, const std::vector<Clause> &clauses,
+                          const std::vector<TruthValue> &model) {
+        const auto value = [&model](Literal l) {
+            const auto x = var(l).get();
+            if (x >= model.size() || model[x] == TruthValue::Undefined) {
+                return TruthValue::Undefined;
+            }
+
+            return (model[x] == TruthValue::True) == (l.sign() > 0) ? TruthValue::True : TruthValue::False;
+        };
+
+        // every unassigned literal is charged to the first constraint containing it
+        constexpr auto None = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> owners;
+        std::vector<long> capacities(constraints.size(), 0);
+        for (std::size_t c = 0; c < constraints.size(); ++c) {
+            capacities[c] = constraints[c].bound;
+            for (Literal l: constraints[c].literals) {
+                if (value(l) == TruthValue::True) {
+                    --capacities[c];
+                } else if (value(l) == TruthValue::Undefined) {
+                    owners.resize(std::max<std::size_t>(owners.size(), l.get() + 1), None);
+                    if (owners[l.get()] == None) {
+                        owners[l.get()] = c;
+                    }
+                }
+            }
+        }
+
+        std::vector<const Clause *> covered;
+        for (const auto &clause: clauses) {
+            if (std::ranges::any_of(clause, [&value](Literal l) { return value(l) == TruthValue::True; })) {
+                continue;
+            }
+
+            const bool inConstraints = std::ranges::all_of(clause, [&](Literal l) {
+                return value(l) == TruthValue::False || (l.get() < owners.size() && owners[l.get()] != None);
+            });
+
+            if (inConstraints) {
+                covered.emplace_back(&clause);
+            }
+        }
+
+        // short clauses first, they block the fewest literals for other clauses
+        std::ranges::sort(covered, {}, [](const Clause *clause) { return clause->size(); });
+        std::vector<char> taken(owners.size(), 0);
+        std::vector<char> charged(constraints.size(), 0);
+        long demand = 0;
+        long capacity = 0;
+        for (const auto *clause: covered) {
+            if (std::ranges::any_of(*clause, [&](Literal l) {
+                return value(l) == TruthValue::Undefined && taken[l.get()];
+            })) {
+                continue;
+            }
+
+            ++demand;
+            for (Literal l: *clause) {
+                if (value(l) == TruthValue::Undefined) {
+                    taken[l.get()] = 1;
+                    const auto owner = owners[l.get()];
+                    if (!charged[owner]) {
+                        charged[owner] = 1;
+                        capacity += std::max(capacities[owner], 0l);
+                    }
+                }
+            }
+        }
+
+        return demand > capacity;
+    }
+}
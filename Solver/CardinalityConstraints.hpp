@@ -0,0 +1,51 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @file CardinalityConstraints.hpp
+* @brief Contains the detection of at-most-k constraints encoded as clauses and a counting argument on them
+*/
+
+#ifndef CARDINALITYCONSTRAINTS_HPP
+#define CARDINALITYCONSTRAINTS_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "basic_structures.hpp"
+#include "Clause.hpp"
+
+namespace sat {
+    /**
+     * @brief Cardinality constraint l1 + ... + ln <= bound
+     */
+    struct CardinalityConstraint {
+        std::vector<Literal> literals; ///< literals of distinct variables
+        unsigned bound;
+        std::vector<std::size_t> clauses; ///< indices of the clauses encoding the constraint
+    };
+
+    /**
+     * Finds at-most-k constraints encoded by the clauses. The constraint l1 + ... + ln <= k is found if all clauses
+     * ~li1 v ... v ~li(k+1) are present, i.e. for k = 1 the pairwise encoding of an at-most-one constraint. Constraints
+     * are grown greedily from a clause of size k + 1 and are only reported if they have at least k + 2 literals
+     * @param clauses clauses of the formula
+     * @param maxBound largest bound of a constraint
+     * @return constraints together with their encoding clauses. Each clause belongs to at most one constraint
+     */
+    auto findCardinalities(const std::vector<Clause> &clauses, unsigned maxBound) -> std::vector<CardinalityConstraint>;
+
+    /**
+     * Counting argument generalizing the pigeonhole principle. Clauses whose literals all occur in constraints are
+     * chosen greedily such that no two of them share a literal. Each chosen clause needs a distinct true literal but
+     * the constraints containing these literals allow at most the sum of their remaining bounds
+     * @param constraints cardinality constraints
+     * @param clauses clauses of the formula (without the encoding clauses of the constraints)
+     * @param model current assignment, assigned literals of the clauses are ignored
+     * @return true if the chosen clauses need more true literals than the constraints allow (the formula is unsat),
+     * false otherwise
+     */
+    bool countingConflict(const std::vector<CardinalityConstraint> &constraints, const std::vector<Clause> &clauses,
+                          const std::vector<TruthValue> &model);
+}
+
+#endif //CARDINALITYCONSTRAINTS_HPP
@@ -11,4 +11,44 @@
 #include "util/exception.hpp"
 
 namespace sat {
+    std::uint64_t signature(const Clause &clause) noexcept {
+        std::uint64_t sig = 0;
+        for (Literal l: clause) {
+            sig |= std::uint64_t(1) << (var(l).get() & 63u);
+        }
+
+        return sig;
+    }
+
+    SubsumptionChecker::SubsumptionChecker(std::size_t numVariables) : marks(2 * numVariables, 0) {}
+
+    void SubsumptionChecker::mark(const Clause &clause) {
+        ++stamp;
+        for (Literal l: clause) {
+            marks[l.get()] = stamp;
+        }
+    }
+
+    auto SubsumptionChecker::check(const Clause &other) const -> std::pair<Result, Literal> {
+        Literal removable = 0;
+        bool flipped = false;
+        for (Literal l: other) {
+            if (marks[l.get()] == stamp) {
+                continue;
+            }
+
+            if (flipped || marks[l.negate().get()] != stamp) {
+                return {Result::None, removable};
+            }
+
+            removable = l.negate();
+            flipped = true;
+        }
+
+        return {flipped ? Result::Strengthens : Result::Subsumes, removable};
+    }
+
+    void SubsumptionChecker::addVariable() {
+        marks.resize(marks.size() + 2, 0);
+    }
 }
@@ -10,6 +10,8 @@
 
 #include <vector>
 #include <ostream>
+#include <cstdint>
+#include <utility>
 
 #include "util/concepts.hpp"
 #include "basic_structures.hpp"
@@ -34,6 +36,61 @@ namespace sat {
      * If you want to do unit propagation using watch-literals, then you can use the template below.
      */
     using Clause = std::vector<Literal>;
+
+    /**
+     * Computes the 64-bit signature of a clause. Every variable of the clause sets one bit in the signature. If the
+     * signature of a clause a contains bits that are not set in the signature of a clause b, then a can neither
+     * subsume b nor strengthen b by self-subsuming resolution
+     * @param clause the clause
+     * @return signature of the clause
+     */
+    std::uint64_t signature(const Clause &clause) noexcept;
+
+    /**
+     * @brief Subsumption and self-subsuming resolution checks between clauses.
+     * @details @copybrief
+     * A clause is marked once using mark(). Afterwards, check() tests any number of other clauses against the marked
+     * clause in time linear in the size of the other clause.
+     */
+    class SubsumptionChecker {
+        std::vector<unsigned> marks;
+        unsigned stamp = 0;
+    public:
+        /**
+         * @brief Result of a subsumption check
+         */
+        enum class Result {
+            None, ///< no relation between the clauses
+            Subsumes, ///< the checked clause is a subset of the marked clause
+            Strengthens ///< the marked clause can be strengthened by self-subsuming resolution
+        };
+
+        /**
+         * Ctor
+         * @param numVariables number of variables in the problem
+         */
+        explicit SubsumptionChecker(std::size_t numVariables);
+
+        /**
+         * Marks the (potentially subsumed) clause
+         * @param clause the clause to mark
+         */
+        void mark(const Clause &clause);
+
+        /**
+         * Checks the given clause against the marked clause
+         * @param other potentially subsuming clause
+         * @return (Result::Subsumes, _) if other is a subset of the marked clause, (Result::Strengthens, l) if
+         * other = other' ∪ {¬l} with other' a subset of the marked clause and l contained in the marked clause. In
+         * this case l can be removed from the marked clause. (Result::None, _) otherwise
+         */
+        auto check(const Clause &other) const -> std::pair<Result, Literal>;
+
+        /**
+         * Makes room for the literals of an additional variable
+         */
+        void addVariable();
+    };
 }
 
 
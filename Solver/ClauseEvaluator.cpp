@@ -0,0 +1,223 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <stdexcept>
+
+#include "ClauseEvaluator.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define __AVX2_KERNEL__
+#include <immintrin.h>
+#endif
+
+namespace sat {
+    namespace {
+        constexpr std::uint32_t Lanes = 8;
+
+        std::size_t countUnsatisfiedScalar(const std::vector<std::uint32_t> &lanes,
+                                           const std::vector<std::uint32_t> &blockBegin, const std::uint32_t *values,
+                                           bool stopEarly) {
+            std::size_t unsatisfied = 0;
+            for (std::size_t b = 0; b + 1 < blockBegin.size(); ++b) {
+                std::uint32_t acc[Lanes] = {};
+                for (auto i = blockBegin[b]; i < blockBegin[b + 1]; i += Lanes) {
+                    for (std::uint32_t lane = 0; lane < Lanes; ++lane) {
+                        acc[lane] |= values[lanes[i + lane]];
+                    }
+                }
+
+                for (auto value: acc) {
+                    unsatisfied += value == 0;
+                }
+
+                if (stopEarly && unsatisfied > 0) {
+                    break;
+                }
+            }
+
+            return unsatisfied;
+        }
+
+        void countTrueScalar(const std::vector<std::uint32_t> &lanes, const std::vector<std::uint32_t> &blockBegin,
+                             const std::uint32_t *values, const std::vector<std::uint32_t> &order,
+                             std::uint32_t *numTrue, std::uint32_t *trueVariables) {
+            for (std::size_t b = 0; b + 1 < blockBegin.size(); ++b) {
+                std::uint32_t count[Lanes] = {};
+                std::uint32_t xors[Lanes] = {};
+                for (auto i = blockBegin[b]; i < blockBegin[b + 1]; i += Lanes) {
+                    for (std::uint32_t lane = 0; lane < Lanes; ++lane) {
+                        const auto value = values[lanes[i + lane]];
+                        count[lane] += value;
+                        xors[lane] ^= (lanes[i + lane] >> 1) & (0 - value);
+                    }
+                }
+
+                for (std::size_t lane = 0; lane < Lanes && b * Lanes + lane < order.size(); ++lane) {
+                    numTrue[order[b * Lanes + lane]] = count[lane];
+                    trueVariables[order[b * Lanes + lane]] = xors[lane];
+                }
+            }
+        }
+
+#ifdef __AVX2_KERNEL__
+        __attribute__((target("avx2")))
+        std::size_t countUnsatisfiedAvx2(const std::vector<std::uint32_t> &lanes,
+                                         const std::vector<std::uint32_t> &blockBegin, const std::uint32_t *values,
+                                         bool stopEarly) {
+            const auto *table = reinterpret_cast<const int *>(values);
+            const auto zero = _mm256_setzero_si256();
+            std::size_t unsatisfied = 0;
+            for (std::size_t b = 0; b + 1 < blockBegin.size(); ++b) {
+                auto acc = zero;
+                for (auto i = blockBegin[b]; i < blockBegin[b + 1]; i += Lanes) {
+                    const auto literals = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.data() + i));
+                    acc = _mm256_or_si256(acc, _mm256_i32gather_epi32(table, literals, 4));
+                }
+
+                const auto falsified = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(acc, zero)));
+                unsatisfied += static_cast<std::size_t>(std::popcount(static_cast<unsigned>(falsified)));
+                if (stopEarly && unsatisfied > 0) {
+                    break;
+                }
+            }
+
+            return unsatisfied;
+        }
+
+        __attribute__((target("avx2")))
+        void countTrueAvx2(const std::vector<std::uint32_t> &lanes, const std::vector<std::uint32_t> &blockBegin,
+                           const std::uint32_t *values, const std::vector<std::uint32_t> &order,
+                           std::uint32_t *numTrue, std::uint32_t *trueVariables) {
+            const auto *table = reinterpret_cast<const int *>(values);
+            const auto zero = _mm256_setzero_si256();
+            alignas(32) std::uint32_t count[Lanes];
+            alignas(32) std::uint32_t xors[Lanes];
+            for (std::size_t b = 0; b + 1 < blockBegin.size(); ++b) {
+                auto counts = zero;
+                auto variables = zero;
+                for (auto i = blockBegin[b]; i < blockBegin[b + 1]; i += Lanes) {
+                    const auto literals = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.data() + i));
+                    const auto value = _mm256_i32gather_epi32(table, literals, 4);
+                    counts = _mm256_add_epi32(counts, value);
+                    // the variable of a true literal is kept by the mask 0 - 1 = ~0
+                    variables = _mm256_xor_si256(variables, _mm256_and_si256(_mm256_srli_epi32(literals, 1),
+                                                                             _mm256_sub_epi32(zero, value)));
+                }
+
+                _mm256_store_si256(reinterpret_cast<__m256i *>(count), counts);
+                _mm256_store_si256(reinterpret_cast<__m256i *>(xors), variables);
+                for (std::size_t lane = 0; lane < Lanes && b * Lanes + lane < order.size(); ++lane) {
+                    numTrue[order[b * Lanes + lane]] = count[lane];
+                    trueVariables[order[b * Lanes + lane]] = xors[lane];
+                }
+            }
+        }
+#endif
+    }
+
+    ClauseEvaluator::ClauseEvaluator(const std::vector<Clause> &clauses, std::size_t numVariables,
+                                     EvaluationKernel kernel)
+        : numVariables(numVariables), numClauses(clauses.size()), kernel(kernel), order(clauses.size()),
+          literalValues(2 * numVariables + 2, 0) {
+        if (!supported(kernel)) {
+            throw std::invalid_argument("Evaluation kernel not supported by this cpu");
+        }
+
+        // padding of existing clauses is always false, lanes without a clause are always satisfied
+        const auto falseLiteral = static_cast<std::uint32_t>(2 * numVariables);
+        const auto trueLiteral = falseLiteral + 1;
+        literalValues[trueLiteral] = 1;
+        // clauses of similar size share a block such that little padding is needed
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::stable_sort(order, {}, [&clauses](std::uint32_t c) { return clauses[c].size(); });
+        blockBegin.emplace_back(0);
+        for (std::size_t first = 0; first < numClauses; first += Lanes) {
+            // a block of empty clauses still needs one column to mark its lanes without a clause as satisfied
+            const auto width = std::max<std::size_t>(clauses[order[std::min(first + Lanes, numClauses) - 1]].size(), 1);
+            for (std::size_t i = 0; i < width; ++i) {
+                for (std::size_t lane = first; lane < first + Lanes; ++lane) {
+                    if (lane >= numClauses) {
+                        lanes.emplace_back(trueLiteral);
+                    } else {
+                        const auto &clause = clauses[order[lane]];
+                        lanes.emplace_back(i < clause.size() ? clause[i].get() : falseLiteral);
+                    }
+                }
+            }
+
+            blockBegin.emplace_back(static_cast<std::uint32_t>(lanes.size()));
+        }
+    }
+
+    EvaluationKernel ClauseEvaluator::bestKernel() noexcept {
+        return supported(EvaluationKernel::Avx2) ? EvaluationKernel::Avx2 : EvaluationKernel::Scalar;
+    }
+
+    bool ClauseEvaluator::supported(EvaluationKernel kernel) noexcept {
+        if (kernel == EvaluationKernel::Scalar) {
+            return true;
+        }
+
+#ifdef __AVX2_KERNEL__
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+
+    void ClauseEvaluator::assign(const std::vector<TruthValue> &assignment) {
+        for (unsigned x = 0; x < numVariables; ++x) {
+            const auto value = x < assignment.size() ? assignment[x] : TruthValue::Undefined;
+            literalValues[pos(x).get()] = value == TruthValue::True;
+            literalValues[neg(x).get()] = value == TruthValue::False;
+        }
+    }
+
+    bool ClauseEvaluator::satisfies(const std::vector<TruthValue> &assignment) {
+        assign(assignment);
+#ifdef __AVX2_KERNEL__
+        if (kernel == EvaluationKernel::Avx2) {
+            return countUnsatisfiedAvx2(lanes, blockBegin, literalValues.data(), true) == 0;
+        }
+#endif
+
+        return countUnsatisfiedScalar(lanes, blockBegin, literalValues.data(), true) == 0;
+    }
+
+    std::size_t ClauseEvaluator::countUnsatisfied(const std::vector<TruthValue> &assignment) {
+        assign(assignment);
+#ifdef __AVX2_KERNEL__
+        if (kernel == EvaluationKernel::Avx2) {
+            return countUnsatisfiedAvx2(lanes, blockBegin, literalValues.data(), false);
+        }
+#endif
+
+        return countUnsatisfiedScalar(lanes, blockBegin, literalValues.data(), false);
+    }
+
+    void ClauseEvaluator::countTrueLiterals(const std::vector<TruthValue> &assignment,
+                                            std::vector<std::uint32_t> &numTrue,
+                                            std::vector<std::uint32_t> &trueVariables) {
+        assign(assignment);
+        numTrue.resize(numClauses);
+        trueVariables.resize(numClauses);
+#ifdef __AVX2_KERNEL__
+        if (kernel == EvaluationKernel::Avx2) {
+            countTrueAvx2(lanes, blockBegin, literalValues.data(), order, numTrue.data(), trueVariables.data());
+            return;
+        }
+#endif
+
+        countTrueScalar(lanes, blockBegin, literalValues.data(), order, numTrue.data(), trueVariables.data());
+    }
+
+    EvaluationKernel ClauseEvaluator::getKernel() const noexcept {
+        return kernel;
+    }
+}
@@ -0,0 +1,96 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @file ClauseEvaluator.hpp
+* @brief Contains the vectorized evaluation of a formula under a complete assignment
+*/
+
+#ifndef CLAUSEEVALUATOR_HPP
+#define CLAUSEEVALUATOR_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "basic_structures.hpp"
+#include "Clause.hpp"
+#include "util/enum.hpp"
+
+namespace sat {
+    PENUM(EvaluationKernel, Scalar, Avx2)
+
+    /**
+     * @brief Evaluates all clauses of a formula under an assignment, e.g. to verify a model.
+     * @details @copybrief
+     * The clauses are sorted by size and grouped into blocks of 8. Each block is stored transposed in a flat literal
+     * array (the i-th literals of the 8 clauses are adjacent) and padded to the size of its largest clause with a
+     * literal that is always false. Evaluating a block gathers the values of its literals one column at a time from a
+     * table indexed by literal and reduces them per clause with OR (or sums them). With AVX2 a column is a single
+     * gather of 8 values, the scalar kernel runs the same loops lane by lane. The kernel is chosen at runtime.
+     */
+    class ClauseEvaluator {
+        std::size_t numVariables;
+        std::size_t numClauses;
+        EvaluationKernel kernel;
+        std::vector<std::uint32_t> lanes; ///< block b is lanes[blockBegin[b], blockBegin[b + 1]), by column
+        std::vector<std::uint32_t> blockBegin;
+        std::vector<std::uint32_t> order; ///< lane i of the blocks holds clause order[i]
+        std::vector<std::uint32_t> literalValues; ///< 1 if the literal is true, padding literals at the end
+
+        void assign(const std::vector<TruthValue> &assignment);
+
+    public:
+        /**
+         * Ctor
+         * @param clauses clauses of the formula
+         * @param numVariables number of variables in the formula
+         * @param kernel evaluation kernel
+         * @throws std::invalid_argument if the kernel is not supported by the cpu
+         */
+        ClauseEvaluator(const std::vector<Clause> &clauses, std::size_t numVariables,
+                        EvaluationKernel kernel = bestKernel());
+
+        /**
+         * Fastest kernel supported by the cpu
+         * @return EvaluationKernel::Avx2 if available, EvaluationKernel::Scalar otherwise
+         */
+        static EvaluationKernel bestKernel() noexcept;
+
+        /**
+         * Checks whether a kernel is supported by the cpu
+         * @param kernel kernel to check
+         * @return true if the kernel can be used, false otherwise
+         */
+        static bool supported(EvaluationKernel kernel) noexcept;
+
+        /**
+         * Checks whether the assignment satisfies all clauses. Stops at the first block with a falsified clause
+         * @param assignment value of each variable. Undefined and missing variables satisfy none of their literals
+         * @return true if every clause contains a true literal, false otherwise
+         */
+        bool satisfies(const std::vector<TruthValue> &assignment);
+
+        /**
+         * Counts the clauses that are not satisfied by the assignment
+         * @param assignment value of each variable. Undefined and missing variables satisfy none of their literals
+         * @return number of clauses without a true literal
+         */
+        std::size_t countUnsatisfied(const std::vector<TruthValue> &assignment);
+
+        /**
+         * Counts the true literals of each clause
+         * @param assignment value of each variable. Undefined and missing variables satisfy none of their literals
+         * @param numTrue output: number of true literals of each clause, in the order of the clauses given to the ctor
+         * @param trueVariables output: XOR of the variables of the true literals of each clause
+         */
+        void countTrueLiterals(const std::vector<TruthValue> &assignment, std::vector<std::uint32_t> &numTrue,
+                               std::vector<std::uint32_t> &trueVariables);
+
+        /**
+         * Gets the kernel used for the evaluation
+         * @return evaluation kernel
+         */
+        EvaluationKernel getKernel() const noexcept;
+    };
+}
+
+#endif //CLAUSEEVALUATOR_HPP
@@ -0,0 +1,144 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+#include "ClauseExchange.hpp"
+
+namespace sat {
+    std::uint64_t ClauseExchange::hash(const Clause &clause) noexcept {
+        // sum of mixed literal hashes (splitmix64 finalizer) does not depend on the order of the literals
+        std::uint64_t result = 0;
+        for (Literal l: clause) {
+            std::uint64_t z = l.get() + 0x9e3779b97f4a7c15ull;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            result += z ^ (z >> 31);
+        }
+
+        return result == 0 ? 1 : result;
+    }
+
+    ClauseExchange::ClauseExchange(unsigned workers, std::size_t capacity, std::size_t filterSize)
+        : workers(workers), capacity(std::bit_ceil(std::max(capacity, 2 * HeaderSize))),
+          rings(std::make_unique<Ring[]>(workers)), filters(std::make_unique<Filter[]>(workers)) {
+        for (unsigned w = 0; w < workers; ++w) {
+            rings[w].cursors = std::make_unique<Cursor[]>(workers);
+            rings[w].data = std::make_unique<std::uint32_t[]>(this->capacity);
+            filters[w].hashes.assign(std::bit_ceil(std::max<std::size_t>(filterSize, 1)), 0);
+        }
+    }
+
+    bool ClauseExchange::seen(unsigned worker, std::uint64_t hash) {
+        auto &filter = filters[worker];
+        auto &entry = filter.hashes[hash & (filter.hashes.size() - 1)];
+        if (entry == hash) {
+            ++filter.duplicates;
+            return true;
+        }
+
+        entry = hash;
+        return false;
+    }
+
+    std::uint64_t ClauseExchange::minimumCursor(const Ring &ring, unsigned producer) const {
+        auto result = ring.head.load(std::memory_order_relaxed);
+        for (unsigned c = 0; c < workers; ++c) {
+            if (c != producer) {
+                result = std::min(result, ring.cursors[c].position.load(std::memory_order_acquire));
+            }
+        }
+
+        return result;
+    }
+
+    bool ClauseExchange::publish(unsigned producer, const Clause &clause, unsigned lbd) {
+        assert(producer < workers);
+        assert(not clause.empty());
+        const auto clauseHash = hash(clause);
+        if (seen(producer, clauseHash)) {
+            return false;
+        }
+
+        auto &ring = rings[producer];
+        const auto required = HeaderSize + clause.size();
+        const auto limit = clause.size() == 1 || lbd <= GlueLimit ? capacity : capacity / 2;
+        const auto head = ring.head.load(std::memory_order_relaxed);
+        if (head + required - ring.tail > limit) {
+            ring.tail = minimumCursor(ring, producer);
+            if (head + required - ring.tail > limit) {
+                ++ring.dropped;
+                return false;
+            }
+        }
+
+        const auto mask = capacity - 1;
+        auto *data = ring.data.get();
+        data[head & mask] = static_cast<std::uint32_t>(clause.size());
+        data[(head + 1) & mask] = lbd;
+        data[(head + 2) & mask] = static_cast<std::uint32_t>(clauseHash);
+        data[(head + 3) & mask] = static_cast<std::uint32_t>(clauseHash >> 32);
+        for (std::size_t i = 0; i < clause.size(); ++i) {
+            data[(head + HeaderSize + i) & mask] = clause[i].get();
+        }
+
+        ring.head.store(head + required, std::memory_order_release);
+        ++ring.published;
+        return true;
+    }
+
+    void ClauseExchange::collect(unsigned consumer, std::vector<ClauseSharing::SharedClause> &clauses) {
+        assert(consumer < workers);
+        const auto mask = capacity - 1;
+        for (unsigned producer = 0; producer < workers; ++producer) {
+            if (producer == consumer) {
+                continue;
+            }
+
+            auto &ring = rings[producer];
+            auto &cursor = ring.cursors[consumer].position;
+            auto position = cursor.load(std::memory_order_relaxed);
+            const auto head = ring.head.load(std::memory_order_acquire);
+            const auto *data = ring.data.get();
+            while (position < head) {
+                const auto size = data[position & mask];
+                const auto lbd = data[(position + 1) & mask];
+                const auto clauseHash = data[(position + 2) & mask] |
+                                        static_cast<std::uint64_t>(data[(position + 3) & mask]) << 32;
+                if (not seen(consumer, clauseHash)) {
+                    Clause clause;
+                    clause.reserve(size);
+                    for (std::size_t i = 0; i < size; ++i) {
+                        clause.emplace_back(data[(position + HeaderSize + i) & mask]);
+                    }
+
+                    clauses.emplace_back(std::move(clause), lbd);
+                }
+
+                position += HeaderSize + size;
+            }
+
+            cursor.store(position, std::memory_order_release);
+        }
+    }
+
+    unsigned ClauseExchange::getNumWorkers() const noexcept {
+        return workers;
+    }
+
+    auto ClauseExchange::getStatistics() const -> ClauseExchangeStatistics {
+        ClauseExchangeStatistics result;
+        for (unsigned w = 0; w < workers; ++w) {
+            result.published += rings[w].published;
+            result.dropped += rings[w].dropped;
+            result.duplicates += filters[w].duplicates;
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,122 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @file ClauseExchange.hpp
+* @brief Contains the lock-free buffer used by parallel solvers to exchange learned clauses
+*/
+
+#ifndef CLAUSEEXCHANGE_HPP
+#define CLAUSEEXCHANGE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Clause.hpp"
+#include "ClauseSharing.hpp"
+
+namespace sat {
+
+    /**
+     * @brief Statistics of the clause exchange
+     */
+    struct ClauseExchangeStatistics {
+        std::uint64_t published = 0; ///< clauses written to the buffers
+        std::uint64_t dropped = 0; ///< clauses rejected because the buffer of the producer was (almost) full
+        std::uint64_t duplicates = 0; ///< received clauses that were filtered because their hash was already seen
+    };
+
+    /**
+     * @brief Lock-free clause exchange between a fixed number of workers.
+     * @details @copybrief
+     * Every worker owns a single-producer ring buffer of literals. A published clause is written as a header (size,
+     * LBD, hash) followed by its literals and made visible by a release store of the write position. Every other
+     * worker reads the ring from its own cursor and publishes the cursor after reading, so neither publishing nor
+     * collecting ever waits for a lock. The producer only reuses space that all consumers have read. If there is not
+     * enough space, the producer drops the clause instead of blocking. Once the ring is half full, only clauses with
+     * LBD up to 2 and units are accepted, so the least useful clauses are dropped first.
+     * Each worker filters received clauses by an order independent 64-bit hash. Clauses that were already received
+     * or exported by the same worker are dropped (the filter is a direct mapped table, so old hashes are evicted).
+     * publish() and collect() of one worker must be called from the same thread, different workers may run
+     * concurrently.
+     */
+    class ClauseExchange {
+        static constexpr std::size_t HeaderSize = 4;
+        static constexpr std::size_t CacheLine = 64;
+        static constexpr unsigned GlueLimit = 2;
+
+        struct alignas(CacheLine) Cursor {
+            std::atomic<std::uint64_t> position = 0;
+        };
+
+        struct Ring {
+            alignas(CacheLine) std::atomic<std::uint64_t> head = 0; ///< end of the published data
+            alignas(CacheLine) std::uint64_t tail = 0; ///< cached minimum consumer position (producer only)
+            std::uint64_t published = 0;
+            std::uint64_t dropped = 0;
+            std::unique_ptr<Cursor[]> cursors; ///< read position of each consumer
+            std::unique_ptr<std::uint32_t[]> data;
+        };
+
+        struct alignas(CacheLine) Filter {
+            std::vector<std::uint64_t> hashes;
+            std::uint64_t duplicates = 0;
+        };
+
+        unsigned workers;
+        std::size_t capacity;
+        std::unique_ptr<Ring[]> rings;
+        std::unique_ptr<Filter[]> filters;
+
+        bool seen(unsigned worker, std::uint64_t hash);
+        std::uint64_t minimumCursor(const Ring &ring, unsigned producer) const;
+
+    public:
+        /**
+         * Order independent hash of a clause
+         * @param clause the clause
+         * @return hash value that is the same for all permutations of the clause
+         */
+        static std::uint64_t hash(const Clause &clause) noexcept;
+
+        /**
+         * Ctor
+         * @param workers number of workers (producers and consumers)
+         * @param capacity number of 32-bit words of each ring. Rounded up to the next power of two
+         * @param filterSize number of entries of the duplicate filter of each worker. Rounded up to the next power of
+         * two
+         */
+        explicit ClauseExchange(unsigned workers, std::size_t capacity = 1 << 16, std::size_t filterSize = 1 << 14);
+
+        /**
+         * Publishes a clause to all other workers. Never blocks
+         * @param producer index of the publishing worker
+         * @param clause clause to publish (must not be empty)
+         * @param lbd literal block distance of the clause
+         * @return true if the clause was published, false if it was dropped (buffer full or duplicate)
+         */
+        bool publish(unsigned producer, const Clause &clause, unsigned lbd);
+
+        /**
+         * Reads all clauses published by other workers since the last call. Never blocks
+         * @param consumer index of the reading worker
+         * @param clauses output vector, received clauses are appended
+         */
+        void collect(unsigned consumer, std::vector<ClauseSharing::SharedClause> &clauses);
+
+        /**
+         * Number of workers
+         * @return number of workers
+         */
+        unsigned getNumWorkers() const noexcept;
+
+        /**
+         * Gets the accumulated statistics of all workers. Only exact if no worker is active
+         * @return exchange statistics
+         */
+        auto getStatistics() const -> ClauseExchangeStatistics;
+    };
+}
+
+#endif //CLAUSEEXCHANGE_HPP
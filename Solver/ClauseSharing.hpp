@@ -0,0 +1,52 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @file ClauseSharing.hpp
+* @brief Contains the interface used by solvers to exchange learned clauses with other solvers
+*/
+
+#ifndef CLAUSESHARING_HPP
+#define CLAUSESHARING_HPP
+
+#include <vector>
+
+#include "Clause.hpp"
+
+namespace sat {
+
+    /**
+     * @brief Connection between a solver and a clause exchange shared with other solvers.
+     * @details @copybrief
+     * The solver offers each learned clause together with its LBD via exportClause() and its root level units as
+     * unit clauses. Implementations decide which clauses are worth sharing. Clauses exported by other solvers are
+     * fetched via importClauses() at restarts. Each solver uses its own ClauseSharing object, but implementations
+     * must allow the objects of different solvers to be used concurrently.
+     */
+    class ClauseSharing {
+    public:
+        /**
+         * @brief Clause received from another solver
+         */
+        struct SharedClause {
+            Clause literals;
+            unsigned lbd;
+        };
+
+        virtual ~ClauseSharing() = default;
+
+        /**
+         * Offers a clause to the other solvers
+         * @param clause learned clause
+         * @param lbd literal block distance of the clause (1 for units)
+         */
+        virtual void exportClause(const Clause &clause, unsigned lbd) = 0;
+
+        /**
+         * Fetches the clauses exported by other solvers since the last call
+         * @param clauses output vector, imported clauses are appended
+         */
+        virtual void importClauses(std::vector<SharedClause> &clauses) = 0;
+    };
+}
+
+#endif //CLAUSESHARING_HPP
@@ -0,0 +1,226 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+#include "CubeAndConquer.hpp"
+
+namespace sat {
+    namespace {
+        /**
+         * @brief Cube queue of a single worker. The owner works at the back, thieves take untried cubes from the front
+         */
+        struct WorkQueue {
+            std::mutex mutex;
+            std::deque<Cube> cubes;
+        };
+    }
+
+    CubeAndConquer::CubeAndConquer(std::vector<Clause> clauses, unsigned numVariables, const CubeConfig &config)
+        : clauses(std::move(clauses)), numVariables(numVariables), config(config),
+          model(numVariables, TruthValue::Undefined) {
+        this->config.threads = std::max(this->config.threads, 1u);
+    }
+
+    void CubeAndConquer::refute(std::vector<Cube> cubes) {
+        std::lock_guard lock(refutedMutex);
+        for (auto &cube: cubes) {
+            refuted.emplace_back(std::move(cube));
+        }
+    }
+
+    SolverResult CubeAndConquer::solve() {
+        refuted.clear();
+        statistics = {};
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<Cube> initial;
+        {
+            Solver splitter(numVariables, config.solverConfig);
+            for (const auto &clause: clauses) {
+                splitter.addClause(clause);
+            }
+
+            std::vector<Cube> refutedByLookahead;
+            initial = splitter.cube({}, config.depth, &refutedByLookahead);
+            refute(std::move(refutedByLookahead));
+        }
+
+        statistics.cubingTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        statistics.cubes = initial.size();
+        if (initial.empty()) {
+            statistics.refutedCubes = refuted.size();
+            return SolverResult::Unsat;
+        }
+
+        const auto threads = config.threads;
+        auto queues = std::make_unique<WorkQueue[]>(threads);
+        for (std::size_t i = 0; i < initial.size(); ++i) {
+            queues[i % threads].cubes.emplace_back(std::move(initial[i]));
+        }
+
+        std::atomic_size_t pending = initial.size();
+        std::atomic_uint idle = 0;
+        std::atomic_bool stop = false;
+        std::atomic_uint64_t cubes = initial.size(), steals = 0, splits = 0;
+        auto result = SolverResult::Unknown;
+        const auto take = [&](unsigned worker) -> std::optional<Cube> {
+            {
+                std::lock_guard lock(queues[worker].mutex);
+                if (auto &own = queues[worker].cubes; !own.empty()) {
+                    auto cube = std::move(own.back());
+                    own.pop_back();
+                    return cube;
+                }
+            }
+
+            for (unsigned i = 1; i < threads; ++i) {
+                auto &victim = queues[(worker + i) % threads];
+                std::lock_guard lock(victim.mutex);
+                if (!victim.cubes.empty()) {
+                    auto cube = std::move(victim.cubes.front());
+                    victim.cubes.pop_front();
+                    ++steals;
+                    return cube;
+                }
+            }
+
+            return std::nullopt;
+        };
+
+        // called after a cube was refuted or replaced by its parts, the last cube finishes the search
+        const auto resolve = [&] {
+            if (--pending == 0 && !stop.exchange(true)) {
+                result = SolverResult::Unsat;
+            }
+        };
+
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(threads);
+            for (unsigned worker = 0; worker < threads; ++worker) {
+                workers.emplace_back([&, worker] {
+                    Solver solver(numVariables, config.solverConfig);
+                    solver.setTerminationFlag(&stop);
+                    solver.reconstructionStack().append(reconstruction);
+                    for (const auto &clause: clauses) {
+                        solver.addClause(clause);
+                    }
+
+                    bool waiting = false;
+                    while (!stop) {
+                        auto next = take(worker);
+                        if (!next.has_value()) {
+                            if (!waiting) {
+                                ++idle;
+                                waiting = true;
+                            }
+
+                            std::this_thread::yield();
+                            continue;
+                        }
+
+                        if (waiting) {
+                            --idle;
+                            waiting = false;
+                        }
+
+                        auto cube = std::move(*next);
+                        auto budget = config.conflictBudget;
+                        while (!stop) {
+                            const auto res = solver.solve(cube, budget);
+                            if (res == SolverResult::Sat) {
+                                if (!stop.exchange(true)) {
+                                    result = SolverResult::Sat;
+                                    model = solver.getModel();
+                                }
+
+                                break;
+                            }
+
+                            if (res == SolverResult::Unsat) {
+                                refute({std::move(cube)});
+                                resolve();
+                                break;
+                            }
+
+                            if (stop || idle == 0) {
+                                budget *= 2;
+                                continue;
+                            }
+
+                            // other workers are idle: split the long-running cube and share the parts
+                            std::vector<Cube> refutedParts;
+                            auto parts = solver.cube(cube, config.splitDepth, &refutedParts);
+                            refute(std::move(refutedParts));
+                            if (parts.size() == 1) {
+                                cube = std::move(parts.front());
+                                budget *= 2;
+                                continue;
+                            }
+
+                            ++splits;
+                            cubes += parts.size();
+                            // the parts must be pending before a thief can refute them, otherwise the count may
+                            // drop to zero while parts are still open
+                            pending += parts.size();
+                            {
+                                std::lock_guard lock(queues[worker].mutex);
+                                for (auto &part: parts) {
+                                    queues[worker].cubes.emplace_back(std::move(part));
+                                }
+                            }
+
+                            resolve();
+                            break;
+                        }
+                    }
+                });
+            }
+        }
+
+        statistics.cubes = cubes;
+        statistics.steals = steals;
+        statistics.splits = splits;
+        statistics.refutedCubes = refuted.size();
+        return result;
+    }
+
+    TruthValue CubeAndConquer::val(Variable x) const {
+        if (x.get() >= numVariables) {
+            throw std::out_of_range("Variable index out of range");
+        }
+
+        return model[x.get()];
+    }
+
+    bool CubeAndConquer::satisfied(Literal l) const {
+        const auto value = val(var(l));
+        return (l.sign() == 1 && value == TruthValue::True) || (l.sign() == -1 && value == TruthValue::False);
+    }
+
+    auto CubeAndConquer::getModel() const -> const std::vector<TruthValue> & {
+        return model;
+    }
+
+    auto CubeAndConquer::reconstructionStack() -> ReconstructionStack & {
+        return reconstruction;
+    }
+
+    auto CubeAndConquer::getRefutedCubes() const noexcept -> const std::vector<Cube> & {
+        return refuted;
+    }
+
+    auto CubeAndConquer::getStatistics() const noexcept -> const CubeStatistics & {
+        return statistics;
+    }
+}
@@ -0,0 +1,123 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @file CubeAndConquer.hpp
+* @brief Contains the cube-and-conquer solver that splits the formula into cubes and solves them in parallel
+*/
+
+#ifndef CUBEANDCONQUER_HPP
+#define CUBEANDCONQUER_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "basic_structures.hpp"
+#include "Clause.hpp"
+#include "ReconstructionStack.hpp"
+#include "Solver.hpp"
+
+namespace sat {
+
+    /**
+     * @brief Parameters of cube-and-conquer
+     */
+    struct CubeConfig {
+        unsigned threads = 4; ///< number of worker threads
+        unsigned depth = 8; ///< maximum number of lookahead decisions of the initial cubes
+        std::uint64_t conflictBudget = 2000; ///< conflicts spent on a cube before it may be split further
+        unsigned splitDepth = 1; ///< lookahead decisions added when a long-running cube is split
+        SolverConfig solverConfig{.elimination = false}; ///< configuration of the worker solvers
+    };
+
+    /**
+     * @brief Statistics of cube-and-conquer
+     */
+    struct CubeStatistics {
+        std::uint64_t cubes = 0; ///< cubes created by the initial split and by later splits
+        std::uint64_t refutedCubes = 0; ///< cubes refuted by lookahead or by a worker
+        std::uint64_t steals = 0; ///< cubes taken from the queue of another worker
+        std::uint64_t splits = 0; ///< long-running cubes split into smaller cubes
+        double cubingTime = 0; ///< seconds spent on the initial split
+    };
+
+    /**
+     * @brief Cube-and-conquer solver.
+     * @details @copybrief
+     * The formula is split into cubes by lookahead (Solver::cube()). The cubes are distributed over the queues of
+     * the worker threads, each of which solves its cubes as assumptions of its own incremental Solver. An idle worker
+     * steals an untried cube from the front of another worker's queue. When a worker exceeds the conflict budget on
+     * a cube while other workers are idle, it splits the cube by lookahead and queues the parts. The formula is
+     * satisfiable as soon as one cube is satisfiable. It is unsatisfiable once every cube is refuted; refuted cubes
+     * are recorded (see getRefutedCubes()).
+     */
+    class CubeAndConquer {
+        std::vector<Clause> clauses;
+        unsigned numVariables;
+        CubeConfig config;
+        ReconstructionStack reconstruction;
+        std::vector<TruthValue> model;
+        std::mutex refutedMutex;
+        std::vector<Cube> refuted;
+        CubeStatistics statistics;
+
+        void refute(std::vector<Cube> cubes);
+
+    public:
+        /**
+         * Ctor
+         * @param clauses clauses of the formula
+         * @param numVariables number of variables in the formula
+         * @param config cube-and-conquer parameters
+         */
+        CubeAndConquer(std::vector<Clause> clauses, unsigned numVariables, const CubeConfig &config = {});
+
+        /**
+         * Splits the formula and solves all cubes until one is satisfiable or all are refuted
+         * @return SolverResult::Sat if a model was found (accessible via val()), SolverResult::Unsat if the problem is
+         * unsatisfiable
+         */
+        SolverResult solve();
+
+        /**
+         * Gets the value of a variable in the model
+         * @param x variable
+         * @return the value of the variable
+         */
+        TruthValue val(Variable x) const;
+
+        /**
+         * Checks whether the literal is satisfied in the model
+         * @param l literal to check
+         * @return true if the literal is satisfied, false otherwise
+         */
+        bool satisfied(Literal l) const;
+
+        /**
+         * Gets the model
+         * @return vector of truth values for each variable
+         */
+        auto getModel() const -> const std::vector<TruthValue> &;
+
+        /**
+         * Gets the reconstruction stack that is used to extend the model (e.g. to undo preprocessing)
+         * @return reconstruction stack
+         */
+        auto reconstructionStack() -> ReconstructionStack &;
+
+        /**
+         * Gets all cubes refuted during the last solve() call (in the order of their refutation). If the formula is
+         * unsatisfiable, the disjunction of the refuted cubes is a tautology
+         * @return refuted cubes
+         */
+        auto getRefutedCubes() const noexcept -> const std::vector<Cube> &;
+
+        /**
+         * Gets the statistics
+         * @return cube-and-conquer statistics
+         */
+        auto getStatistics() const noexcept -> const CubeStatistics &;
+    };
+}
+
+#endif //CUBEANDCONQUER_HPP
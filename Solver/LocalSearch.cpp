@@ -0,0 +1,292 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+#include "LocalSearch.hpp"
+
+namespace sat {
+    double LocalSearchStatistics::flipsPerSecond() const noexcept {
+        return time > 0 ? static_cast<double>(flips) / time : 0;
+    }
+
+    LocalSearch::LocalSearch(const std::vector<Clause> &clauses, std::size_t numVariables,
+                             const LocalSearchConfig &config)
+        : numVariables(numVariables), config(config), occurrenceBegin(2 * numVariables + 1, 0),
+          evaluator({}, numVariables), breaks(numVariables, 0), assignment(numVariables, TruthValue::False),
+          rng(config.seed) {
+        clauseBegin.emplace_back(0);
+        std::vector<Clause> kept;
+        Clause normalized;
+        for (const auto &clause: clauses) {
+            normalized = clause;
+            std::ranges::sort(normalized, {}, [](Literal l) { return l.get(); });
+            const auto [first, last] = std::ranges::unique(normalized);
+            normalized.erase(first, last);
+            bool tautology = false;
+            for (std::size_t i = 1; i < normalized.size(); ++i) {
+                tautology |= normalized[i] == normalized[i - 1].negate();
+            }
+
+            if (tautology) {
+                continue;
+            }
+
+            if (normalized.empty()) {
+                emptyClause = true;
+                continue;
+            }
+
+            for (Literal l: normalized) {
+                ++occurrenceBegin[l.get() + 1];
+            }
+
+            literals.insert(literals.end(), normalized.begin(), normalized.end());
+            clauseBegin.emplace_back(static_cast<std::uint32_t>(literals.size()));
+            kept.emplace_back(normalized);
+        }
+
+        evaluator = ClauseEvaluator(kept, numVariables);
+
+        std::uint32_t maxOccurrences = 0;
+        for (std::size_t l = 1; l < occurrenceBegin.size(); ++l) {
+            maxOccurrences = std::max(maxOccurrences, occurrenceBegin[l]);
+            occurrenceBegin[l] += occurrenceBegin[l - 1];
+        }
+
+        const auto numClauses = static_cast<std::uint32_t>(clauseBegin.size() - 1);
+        occurrences.resize(literals.size());
+        auto fill = occurrenceBegin;
+        for (std::uint32_t c = 0; c < numClauses; ++c) {
+            for (auto i = clauseBegin[c]; i < clauseBegin[c + 1]; ++i) {
+                occurrences[fill[literals[i].get()]++] = c;
+            }
+        }
+
+        // a variable never breaks more clauses than its literal occurs in
+        breakProbabilities.resize(maxOccurrences + 1);
+        for (std::uint32_t b = 0; b <= maxOccurrences; ++b) {
+            breakProbabilities[b] = std::pow(config.breakEpsilon + b, -config.breakExponent);
+        }
+
+        numTrue.resize(numClauses);
+        trueVariables.resize(numClauses);
+        unsatisfiedPosition.resize(numClauses);
+        std::bernoulli_distribution coin;
+        for (auto &value: assignment) {
+            value = coin(rng) ? TruthValue::True : TruthValue::False;
+        }
+
+        initialize();
+    }
+
+    void LocalSearch::makeUnsatisfied(std::uint32_t clause) {
+        unsatisfiedPosition[clause] = static_cast<std::uint32_t>(unsatisfied.size());
+        unsatisfied.emplace_back(clause);
+    }
+
+    void LocalSearch::makeSatisfied(std::uint32_t clause) {
+        // the last unsatisfied clause takes the place of the removed one
+        const auto position = unsatisfiedPosition[clause];
+        const auto last = unsatisfied.back();
+        unsatisfied[position] = last;
+        unsatisfiedPosition[last] = position;
+        unsatisfied.pop_back();
+    }
+
+    void LocalSearch::initialize() {
+        std::ranges::fill(breaks, 0);
+        unsatisfied.clear();
+        evaluator.countTrueLiterals(assignment, numTrue, trueVariables);
+        for (std::uint32_t c = 0; c < numTrue.size(); ++c) {
+            if (numTrue[c] == 0) {
+                makeUnsatisfied(c);
+            } else if (numTrue[c] == 1) {
+                ++breaks[trueVariables[c]];
+            }
+        }
+
+        statistics.bestUnsatisfied = std::min(statistics.bestUnsatisfied, unsatisfied.size());
+        walkBest = unsatisfied.size();
+        flipsSinceBest.clear();
+        bestOnTrail = true;
+    }
+
+    void LocalSearch::flip(unsigned x) {
+        assignment[x] = assignment[x] == TruthValue::True ? TruthValue::False : TruthValue::True;
+        const Literal made = assignment[x] == TruthValue::True ? pos(x) : neg(x);
+        for (auto i = occurrenceBegin[made.get()]; i < occurrenceBegin[made.get() + 1]; ++i) {
+            const auto c = occurrences[i];
+            const auto count = ++numTrue[c];
+            if (count == 1) {
+                makeSatisfied(c);
+                ++breaks[x];
+            } else if (count == 2) {
+                --breaks[trueVariables[c]]; // the previously critical variable
+            }
+
+            trueVariables[c] ^= x;
+        }
+
+        const Literal broken = made.negate();
+        for (auto i = occurrenceBegin[broken.get()]; i < occurrenceBegin[broken.get() + 1]; ++i) {
+            const auto c = occurrences[i];
+            const auto count = --numTrue[c];
+            trueVariables[c] ^= x;
+            if (count == 0) {
+                makeUnsatisfied(c);
+                --breaks[x];
+            } else if (count == 1) {
+                ++breaks[trueVariables[c]];
+            }
+        }
+
+        ++statistics.flips;
+    }
+
+    unsigned LocalSearch::pickProbSat(std::uint32_t clause) {
+        scores.clear();
+        double sum = 0;
+        for (auto i = clauseBegin[clause]; i < clauseBegin[clause + 1]; ++i) {
+            sum += scores.emplace_back(breakProbabilities[breaks[var(literals[i]).get()]]);
+        }
+
+        double threshold = std::uniform_real_distribution<double>(0, sum)(rng);
+        for (std::size_t k = 0; k + 1 < scores.size(); ++k) {
+            threshold -= scores[k];
+            if (threshold <= 0) {
+                return var(literals[clauseBegin[clause] + k]).get();
+            }
+        }
+
+        return var(literals[clauseBegin[clause + 1] - 1]).get();
+    }
+
+    unsigned LocalSearch::pickWalkSat(std::uint32_t clause) {
+        const auto begin = clauseBegin[clause];
+        const auto size = clauseBegin[clause + 1] - begin;
+        unsigned best = 0;
+        auto minBreak = std::numeric_limits<std::uint32_t>::max();
+        unsigned ties = 0;
+        for (auto i = begin; i < begin + size; ++i) {
+            const auto x = var(literals[i]).get();
+            if (breaks[x] < minBreak) {
+                minBreak = breaks[x];
+                best = x;
+                ties = 1;
+            } else if (breaks[x] == minBreak && std::uniform_int_distribution<unsigned>(0, ties++)(rng) == 0) {
+                best = x; // uniform choice among the variables with minimal break count
+            }
+        }
+
+        if (minBreak > 0 && std::bernoulli_distribution(config.noise)(rng)) {
+            return var(literals[begin + std::uniform_int_distribution<std::uint32_t>(0, size - 1)(rng)]).get();
+        }
+
+        return best;
+    }
+
+    SolverResult LocalSearch::solve(std::uint64_t maxFlips) {
+        if (emptyClause) {
+            return SolverResult::Unknown;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t flips = 0; not unsatisfied.empty() && flips < maxFlips; ++flips) {
+            if (flips % 1024 == 0 && terminationFlag != nullptr && terminationFlag->load(std::memory_order_relaxed)) {
+                break;
+            }
+
+            const auto clause = unsatisfied[std::uniform_int_distribution<std::size_t>(0, unsatisfied.size() - 1)(rng)];
+            const auto x = config.algorithm == LocalSearchAlgorithm::ProbSat ? pickProbSat(clause) : pickWalkSat(clause);
+            flip(x);
+            if (unsatisfied.size() < walkBest) {
+                walkBest = unsatisfied.size();
+                flipsSinceBest.clear();
+                bestOnTrail = true;
+            } else if (bestOnTrail) {
+                flipsSinceBest.emplace_back(x);
+                if (flipsSinceBest.size() > numVariables) {
+                    getBestAssignment();
+                    flipsSinceBest.clear();
+                    bestOnTrail = false;
+                }
+            }
+        }
+
+        statistics.bestUnsatisfied = std::min(statistics.bestUnsatisfied, walkBest);
+
+        statistics.time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (not unsatisfied.empty()) {
+            return SolverResult::Unknown;
+        }
+
+        model = assignment;
+        reconstruction.extend(model);
+        return SolverResult::Sat;
+    }
+
+    void LocalSearch::setAssignment(const std::vector<TruthValue> &values) {
+        for (std::size_t x = 0; x < std::min(values.size(), numVariables); ++x) {
+            if (values[x] != TruthValue::Undefined) {
+                assignment[x] = values[x];
+            }
+        }
+
+        initialize();
+    }
+
+    std::size_t LocalSearch::getBestUnsatisfied() const noexcept {
+        return walkBest;
+    }
+
+    auto LocalSearch::getBestAssignment() -> const std::vector<TruthValue> & {
+        if (bestOnTrail) {
+            best = assignment;
+            for (auto x: flipsSinceBest) {
+                best[x] = best[x] == TruthValue::True ? TruthValue::False : TruthValue::True;
+            }
+        }
+
+        return best;
+    }
+
+    void LocalSearch::setTerminationFlag(const std::atomic_bool *flag) noexcept {
+        terminationFlag = flag;
+    }
+
+    std::size_t LocalSearch::numUnsatisfied() const noexcept {
+        return unsatisfied.size();
+    }
+
+    TruthValue LocalSearch::val(Variable x) const {
+        if (x.get() >= model.size()) {
+            throw std::out_of_range("Variable index out of range");
+        }
+
+        return model[x.get()];
+    }
+
+    bool LocalSearch::satisfied(Literal l) const {
+        const auto value = val(var(l));
+        return (l.sign() == 1 && value == TruthValue::True) || (l.sign() == -1 && value == TruthValue::False);
+    }
+
+    auto LocalSearch::getModel() const -> const std::vector<TruthValue> & {
+        return model;
+    }
+
+    auto LocalSearch::reconstructionStack() -> ReconstructionStack & {
+        return reconstruction;
+    }
+
+    auto LocalSearch::getStatistics() const noexcept -> const LocalSearchStatistics & {
+        return statistics;
+    }
+}
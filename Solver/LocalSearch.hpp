@@ -0,0 +1,187 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @file LocalSearch.hpp
+* @brief Contains the stochastic local search engine (ProbSAT / WalkSAT)
+*/
+
+#ifndef LOCALSEARCH_HPP
+#define LOCALSEARCH_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "basic_structures.hpp"
+#include "Clause.hpp"
+#include "ClauseEvaluator.hpp"
+#include "ReconstructionStack.hpp"
+#include "Solver.hpp"
+#include "util/enum.hpp"
+
+namespace sat {
+    PENUM(LocalSearchAlgorithm, ProbSat, WalkSat)
+
+    /**
+     * @brief Parameters of the local search
+     */
+    struct LocalSearchConfig {
+        LocalSearchAlgorithm algorithm = LocalSearchAlgorithm::ProbSat; ///< variable selection in unsatisfied clauses
+        double breakExponent = 2.38; ///< ProbSAT: a variable is flipped with probability ~ (epsilon + break)^-exponent
+        double breakEpsilon = 1; ///< ProbSAT: offset of the polynomial break function
+        double noise = 0.567; ///< WalkSAT: probability of a random walk step if every variable breaks clauses
+        unsigned seed = 0; ///< random seed of the initial assignment and of all flip decisions
+    };
+
+    /**
+     * @brief Statistics of the local search
+     */
+    struct LocalSearchStatistics {
+        std::uint64_t flips = 0;
+        double time = 0; ///< seconds spent flipping
+        std::size_t bestUnsatisfied = std::numeric_limits<std::size_t>::max(); ///< fewest unsatisfied clauses seen
+
+        /**
+         * Flip rate of the search
+         * @return flips per second (0 if no time was measured)
+         */
+        double flipsPerSecond() const noexcept;
+    };
+
+    /**
+     * @brief Stochastic local search for satisfiable formulas.
+     * @details @copybrief
+     * Starting from a random complete assignment, the search repeatedly picks a random unsatisfied clause and flips
+     * one of its variables. ProbSAT picks the variable with probability proportional to (epsilon + break)^-exponent,
+     * WalkSAT (SKC variant) flips a variable that breaks no clause if there is one and otherwise a random variable
+     * (with probability noise) or one with minimal break count. The break count of a variable is the number of
+     * clauses in which it is the only true literal.
+     * All data needed per flip is maintained incrementally: each clause stores the number of its true literals and
+     * the XOR of their variables (which is the critical variable if only one literal is true), break counts are
+     * updated when a clause gets or loses its second true literal and the unsatisfied clauses are kept in a list
+     * with position index for O(1) insertion and removal. Clauses and literal occurrences are stored in flat arrays.
+     * A flip therefore only touches the occurrences of the flipped variable. The true literal counts of a new walk are
+     * computed by the vectorized ClauseEvaluator.
+     * The best assignment of a walk is kept as the current assignment minus the flips made since it was reached (up to
+     * numVariables flips, then it is copied), such that improvements do not copy the whole assignment.
+     * The search cannot prove unsatisfiability.
+     */
+    class LocalSearch {
+        std::size_t numVariables;
+        LocalSearchConfig config;
+        std::vector<std::uint32_t> clauseBegin; ///< literals of clause c are literals[clauseBegin[c], clauseBegin[c + 1])
+        std::vector<Literal> literals;
+        std::vector<std::uint32_t> occurrenceBegin; ///< clauses containing l are occurrences[occurrenceBegin[l], ...)
+        std::vector<std::uint32_t> occurrences;
+        ClauseEvaluator evaluator;
+        std::vector<std::uint32_t> numTrue;
+        std::vector<std::uint32_t> trueVariables; ///< XOR of the variables of all true literals
+        std::vector<std::uint32_t> breaks;
+        std::vector<std::uint32_t> unsatisfied;
+        std::vector<std::uint32_t> unsatisfiedPosition;
+        std::vector<TruthValue> assignment;
+        std::vector<TruthValue> best;
+        std::vector<unsigned> flipsSinceBest;
+        bool bestOnTrail = true; ///< whether best is the assignment with flipsSinceBest undone
+        std::size_t walkBest = 0;
+        std::vector<double> breakProbabilities;
+        std::vector<double> scores;
+        bool emptyClause = false;
+        std::default_random_engine rng;
+        std::vector<TruthValue> model;
+        ReconstructionStack reconstruction;
+        LocalSearchStatistics statistics;
+        const std::atomic_bool *terminationFlag = nullptr;
+
+        void makeUnsatisfied(std::uint32_t clause);
+        void makeSatisfied(std::uint32_t clause);
+        void flip(unsigned x);
+        void initialize();
+        unsigned pickProbSat(std::uint32_t clause);
+        unsigned pickWalkSat(std::uint32_t clause);
+
+    public:
+        /**
+         * Ctor. Draws a random initial assignment
+         * @param clauses clauses of the formula
+         * @param numVariables number of variables in the formula
+         * @param config search parameters
+         */
+        LocalSearch(const std::vector<Clause> &clauses, std::size_t numVariables, const LocalSearchConfig &config = {});
+
+        /**
+         * Flips variables until all clauses are satisfied. The search continues from the current assignment when
+         * called again
+         * @param maxFlips flip budget
+         * @return SolverResult::Sat if a model was found (accessible via val()), SolverResult::Unknown if the budget is
+         * exhausted or the search was terminated
+         */
+        SolverResult solve(std::uint64_t maxFlips = std::numeric_limits<std::uint64_t>::max());
+
+        /**
+         * Replaces the current assignment, e.g. by the saved phases of a CDCL solver, and starts a new walk
+         * @param values new value of each variable. Variables with undefined value keep their current value
+         */
+        void setAssignment(const std::vector<TruthValue> &values);
+
+        /**
+         * Number of unsatisfied clauses under the best assignment of the current walk
+         * @return fewest unsatisfied clauses since construction or the last call to setAssignment()
+         */
+        std::size_t getBestUnsatisfied() const noexcept;
+
+        /**
+         * Gets the best assignment of the current walk
+         * @return assignment with getBestUnsatisfied() unsatisfied clauses
+         */
+        auto getBestAssignment() -> const std::vector<TruthValue> &;
+
+        /**
+         * Sets a flag that is polled during the search. Once the flag is set, solve() returns SolverResult::Unknown
+         * @param flag termination flag (nullptr to disable). Must outlive the search or be reset
+         */
+        void setTerminationFlag(const std::atomic_bool *flag) noexcept;
+
+        /**
+         * Number of currently unsatisfied clauses
+         * @return number of clauses without a true literal under the current assignment
+         */
+        std::size_t numUnsatisfied() const noexcept;
+
+        /**
+         * Gets the value of a variable in the model found by the search
+         * @param x variable
+         * @return the value of the variable
+         */
+        TruthValue val(Variable x) const;
+
+        /**
+         * Checks whether the literal is satisfied in the model
+         * @param l literal to check
+         * @return true if the literal is satisfied, false otherwise
+         */
+        bool satisfied(Literal l) const;
+
+        /**
+         * Gets the model found by the search
+         * @return vector of truth values for each variable (empty if no model was found)
+         */
+        auto getModel() const -> const std::vector<TruthValue> &;
+
+        /**
+         * Gets the reconstruction stack that is used to extend the model (e.g. to undo preprocessing)
+         * @return reconstruction stack of the search
+         */
+        auto reconstructionStack() -> ReconstructionStack &;
+
+        /**
+         * Gets the search statistics
+         * @return statistics
+         */
+        auto getStatistics() const noexcept -> const LocalSearchStatistics &;
+    };
+}
+
+#endif //LOCALSEARCH_HPP
@@ -0,0 +1,577 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+#include "LookaheadSolver.hpp"
+#include "util/enum.hpp"
+
+namespace sat {
+    namespace {
+        constexpr double BinaryWeight = 5; ///< weight of a binary clause in the recursive weight heuristic
+        constexpr double BaseWeight = 0.1; ///< keeps the weight of literals without occurrences positive
+    }
+
+    LookaheadSolver::LookaheadSolver(const std::vector<Clause> &clauses, std::size_t numVariables,
+                                     const LookaheadConfig &config)
+        : numVariables(numVariables), config(config), implications(2 * numVariables), occurrences(2 * numVariables),
+          values(numVariables, TruthValue::Undefined), fromClause(numVariables, 0), stamps(2 * numVariables, 0) {
+        clauseBegin.emplace_back(0);
+        Clause normalized;
+        std::size_t maxSize = 2;
+        for (const auto &clause: clauses) {
+            normalized = clause;
+            std::ranges::sort(normalized, {}, [](Literal l) { return l.get(); });
+            const auto [first, last] = std::ranges::unique(normalized);
+            normalized.erase(first, last);
+            bool tautology = false;
+            for (std::size_t i = 1; i < normalized.size(); ++i) {
+                tautology |= normalized[i] == normalized[i - 1].negate();
+            }
+
+            if (tautology) {
+                continue;
+            }
+
+            if (normalized.empty()) {
+                emptyClause = true;
+            } else if (normalized.size() == 1) {
+                units.emplace_back(normalized.front());
+            } else if (normalized.size() == 2) {
+                implications[normalized[0].negate().get()].emplace_back(normalized[1]);
+                implications[normalized[1].negate().get()].emplace_back(normalized[0]);
+            } else {
+                const auto index = static_cast<std::uint32_t>(clauseBegin.size() - 1);
+                for (Literal l: normalized) {
+                    occurrences[l.get()].emplace_back(index);
+                }
+
+                literals.insert(literals.end(), normalized.begin(), normalized.end());
+                clauseBegin.emplace_back(static_cast<std::uint32_t>(literals.size()));
+                trueCounts.emplace_back(0);
+                freeCounts.emplace_back(static_cast<std::uint32_t>(normalized.size()));
+                maxSize = std::max(maxSize, normalized.size());
+            }
+        }
+
+        for (const auto &list: implications) {
+            binaryCounts.emplace_back(static_cast<std::uint32_t>(list.size()));
+        }
+
+        clauseStamps.resize(trueCounts.size(), 0);
+        reductionWeights.resize(maxSize + 1, 0);
+        for (std::size_t size = 2; size <= maxSize; ++size) {
+            reductionWeights[size] = std::pow(config.reductionWeight, static_cast<double>(size - 2));
+        }
+    }
+
+    bool LookaheadSolver::terminated() const {
+        return terminationFlag != nullptr && terminationFlag->load(std::memory_order_relaxed);
+    }
+
+    TruthValue LookaheadSolver::value(Literal l) const noexcept {
+        const auto v = to_underlying(values[var(l).get()]);
+        return static_cast<TruthValue>(l.sign() > 0 ? v : -v);
+    }
+
+    void LookaheadSolver::assign(Literal l, bool implied) {
+        values[var(l).get()] = l.sign() > 0 ? TruthValue::True : TruthValue::False;
+        fromClause[var(l).get()] = implied;
+        trail.emplace_back(l);
+    }
+
+    bool LookaheadSolver::propagate() {
+        bool consistent = true;
+        while (consistent && propagationHead < trail.size()) {
+            const Literal l = trail[propagationHead];
+            // binary implications first, they are cheaper and find most conflicts
+            for (Literal k: implications[l.get()]) {
+                const auto v = value(k);
+                if (v == TruthValue::False) {
+                    return false;
+                }
+
+                if (v == TruthValue::Undefined) {
+                    assign(k, false);
+                }
+            }
+
+            ++propagationHead;
+            for (auto c: occurrences[l.get()]) {
+                ++trueCounts[c];
+            }
+
+            // the counters are updated for all clauses even after a conflict such that backtrack() can undo them
+            for (auto c: occurrences[l.negate().get()]) {
+                if (--freeCounts[c] == 0 || trueCounts[c] > 0) {
+                    consistent &= trueCounts[c] > 0;
+                    continue;
+                }
+
+                reduced.emplace_back(c);
+                if (freeCounts[c] == 1 && consistent) {
+                    // the last literal may already be assigned but not yet propagated
+                    const auto begin = literals.begin() + clauseBegin[c];
+                    const auto end = literals.begin() + clauseBegin[c + 1];
+                    if (auto it = std::find_if(begin, end, [this](Literal k) {
+                        return value(k) == TruthValue::Undefined;
+                    }); it != end) {
+                        assign(*it, true);
+                    }
+                }
+            }
+        }
+
+        return consistent;
+    }
+
+    void LookaheadSolver::newLevel() {
+        levels.emplace_back(trail.size());
+    }
+
+    void LookaheadSolver::backtrack(std::size_t level) {
+        const auto limit = levels[level];
+        for (auto i = propagationHead; i > limit; --i) {
+            const Literal l = trail[i - 1];
+            for (auto c: occurrences[l.get()]) {
+                --trueCounts[c];
+            }
+
+            for (auto c: occurrences[l.negate().get()]) {
+                ++freeCounts[c];
+            }
+        }
+
+        for (auto i = trail.size(); i > limit; --i) {
+            values[var(trail[i - 1]).get()] = TruthValue::Undefined;
+        }
+
+        trail.erase(trail.begin() + static_cast<std::ptrdiff_t>(limit), trail.end());
+        propagationHead = std::min(propagationHead, limit);
+        levels.resize(level);
+    }
+
+    void LookaheadSolver::learn(Literal a, Literal b) {
+        implications[a.get()].emplace_back(b);
+        implications[b.negate().get()].emplace_back(a.negate());
+        learned.emplace_back(a, b);
+        ++statistics.learnedImplications;
+    }
+
+    void LookaheadSolver::unlearn(std::size_t size) {
+        while (learned.size() > size) {
+            const auto [a, b] = learned.back();
+            implications[b.negate().get()].pop_back();
+            implications[a.get()].pop_back();
+            learned.pop_back();
+        }
+    }
+
+    double LookaheadSolver::difference() {
+        ++stamp;
+        double difference = 0;
+        for (auto c: reduced) {
+            if (clauseStamps[c] != stamp) {
+                clauseStamps[c] = stamp;
+                if (trueCounts[c] == 0) {
+                    difference += reductionWeights[freeCounts[c]];
+                }
+            }
+        }
+
+        return difference;
+    }
+
+    auto LookaheadSolver::preselect() -> std::vector<unsigned> {
+        // h(x) estimates the reduction caused by the lookahead on ¬x: the sum over the clauses containing x, weighted
+        // by the weights of the negations of their other free literals
+        std::vector<double> weights(2 * numVariables, 1);
+        std::vector<double> next(2 * numVariables);
+        std::vector<char> active(numVariables, 0);
+        Clause free;
+        for (unsigned iteration = 0; iteration < std::max(config.weightIterations, 1u); ++iteration) {
+            double mean = 0;
+            std::size_t numFree = 0;
+            for (unsigned l = 0; l < 2 * numVariables; ++l) {
+                if (value(l) == TruthValue::Undefined) {
+                    mean += weights[l];
+                    ++numFree;
+                }
+            }
+
+            mean = numFree > 0 && mean > 0 ? mean / static_cast<double>(numFree) : 1;
+            std::ranges::fill(next, BaseWeight);
+            for (unsigned l = 0; l < 2 * numVariables; ++l) {
+                if (value(l) != TruthValue::Undefined) {
+                    continue;
+                }
+
+                // binary clause ¬l v k, learned implications would bias the ranking towards earlier lookaheads
+                for (std::size_t i = 0; i < binaryCounts[l]; ++i) {
+                    const Literal k = implications[l][i];
+                    if (value(k) == TruthValue::Undefined) {
+                        next[l ^ 1] += BinaryWeight * weights[k.negate().get()] / mean;
+                        active[l / 2] = 1;
+                    }
+                }
+            }
+
+            for (std::size_t c = 0; c < trueCounts.size(); ++c) {
+                if (trueCounts[c] > 0) {
+                    continue;
+                }
+
+                free.clear();
+                std::copy_if(literals.begin() + clauseBegin[c], literals.begin() + clauseBegin[c + 1],
+                             std::back_inserter(free), [this](Literal l) { return value(l) == TruthValue::Undefined; });
+                const auto weight = reductionWeights[free.size()] * config.reductionWeight;
+                for (Literal x: free) {
+                    double product = weight;
+                    for (Literal y: free) {
+                        if (y != x) {
+                            product *= weights[y.negate().get()] / mean;
+                        }
+                    }
+
+                    next[x.get()] += product;
+                    active[var(x).get()] = 1;
+                }
+            }
+
+            std::swap(weights, next);
+        }
+
+        std::vector<unsigned> candidates;
+        for (unsigned x = 0; x < numVariables; ++x) {
+            if (active[x] && values[x] == TruthValue::Undefined) {
+                candidates.emplace_back(x);
+            }
+        }
+
+        const auto numCandidates = std::min(candidates.size(), std::max<std::size_t>(
+            config.minCandidates, static_cast<std::size_t>(config.candidateFraction * candidates.size())));
+        std::ranges::partial_sort(candidates, candidates.begin() + static_cast<std::ptrdiff_t>(numCandidates),
+                                  std::greater{}, [&weights](unsigned x) {
+                                      return weights[pos(x).get()] * weights[neg(x).get()];
+                                  });
+        candidates.resize(numCandidates);
+        return candidates;
+    }
+
+    void LookaheadSolver::buildTrees(Round &round) const {
+        // a literal is placed below a candidate it implies, unless that would close a cycle
+        for (auto x: round.candidates) {
+            for (Literal l: {pos(x), neg(x)}) {
+                for (Literal k: implications[l.get()]) {
+                    if (!round.isCandidate[k.get()] || k == l || value(k) != TruthValue::Undefined) {
+                        continue;
+                    }
+
+                    auto ancestor = k;
+                    while (round.parents[ancestor.get()] != ancestor && ancestor != l) {
+                        ancestor = round.parents[ancestor.get()];
+                    }
+
+                    if (ancestor != l) {
+                        round.parents[l.get()] = k;
+                        round.children[k.get()].emplace_back(l);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    void LookaheadSolver::lookahead(Round &round, Literal l) {
+        const auto current = value(l);
+        if (current == TruthValue::False) {
+            // l implies its ancestors, which imply ¬l
+            round.failed.emplace_back(l);
+            return;
+        }
+
+        const auto reducedSize = reduced.size();
+        if (current == TruthValue::Undefined) {
+            ++statistics.lookaheads;
+            newLevel();
+            assign(l, false);
+            if (!propagate()) {
+                round.failed.emplace_back(l);
+                backtrack(levels.size() - 1);
+                reduced.resize(reducedSize);
+                return;
+            }
+        }
+
+        const auto difference = this->difference();
+        const auto level = levels.size() - 1;
+        if (current == TruthValue::Undefined && config.doubleLookahead && difference > doubleLookaheadTrigger &&
+            !doubleLookahead(round, l, difference)) {
+            round.failed.emplace_back(l);
+            backtrack(level);
+            reduced.resize(reducedSize);
+            return;
+        }
+
+        if (current == TruthValue::Undefined && config.localLearning) {
+            for (auto i = levels.back() + 1; i < trail.size(); ++i) {
+                if (fromClause[var(trail[i]).get()]) {
+                    learn(l, trail[i]);
+                }
+            }
+        }
+
+        round.differences[l.get()] = difference;
+        if (config.necessaryAssignments) {
+            round.implied[l.get()].assign(trail.begin() + static_cast<std::ptrdiff_t>(round.nodeTrail), trail.end());
+        }
+
+        for (Literal child: round.children[l.get()]) {
+            lookahead(round, child);
+        }
+
+        if (current == TruthValue::Undefined) {
+            backtrack(level);
+        }
+
+        reduced.resize(reducedSize);
+    }
+
+    bool LookaheadSolver::doubleLookahead(const Round &round, Literal l, double difference) {
+        ++statistics.doubleLookaheads;
+        bool found = false;
+        for (auto x: round.candidates) {
+            for (Literal m: {pos(x), neg(x)}) {
+                if (value(m) != TruthValue::Undefined) {
+                    continue;
+                }
+
+                ++statistics.lookaheads;
+                const auto reducedSize = reduced.size();
+                newLevel();
+                assign(m, false);
+                const bool consistent = propagate();
+                backtrack(levels.size() - 1);
+                reduced.resize(reducedSize);
+                if (!consistent) {
+                    // l → ¬m
+                    found = true;
+                    ++statistics.doubleLookaheadFailures;
+                    if (config.localLearning) {
+                        learn(l, m.negate());
+                    }
+
+                    assign(m.negate(), false);
+                    if (!propagate()) {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        // double lookaheads that find nothing become rarer
+        if (!found) {
+            doubleLookaheadTrigger = difference;
+        }
+
+        return true;
+    }
+
+    bool LookaheadSolver::lookaheadRound(Round &round, bool &progress) {
+        progress = false;
+        round.candidates = preselect();
+        if (round.candidates.empty()) {
+            return true;
+        }
+
+        const auto numLiterals = 2 * numVariables;
+        round.isCandidate.assign(numLiterals, 0);
+        round.parents.clear();
+        for (unsigned l = 0; l < numLiterals; ++l) {
+            round.parents.emplace_back(l);
+        }
+
+        round.children.assign(numLiterals, {});
+        round.differences.assign(numLiterals, -1);
+        round.implied.assign(numLiterals, {});
+        round.failed.clear();
+        round.nodeTrail = trail.size();
+        for (auto x: round.candidates) {
+            round.isCandidate[pos(x).get()] = round.isCandidate[neg(x).get()] = 1;
+        }
+
+        buildTrees(round);
+        for (auto x: round.candidates) {
+            for (Literal l: {pos(x), neg(x)}) {
+                if (round.parents[l.get()] == l) {
+                    reduced.clear();
+                    lookahead(round, l);
+                }
+            }
+        }
+
+        for (Literal l: round.failed) {
+            ++statistics.failedLiterals;
+            if (value(l) == TruthValue::True) {
+                return false;
+            }
+
+            if (value(l) == TruthValue::Undefined) {
+                assign(l.negate(), false);
+                progress = true;
+            }
+        }
+
+        if (config.necessaryAssignments) {
+            for (auto x: round.candidates) {
+                if (round.differences[pos(x).get()] < 0 || round.differences[neg(x).get()] < 0) {
+                    continue;
+                }
+
+                ++stamp;
+                for (Literal k: round.implied[pos(x).get()]) {
+                    stamps[k.get()] = stamp;
+                }
+
+                for (Literal k: round.implied[neg(x).get()]) {
+                    if (stamps[k.get()] != stamp) {
+                        continue;
+                    }
+
+                    if (value(k) == TruthValue::False) {
+                        return false;
+                    }
+
+                    if (value(k) == TruthValue::Undefined) {
+                        ++statistics.necessaryAssignments;
+                        assign(k, false);
+                        progress = true;
+                    }
+                }
+            }
+        }
+
+        return propagate();
+    }
+
+    SolverResult LookaheadSolver::search() {
+        if (terminated()) {
+            return SolverResult::Unknown;
+        }
+
+        ++statistics.nodes;
+        const auto learnedSize = learned.size();
+        doubleLookaheadTrigger *= config.doubleLookaheadDecay;
+        Round round;
+        bool progress = true;
+        while (progress) {
+            if (!lookaheadRound(round, progress)) {
+                unlearn(learnedSize);
+                return SolverResult::Unsat;
+            }
+
+            if (terminated()) {
+                return SolverResult::Unknown;
+            }
+        }
+
+        // no candidates are left once every clause is satisfied
+        if (round.candidates.empty()) {
+            model.resize(numVariables);
+            for (unsigned x = 0; x < numVariables; ++x) {
+                model[x] = values[x] == TruthValue::Undefined ? TruthValue::False : values[x];
+            }
+
+            return SolverResult::Sat;
+        }
+
+        const auto score = [&round](unsigned x) {
+            const auto a = round.differences[pos(x).get()];
+            const auto b = round.differences[neg(x).get()];
+            return 1024 * a * b + a + b;
+        };
+
+        const auto best = *std::ranges::max_element(round.candidates, {}, score);
+        const auto first = round.differences[pos(best).get()] <= round.differences[neg(best).get()] ? pos(best)
+                                                                                                     : neg(best);
+        for (Literal l: {first, first.negate()}) {
+            newLevel();
+            assign(l, false);
+            if (propagate()) {
+                if (const auto result = search(); result != SolverResult::Unsat) {
+                    return result;
+                }
+            }
+
+            backtrack(levels.size() - 1);
+        }
+
+        unlearn(learnedSize);
+        return SolverResult::Unsat;
+    }
+
+    SolverResult LookaheadSolver::solve() {
+        const auto start = std::chrono::steady_clock::now();
+        model.clear();
+        auto result = SolverResult::Unsat;
+        if (!emptyClause) {
+            bool consistent = true;
+            for (Literal l: units) {
+                if (value(l) == TruthValue::False) {
+                    consistent = false;
+                    break;
+                }
+
+                if (value(l) == TruthValue::Undefined) {
+                    assign(l, false);
+                }
+            }
+
+            if (consistent && propagate()) {
+                result = search();
+            }
+        }
+
+        statistics.time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (result == SolverResult::Sat) {
+            reconstruction.extend(model);
+        }
+
+        return result;
+    }
+
+    void LookaheadSolver::setTerminationFlag(const std::atomic_bool *flag) noexcept {
+        terminationFlag = flag;
+    }
+
+    TruthValue LookaheadSolver::val(Variable x) const {
+        if (x.get() >= model.size()) {
+            throw std::out_of_range("Variable index out of range");
+        }
+
+        return model[x.get()];
+    }
+
+    bool LookaheadSolver::satisfied(Literal l) const {
+        const auto value = val(var(l));
+        return (l.sign() == 1 && value == TruthValue::True) || (l.sign() == -1 && value == TruthValue::False);
+    }
+
+    auto LookaheadSolver::getModel() const -> const std::vector<TruthValue> & {
+        return model;
+    }
+
+    auto LookaheadSolver::reconstructionStack() -> ReconstructionStack & {
+        return reconstruction;
+    }
+
+    auto LookaheadSolver::getStatistics() const noexcept -> const LookaheadStatistics & {
+        return statistics;
+    }
+}
@@ -0,0 +1,184 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @file LookaheadSolver.hpp
+* @brief Contains the lookahead DPLL engine for small hard random formulas
+*/
+
+#ifndef LOOKAHEADSOLVER_HPP
+#define LOOKAHEADSOLVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "basic_structures.hpp"
+#include "Clause.hpp"
+#include "ReconstructionStack.hpp"
+#include "Solver.hpp"
+
+namespace sat {
+
+    /**
+     * @brief Parameters of the lookahead solver
+     */
+    struct LookaheadConfig {
+        double candidateFraction = 0.1; ///< share of the free variables preselected for the lookahead
+        unsigned minCandidates = 40; ///< the lookahead evaluates at least this many variables (if free)
+        unsigned weightIterations = 2; ///< refinements of the recursive weight heuristic used for the preselection
+        double reductionWeight = 0.2; ///< weight of a clause reduced to k + 1 literals relative to one reduced to k
+        bool doubleLookahead = true; ///< whether to run a second level of lookaheads below promising lookaheads
+        double doubleLookaheadDecay = 0.9; ///< decay of the difference needed to trigger a double lookahead per node
+        bool localLearning = true; ///< whether to add binary implications found by lookahead until backtracking
+        bool necessaryAssignments = true; ///< whether to assign literals implied by both polarities of a variable
+    };
+
+    /**
+     * @brief Statistics of the lookahead solver
+     */
+    struct LookaheadStatistics {
+        std::uint64_t nodes = 0;
+        std::uint64_t lookaheads = 0;
+        std::uint64_t failedLiterals = 0;
+        std::uint64_t necessaryAssignments = 0;
+        std::uint64_t doubleLookaheads = 0;
+        std::uint64_t doubleLookaheadFailures = 0; ///< failed literals found by double lookahead
+        std::uint64_t learnedImplications = 0;
+        double time = 0; ///< seconds spent in solve()
+    };
+
+    /**
+     * @brief March-style lookahead DPLL for small hard (random) formulas.
+     * @details @copybrief
+     * Binary clauses are kept as implication lists, longer clauses as literal arrays with a counter of true and of
+     * not yet falsified literals each, such that assignments are undone in constant time per occurrence.
+     * At every node of the search tree, the free variables are ranked by the recursive weight heuristic (a literal is
+     * worth the weighted sum over the clauses it would reduce, weighted by the previous iteration's weights of their
+     * other literals) and the best ones are preselected. The preselected literals are arranged in implication trees:
+     * if a implies b, the lookahead on a runs on top of the assignment of b, so the implications of b are only
+     * propagated once for both lookaheads. A lookahead on l propagates l and measures the difference, the weighted
+     * number of clauses reduced but not satisfied. If it fails, ¬l is a necessary assignment, as are the literals
+     * implied by both polarities of a variable. Implications found through longer clauses are learned as binary
+     * implications until the node is left (local learning). Lookaheads with a difference above a dynamic trigger are
+     * followed by a double lookahead on every preselected literal m on top of l: each failure yields the implication
+     * l → ¬m and refutes l if ¬m fails as well. Lookahead rounds are repeated until they find no more assignments,
+     * then the variable with the largest product of the differences of its polarities is branched on, starting with
+     * the polarity reducing fewer clauses.
+     */
+    class LookaheadSolver {
+        std::size_t numVariables;
+        LookaheadConfig config;
+        std::vector<std::vector<Literal>> implications; ///< literals implied by each literal through binary clauses
+        std::vector<std::uint32_t> binaryCounts; ///< implications from binary clauses, learned ones are appended
+        std::vector<std::uint32_t> clauseBegin; ///< clause c is literals[clauseBegin[c], clauseBegin[c + 1])
+        std::vector<Literal> literals;
+        std::vector<std::vector<std::uint32_t>> occurrences; ///< clauses (of size > 2) containing each literal
+        std::vector<std::uint32_t> trueCounts; ///< number of true literals of each clause
+        std::vector<std::uint32_t> freeCounts; ///< number of literals of each clause that were not propagated false
+        std::vector<double> reductionWeights; ///< difference of a clause reduced to the given size
+        std::vector<Literal> units;
+        bool emptyClause = false;
+        std::vector<TruthValue> values;
+        std::vector<Literal> trail;
+        std::size_t propagationHead = 0;
+        std::vector<std::size_t> levels; ///< trail size at the start of each level (decisions and lookaheads)
+        std::vector<char> fromClause; ///< whether the variable was implied by a clause of size > 2
+        std::vector<std::uint32_t> reduced; ///< clauses reduced since the start of the current implication tree
+        std::vector<std::pair<Literal, Literal>> learned; ///< local implications (a → b), undone when leaving the node
+        std::vector<unsigned> stamps; ///< marks literals by stamp
+        std::vector<unsigned> clauseStamps; ///< marks clauses by stamp
+        unsigned stamp = 0;
+        double doubleLookaheadTrigger = 0;
+        std::vector<TruthValue> model;
+        ReconstructionStack reconstruction;
+        LookaheadStatistics statistics;
+        const std::atomic_bool *terminationFlag = nullptr;
+
+        /**
+         * @brief Lookahead results of a round at a node
+         */
+        struct Round {
+            std::vector<unsigned> candidates;
+            std::vector<char> isCandidate; ///< indexed by literal
+            std::vector<Literal> parents; ///< parent in the implication trees (the literal itself for roots)
+            std::vector<std::vector<Literal>> children;
+            std::vector<double> differences; ///< negative if no lookahead was run
+            std::vector<std::vector<Literal>> implied; ///< assignments of each lookahead
+            std::vector<Literal> failed;
+            std::size_t nodeTrail = 0;
+        };
+
+        bool terminated() const;
+        TruthValue value(Literal l) const noexcept;
+        void assign(Literal l, bool implied);
+        bool propagate();
+        void newLevel();
+        void backtrack(std::size_t level);
+        void learn(Literal a, Literal b);
+        void unlearn(std::size_t size);
+        double difference();
+        auto preselect() -> std::vector<unsigned>;
+        void buildTrees(Round &round) const;
+        void lookahead(Round &round, Literal l);
+        bool doubleLookahead(const Round &round, Literal l, double difference);
+        bool lookaheadRound(Round &round, bool &progress);
+        SolverResult search();
+
+    public:
+        /**
+         * Ctor
+         * @param clauses clauses of the formula
+         * @param numVariables number of variables in the formula
+         * @param config lookahead parameters
+         */
+        LookaheadSolver(const std::vector<Clause> &clauses, std::size_t numVariables,
+                        const LookaheadConfig &config = {});
+
+        /**
+         * Runs the lookahead search
+         * @return SolverResult::Sat if a model was found (accessible via val()), SolverResult::Unsat if the formula is
+         * unsatisfiable, SolverResult::Unknown if the search was terminated
+         */
+        SolverResult solve();
+
+        /**
+         * Sets a flag that is polled during the search. Once the flag is set, solve() returns SolverResult::Unknown
+         * @param flag termination flag (nullptr to disable). Must outlive the search or be reset
+         */
+        void setTerminationFlag(const std::atomic_bool *flag) noexcept;
+
+        /**
+         * Gets the value of a variable in the model found by the search
+         * @param x variable
+         * @return the value of the variable
+         */
+        TruthValue val(Variable x) const;
+
+        /**
+         * Checks whether the literal is satisfied in the model
+         * @param l literal to check
+         * @return true if the literal is satisfied, false otherwise
+         */
+        bool satisfied(Literal l) const;
+
+        /**
+         * Gets the model found by the search
+         * @return vector of truth values for each variable (empty if no model was found)
+         */
+        auto getModel() const -> const std::vector<TruthValue> &;
+
+        /**
+         * Gets the reconstruction stack that is used to extend the model (e.g. to undo preprocessing)
+         * @return reconstruction stack of the search
+         */
+        auto reconstructionStack() -> ReconstructionStack &;
+
+        /**
+         * Gets the search statistics
+         * @return statistics
+         */
+        auto getStatistics() const noexcept -> const LookaheadStatistics &;
+    };
+}
+
+#endif //LOOKAHEADSOLVER_HPP
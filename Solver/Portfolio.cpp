@@ -0,0 +1,244 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <stdexcept>
+#include <thread>
+
+#include "Portfolio.hpp"
+#include "ClauseExchange.hpp"
+#include "ClauseSharing.hpp"
+
+namespace sat {
+    namespace {
+        bool shareable(const Clause &clause, unsigned lbd, unsigned sizeLimit, unsigned lbdLimit) {
+            return clause.size() == 1 || (clause.size() <= sizeLimit && lbd <= lbdLimit);
+        }
+
+        /**
+         * @brief Connection of a single worker to the exchange. Only exports short clauses with low LBD and units
+         */
+        class Endpoint : public ClauseSharing {
+            ClauseExchange &exchange;
+            unsigned worker;
+            unsigned sizeLimit;
+            unsigned lbdLimit;
+
+        public:
+            Endpoint(ClauseExchange &exchange, unsigned worker, unsigned sizeLimit, unsigned lbdLimit)
+                : exchange(exchange), worker(worker), sizeLimit(sizeLimit), lbdLimit(lbdLimit) {}
+
+            void exportClause(const Clause &clause, unsigned lbd) override {
+                if (shareable(clause, lbd, sizeLimit, lbdLimit)) {
+                    exchange.publish(worker, clause, lbd);
+                }
+            }
+
+            void importClauses(std::vector<SharedClause> &clauses) override {
+                exchange.collect(worker, clauses);
+            }
+        };
+
+        /**
+         * @brief Connection of a worker in deterministic mode. Exports are collected during an epoch and distributed
+         * at the barrier, the batch is imported at the next restart
+         */
+        class EpochEndpoint : public ClauseSharing {
+            unsigned sizeLimit;
+            unsigned lbdLimit;
+
+        public:
+            std::vector<SharedClause> exported; ///< clauses exported during the current epoch
+            std::vector<SharedClause> batch; ///< clauses of the other workers in canonical order
+
+            EpochEndpoint(unsigned sizeLimit, unsigned lbdLimit) : sizeLimit(sizeLimit), lbdLimit(lbdLimit) {}
+
+            void exportClause(const Clause &clause, unsigned lbd) override {
+                if (shareable(clause, lbd, sizeLimit, lbdLimit)) {
+                    exported.emplace_back(clause, lbd);
+                }
+            }
+
+            void importClauses(std::vector<SharedClause> &clauses) override {
+                for (auto &clause: batch) {
+                    clauses.emplace_back(std::move(clause));
+                }
+
+                batch.clear();
+            }
+        };
+    }
+
+    Portfolio::Portfolio(std::vector<Clause> clauses, unsigned numVariables, const PortfolioConfig &config)
+        : clauses(std::move(clauses)), numVariables(numVariables), config(config),
+          model(numVariables, TruthValue::Undefined) {
+        this->config.threads = std::max(this->config.threads, 1u);
+    }
+
+    SolverResult Portfolio::solve() {
+        if (config.deterministic) {
+            return solveDeterministic();
+        }
+
+        std::atomic_bool stop = false;
+        ClauseExchange exchange(config.threads, config.exchangeCapacity);
+        auto result = SolverResult::Unknown;
+        statistics.assign(config.threads, {});
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(config.threads);
+            for (unsigned worker = 0; worker < config.threads; ++worker) {
+                workers.emplace_back([this, worker, &stop, &exchange, &result] {
+                    Solver solver(numVariables, diversify(config.solverConfig, worker));
+                    Endpoint endpoint(exchange, worker, config.shareSizeLimit, config.shareLBDLimit);
+                    solver.setTerminationFlag(&stop);
+                    solver.setClauseSharing(&endpoint);
+                    solver.reconstructionStack().append(reconstruction);
+                    for (const auto &clause: clauses) {
+                        solver.addClause(clause);
+                    }
+
+                    const auto res = solver.solve();
+                    statistics[worker] = solver.getStatistics();
+                    // only the first finished worker may write the result, all others are stopped
+                    if (res != SolverResult::Unknown && !stop.exchange(true)) {
+                        result = res;
+                        winner = worker;
+                        if (res == SolverResult::Sat) {
+                            model = solver.getModel();
+                        }
+                    }
+                });
+            }
+        }
+
+        exchangeStatistics = exchange.getStatistics();
+        return result;
+    }
+
+    SolverResult Portfolio::solveDeterministic() {
+        const auto threads = config.threads;
+        std::vector<EpochEndpoint> endpoints(threads, EpochEndpoint(config.shareSizeLimit, config.shareLBDLimit));
+        std::vector<SolverResult> results(threads, SolverResult::Unknown);
+        auto result = SolverResult::Unknown;
+        bool done = false;
+        exchangeStatistics = {};
+        statistics.assign(threads, {});
+        // runs on one thread after all workers arrived, before any worker continues
+        const auto synchronize = [&]() noexcept {
+            if (const auto finished = std::ranges::find_if(results, [](auto r) { return r != SolverResult::Unknown; });
+                finished != results.end()) {
+                result = *finished;
+                winner = static_cast<unsigned>(finished - results.begin());
+                done = true;
+                return;
+            }
+
+            for (unsigned worker = 0; worker < threads; ++worker) {
+                auto &batch = endpoints[worker].batch;
+                for (unsigned producer = 0; producer < threads; ++producer) {
+                    if (producer != worker) {
+                        const auto &exported = endpoints[producer].exported;
+                        batch.insert(batch.end(), exported.begin(), exported.end());
+                    }
+                }
+            }
+
+            for (auto &endpoint: endpoints) {
+                exchangeStatistics.published += endpoint.exported.size();
+                endpoint.exported.clear();
+            }
+        };
+
+        std::barrier barrier(threads, synchronize);
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(threads);
+            for (unsigned worker = 0; worker < threads; ++worker) {
+                workers.emplace_back([&, worker] {
+                    auto solverConfig = diversify(config.solverConfig, worker);
+                    // inprocessing budgets depend on the measured search time
+                    solverConfig.inprocessing = false;
+                    Solver solver(numVariables, solverConfig);
+                    solver.setClauseSharing(&endpoints[worker]);
+                    solver.reconstructionStack().append(reconstruction);
+                    for (const auto &clause: clauses) {
+                        solver.addClause(clause);
+                    }
+
+                    while (true) {
+                        results[worker] = solver.solve({}, config.syncInterval);
+                        barrier.arrive_and_wait();
+                        if (done) {
+                            if (winner == worker && result == SolverResult::Sat) {
+                                model = solver.getModel();
+                            }
+
+                            break;
+                        }
+                    }
+
+                    statistics[worker] = solver.getStatistics();
+                });
+            }
+        }
+
+        return result;
+    }
+
+    SolverConfig Portfolio::diversify(const SolverConfig &base, unsigned worker) {
+        if (worker == 0) {
+            return base;
+        }
+
+        constexpr double Decays[] = {0.95, 0.9, 0.99, 0.85};
+        constexpr unsigned RestartUnits[] = {100, 50, 200, 400};
+        constexpr TruthValue Phases[] = {TruthValue::False, TruthValue::True, TruthValue::Undefined};
+        auto config = base;
+        config.seed = worker;
+        config.variableDecay = Decays[worker % 4];
+        config.restartUnit = RestartUnits[(worker + worker / 4) % 4];
+        config.initialPhase = Phases[worker % 3];
+        // elimination changes the formula, workers without elimination can still import clauses over all variables
+        config.elimination = base.elimination && worker % 2 == 0;
+        return config;
+    }
+
+    TruthValue Portfolio::val(Variable x) const {
+        if (x.get() >= numVariables) {
+            throw std::out_of_range("Variable index out of range");
+        }
+
+        return model[x.get()];
+    }
+
+    bool Portfolio::satisfied(Literal l) const {
+        const auto value = val(var(l));
+        return (l.sign() == 1 && value == TruthValue::True) || (l.sign() == -1 && value == TruthValue::False);
+    }
+
+    auto Portfolio::getModel() const -> const std::vector<TruthValue> & {
+        return model;
+    }
+
+    auto Portfolio::reconstructionStack() -> ReconstructionStack & {
+        return reconstruction;
+    }
+
+    auto Portfolio::getWinner() const noexcept -> std::optional<unsigned> {
+        return winner;
+    }
+
+    auto Portfolio::getStatistics() const noexcept -> const std::vector<SolverStatistics> & {
+        return statistics;
+    }
+
+    auto Portfolio::getExchangeStatistics() const noexcept -> const ClauseExchangeStatistics & {
+        return exchangeStatistics;
+    }
+}
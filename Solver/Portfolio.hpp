@@ -0,0 +1,134 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @file Portfolio.hpp
+* @brief Contains the parallel portfolio solver that runs several diversified solvers on separate threads
+*/
+
+#ifndef PORTFOLIO_HPP
+#define PORTFOLIO_HPP
+
+#include <vector>
+#include <optional>
+#include <cstddef>
+#include <cstdint>
+
+#include "basic_structures.hpp"
+#include "Clause.hpp"
+#include "ClauseExchange.hpp"
+#include "ReconstructionStack.hpp"
+#include "Solver.hpp"
+
+namespace sat {
+
+    /**
+     * @brief Parameters of the portfolio
+     */
+    struct PortfolioConfig {
+        unsigned threads = 4; ///< number of solvers running in parallel
+        unsigned shareSizeLimit = 8; ///< learned clauses up to this length are shared
+        unsigned shareLBDLimit = 4; ///< learned clauses up to this LBD are shared
+        std::size_t exchangeCapacity = 1 << 16; ///< number of literals (plus headers) each worker's buffer can hold
+        bool deterministic = false; ///< whether to synchronize the workers at conflict barriers (see Portfolio)
+        std::uint64_t syncInterval = 5000; ///< conflicts of each worker between two barriers in deterministic mode
+        /// configuration of the first solver, all other solvers are derived from it
+        SolverConfig solverConfig{.elimination = true};
+    };
+
+    /**
+     * @brief Parallel portfolio of CDCL solvers.
+     * @details @copybrief
+     * Each worker thread runs its own Solver on a copy of the formula. The workers differ in random seed, VSIDS decay,
+     * restart interval and initial phase (see diversify()) such that they explore different parts of the search
+     * space. Short learned clauses with low LBD and root level units are exchanged between the workers through a
+     * lock-free ClauseExchange and imported at restarts. The first worker that finds a result stops all other
+     * workers.
+     * In deterministic mode, every worker searches for PortfolioConfig::syncInterval conflicts and then waits at a
+     * barrier. At the barrier, the result of the worker with the lowest index that finished is taken. Otherwise, the
+     * clauses exported during the epoch are handed to each worker in canonical order (by worker index, then in export
+     * order) and imported at its next restart. Time budgeted inprocessing is disabled in this mode. Thus, the same
+     * configuration and thread count always reproduce the same search and result, independent of thread scheduling.
+     */
+    class Portfolio {
+        std::vector<Clause> clauses;
+        unsigned numVariables;
+        PortfolioConfig config;
+        ReconstructionStack reconstruction;
+        std::vector<TruthValue> model;
+        std::vector<SolverStatistics> statistics;
+        std::optional<unsigned> winner;
+        ClauseExchangeStatistics exchangeStatistics;
+
+        SolverResult solveDeterministic();
+
+    public:
+        /**
+         * Ctor
+         * @param clauses clauses of the formula
+         * @param numVariables number of variables in the formula
+         * @param config portfolio parameters
+         */
+        Portfolio(std::vector<Clause> clauses, unsigned numVariables, const PortfolioConfig &config = {});
+
+        /**
+         * Runs all workers until the first one finishes
+         * @return SolverResult::Sat if a model was found (accessible via val()), SolverResult::Unsat if the problem is
+         * unsatisfiable
+         */
+        SolverResult solve();
+
+        /**
+         * Derives the configuration of a worker from the base configuration. Worker 0 uses the base configuration
+         * @param base base solver configuration
+         * @param worker worker index
+         * @return diversified configuration
+         */
+        static SolverConfig diversify(const SolverConfig &base, unsigned worker);
+
+        /**
+         * Gets the value of a variable in the model found by the winning worker
+         * @param x variable
+         * @return the value of the variable
+         */
+        TruthValue val(Variable x) const;
+
+        /**
+         * Checks whether the literal is satisfied in the model
+         * @param l literal to check
+         * @return true if the literal is satisfied, false otherwise
+         */
+        bool satisfied(Literal l) const;
+
+        /**
+         * Gets the model found by the winning worker
+         * @return vector of truth values for each variable
+         */
+        auto getModel() const -> const std::vector<TruthValue> &;
+
+        /**
+         * Gets the reconstruction stack that is used to extend the model (e.g. to undo preprocessing)
+         * @return reconstruction stack of the portfolio
+         */
+        auto reconstructionStack() -> ReconstructionStack &;
+
+        /**
+         * Gets the index of the worker that found the result
+         * @return worker index or std::nullopt if solve() was not called
+         */
+        auto getWinner() const noexcept -> std::optional<unsigned>;
+
+        /**
+         * Gets the statistics of all workers
+         * @return search statistics, one entry per worker
+         */
+        auto getStatistics() const noexcept -> const std::vector<SolverStatistics> &;
+
+        /**
+         * Gets the statistics of the clause exchange of the last solve() call
+         * @return exchange statistics
+         */
+        auto getExchangeStatistics() const noexcept -> const ClauseExchangeStatistics &;
+    };
+}
+
+#endif //PORTFOLIO_HPP
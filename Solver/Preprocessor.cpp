@@ -0,0 +1,962 @@
+/**
+* @author Tim Luchterhand
+* @date 18.10.26
+* @brief
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <limits>
+
+#include "Preprocessor.hpp"
+#include "CardinalityConstraints.hpp"
+#include "Solver.hpp"
+#include "Symmetry.hpp"
+#include "util/enum.hpp"
+
+namespace sat {
+    Preprocessor::Preprocessor(std::vector<Clause> clauses, std::size_t numVariables, const PreprocessorConfig &config,
+                               ProofWriter *proof, std::vector<ClauseId> ids)
+        : numVariables(numVariables), config(config), occurrences(2 * numVariables),
+          values(numVariables, TruthValue::Undefined), eliminated(numVariables, 0), frozen(numVariables, 0),
+          unitIds(numVariables, 0), touched(numVariables, 0), marks(2 * numVariables, 0), checker(numVariables),
+          proof(proof) {
+        assert(ids.empty() || ids.size() == clauses.size());
+        if (ids.empty()) {
+            // all input clauses are registered before adding a clause may derive lemmas
+            ids.resize(clauses.size(), 0);
+            if (proof != nullptr) {
+                std::ranges::generate(ids, [proof] { return proof->addInput(); });
+            }
+        }
+
+        this->clauses.reserve(clauses.size());
+        for (std::size_t i = 0; i < clauses.size(); ++i) {
+            add(std::move(clauses[i]), ids[i]);
+        }
+
+        subsumptionQueue.clear();
+    }
+
+    TruthValue Preprocessor::value(Literal l) const noexcept {
+        const auto v = to_underlying(values[var(l).get()]);
+        return static_cast<TruthValue>(l.sign() > 0 ? v : -v);
+    }
+
+    bool Preprocessor::needsHints() const noexcept {
+        return proof != nullptr && proof->needsHints();
+    }
+
+    void Preprocessor::add(Clause clause, ClauseId id, std::vector<ClauseId> hints) {
+        if (unsat) {
+            return;
+        }
+
+        // clauses with an identifier are already part of the proof, the others are derived by the given hints
+        const bool derived = id == 0;
+        Clause original;
+        if (proof != nullptr && not derived) {
+            original = clause;
+            hints.assign({id});
+        }
+
+        std::ranges::sort(clause, {}, [](Literal l) { return l.get(); });
+        const auto [first, last] = std::ranges::unique(clause);
+        clause.erase(first, last);
+        for (std::size_t i = 0; i < clause.size(); ++i) {
+            if (value(clause[i]) == TruthValue::True || (i > 0 && clause[i] == clause[i - 1].negate())) {
+                return;
+            }
+        }
+
+        const auto size = clause.size();
+        if (needsHints()) {
+            // the units falsifying literals are propagated first
+            for (Literal l: clause) {
+                if (value(l) == TruthValue::False) {
+                    hints.insert(hints.begin(), unitIds[var(l).get()]);
+                }
+            }
+        }
+
+        std::erase_if(clause, [this](Literal l) { return value(l) == TruthValue::False; });
+        // existing clauses are replaced if strengthened by units
+        if (proof != nullptr && (derived || clause.size() < size)) {
+            const auto strengthenedId = proof->addClause(clause, hints);
+            if (not derived) {
+                proof->deleteClause(original, id);
+            }
+
+            id = strengthenedId;
+        }
+
+        if (clause.empty()) {
+            unsat = true;
+            return;
+        }
+
+        if (clause.size() == 1) {
+            assign(clause.front(), id);
+            return;
+        }
+
+        const auto index = clauses.size();
+        for (Literal l: clause) {
+            occurrences[l.get()].emplace_back(index);
+            touched[var(l).get()] = 1;
+        }
+
+        const auto sig = signature(clause);
+        clauses.emplace_back(std::move(clause), sig, false, id);
+        subsumptionQueue.emplace_back(index);
+    }
+
+    void Preprocessor::remove(std::size_t index) {
+        auto &entry = clauses[index];
+        assert(not entry.deleted);
+        entry.deleted = true;
+        if (proof != nullptr) {
+            proof->deleteClause(entry.literals, entry.id);
+        }
+
+        for (Literal l: entry.literals) {
+            touched[var(l).get()] = 1;
+        }
+    }
+
+    void Preprocessor::assign(Literal l, ClauseId id) {
+        const auto current = value(l);
+        if (current == TruthValue::False) {
+            if (proof != nullptr) {
+                proof->addClause({}, {unitIds[var(l).get()], id});
+            }
+
+            unsat = true;
+        } else if (current == TruthValue::Undefined) {
+            values[var(l).get()] = l.sign() > 0 ? TruthValue::True : TruthValue::False;
+            unitIds[var(l).get()] = id;
+            units.emplace_back(l);
+            ++statistics.fixedVariables;
+        }
+    }
+
+    bool Preprocessor::propagateUnits() {
+        while (not units.empty() && not unsat) {
+            const Literal l = units.back();
+            units.pop_back();
+            for (auto index: occurrences[l.get()]) {
+                if (not clauses[index].deleted) {
+                    remove(index);
+                }
+            }
+
+            occurrences[l.get()].clear();
+            const auto falsifiedIn = std::move(occurrences[l.negate().get()]);
+            occurrences[l.negate().get()].clear();
+            for (auto index: falsifiedIn) {
+                if (clauses[index].deleted) {
+                    continue;
+                }
+
+                // the strengthened clause is added first such that it can be derived from the original one
+                add(clauses[index].literals, 0, {clauses[index].id});
+                remove(index);
+            }
+        }
+
+        return not unsat;
+    }
+
+    auto Preprocessor::liveOccurrences(Literal l) -> const std::vector<std::size_t> & {
+        auto &occ = occurrences[l.get()];
+        std::erase_if(occ, [this](auto index) { return clauses[index].deleted; });
+        return occ;
+    }
+
+    bool Preprocessor::resolve(const Clause &positive, const Clause &negative, Variable x, Clause &resolvent) {
+        ++stamp;
+        resolvent.clear();
+        for (Literal l: positive) {
+            if (var(l) != x) {
+                marks[l.get()] = stamp;
+                resolvent.emplace_back(l);
+            }
+        }
+
+        for (Literal l: negative) {
+            if (var(l) == x || marks[l.get()] == stamp) {
+                continue;
+            }
+
+            if (marks[l.negate().get()] == stamp) {
+                return false;
+            }
+
+            resolvent.emplace_back(l);
+        }
+
+        return true;
+    }
+
+    bool Preprocessor::tryEliminate(Variable x) {
+        const auto id = x.get();
+        if (values[id] != TruthValue::Undefined || eliminated[id] || frozen[id]) {
+            return false;
+        }
+
+        const auto positive = liveOccurrences(pos(x));
+        const auto negative = liveOccurrences(neg(x));
+        if (positive.size() > config.occurrenceLimit && negative.size() > config.occurrenceLimit) {
+            return false;
+        }
+
+        const auto bound = positive.size() + negative.size() + config.eliminationGrowth;
+        std::vector<Clause> resolvents;
+        std::vector<std::vector<ClauseId>> antecedents;
+        Clause resolvent;
+        for (auto p: positive) {
+            for (auto n: negative) {
+                if (not resolve(clauses[p].literals, clauses[n].literals, x, resolvent)) {
+                    continue;
+                }
+
+                if (resolvent.size() > config.resolventLengthLimit || resolvents.size() == bound) {
+                    return false;
+                }
+
+                resolvents.emplace_back(resolvent);
+                antecedents.push_back({clauses[p].id, clauses[n].id});
+            }
+        }
+
+        // the clauses of the smaller side are sufficient to reconstruct the value of x
+        const bool storePositive = positive.size() <= negative.size();
+        for (auto index: storePositive ? positive : negative) {
+            reconstruction.push(storePositive ? pos(x) : neg(x), clauses[index].literals);
+        }
+
+        reconstruction.push(storePositive ? neg(x) : pos(x), {storePositive ? neg(x) : pos(x)});
+        for (std::size_t i = 0; i < resolvents.size(); ++i) {
+            add(std::move(resolvents[i]), 0, std::move(antecedents[i]));
+        }
+
+        for (const auto &side: {positive, negative}) {
+            for (auto index: side) {
+                remove(index);
+            }
+        }
+
+        occurrences[pos(x).get()].clear();
+        occurrences[neg(x).get()].clear();
+        eliminated[id] = 1;
+        ++statistics.eliminatedVariables;
+        statistics.removedClauses += positive.size() + negative.size();
+        statistics.resolvents += resolvents.size();
+        propagateUnits();
+        return true;
+    }
+
+    void Preprocessor::strengthen(std::size_t index, Literal l, ClauseId by) {
+        auto &entry = clauses[index];
+        if (proof != nullptr) {
+            auto strengthened = entry.literals;
+            std::erase(strengthened, l);
+            const auto id = proof->addClause(strengthened, {by, entry.id});
+            proof->deleteClause(entry.literals, entry.id);
+            entry.id = id;
+        }
+
+        std::erase(entry.literals, l);
+        std::erase(occurrences[l.get()], index);
+        touched[var(l).get()] = 1;
+        ++statistics.strengthenedClauses;
+        if (entry.literals.size() == 1) {
+            const Literal unit = entry.literals.front();
+            remove(index);
+            assign(unit, entry.id);
+        } else {
+            entry.signature = signature(entry.literals);
+            subsumptionQueue.emplace_back(index);
+        }
+    }
+
+    bool Preprocessor::forwardSubsume(std::size_t index, const std::vector<std::vector<std::size_t>> &oneWatch) {
+        using enum SubsumptionChecker::Result;
+        auto scan = [&]() {
+            const auto &entry = clauses[index];
+            checker.mark(entry.literals);
+            for (Literal l: entry.literals) {
+                for (Literal w: {l, l.negate()}) {
+                    for (auto candidate: oneWatch[w.get()]) {
+                        const auto &other = clauses[candidate];
+                        if (other.deleted || other.literals.size() > entry.literals.size() ||
+                            (other.signature & ~entry.signature) != 0) {
+                            continue;
+                        }
+
+                        const auto [result, removable] = checker.check(other.literals);
+                        if (result != None) {
+                            return std::tuple(result, removable, other.id);
+                        }
+                    }
+                }
+            }
+
+            return std::tuple(None, Literal(0), ClauseId(0));
+        };
+
+        while (true) {
+            const auto [result, removable, by] = scan();
+            if (result == None) {
+                return true;
+            }
+
+            if (result == Subsumes) {
+                remove(index);
+                ++statistics.subsumedClauses;
+                return false;
+            }
+
+            strengthen(index, removable, by);
+            if (clauses[index].deleted) {
+                return false;
+            }
+        }
+    }
+
+    void Preprocessor::backwardSubsume(std::size_t index) {
+        using enum SubsumptionChecker::Result;
+        if (clauses[index].deleted) {
+            return;
+        }
+
+        auto cost = [this](Literal l) {
+            return occurrences[l.get()].size() + occurrences[l.negate().get()].size();
+        };
+
+        const Literal pivot = *std::ranges::min_element(clauses[index].literals, {}, cost);
+        std::vector candidates(occurrences[pivot.get()]);
+        const auto &negated = occurrences[pivot.negate().get()];
+        candidates.insert(candidates.end(), negated.begin(), negated.end());
+        for (auto candidate: candidates) {
+            const auto &entry = clauses[index];
+            const auto &other = clauses[candidate];
+            if (candidate == index || other.deleted || other.literals.size() < entry.literals.size() ||
+                (entry.signature & ~other.signature) != 0) {
+                continue;
+            }
+
+            checker.mark(other.literals);
+            const auto [result, removable] = checker.check(entry.literals);
+            if (result == Subsumes) {
+                remove(candidate);
+                ++statistics.subsumedClauses;
+            } else if (result == Strengthens) {
+                strengthen(candidate, removable, entry.id);
+            }
+        }
+    }
+
+    bool Preprocessor::backwardSubsumeQueued() {
+        while (not subsumptionQueue.empty() && propagateUnits()) {
+            const auto index = subsumptionQueue.back();
+            subsumptionQueue.pop_back();
+            backwardSubsume(index);
+        }
+
+        return propagateUnits();
+    }
+
+    bool Preprocessor::subsume() {
+        if (not propagateUnits()) {
+            return false;
+        }
+
+        std::vector<std::size_t> order;
+        for (std::size_t i = 0; i < clauses.size(); ++i) {
+            if (not clauses[i].deleted) {
+                order.emplace_back(i);
+            }
+        }
+
+        std::ranges::stable_sort(order, {}, [this](auto index) { return clauses[index].literals.size(); });
+        subsumptionQueue.clear();
+        std::vector<std::vector<std::size_t>> oneWatch(2 * numVariables);
+        for (auto index: order) {
+            if (clauses[index].deleted || not forwardSubsume(index, oneWatch)) {
+                continue;
+            }
+
+            const Literal watch = *std::ranges::min_element(clauses[index].literals, {}, [this](Literal l) {
+                return occurrences[l.get()].size();
+            });
+
+            oneWatch[watch.get()].emplace_back(index);
+        }
+
+        return backwardSubsumeQueued();
+    }
+
+    auto Preprocessor::equivalentLiterals() -> std::vector<Literal> {
+        const auto numLiterals = 2 * numVariables;
+        // binary implication graph in compressed form: successors of l are targets[offsets[l]] ... targets[offsets[l + 1] - 1]
+        std::vector<std::size_t> offsets(numLiterals + 1, 0);
+        for (const auto &entry: clauses) {
+            if (not entry.deleted && entry.literals.size() == 2) {
+                ++offsets[entry.literals[0].negate().get() + 1];
+                ++offsets[entry.literals[1].negate().get() + 1];
+            }
+        }
+
+        for (std::size_t l = 0; l < numLiterals; ++l) {
+            offsets[l + 1] += offsets[l];
+        }
+
+        std::vector<unsigned> targets(offsets.back());
+        std::vector cursor(offsets.begin(), offsets.end() - 1);
+        for (const auto &entry: clauses) {
+            if (not entry.deleted && entry.literals.size() == 2) {
+                const Literal a = entry.literals[0];
+                const Literal b = entry.literals[1];
+                targets[cursor[a.negate().get()]++] = b.get();
+                targets[cursor[b.negate().get()]++] = a.get();
+            }
+        }
+
+        std::vector<Literal> representatives;
+        representatives.reserve(numLiterals);
+        for (std::size_t l = 0; l < numLiterals; ++l) {
+            representatives.emplace_back(static_cast<unsigned>(l));
+        }
+
+        std::vector<char> done(numLiterals, 0);
+        auto substitute = [&](const std::vector<unsigned> &component) {
+            if (component.size() < 2 || done[component.front()]) {
+                return;
+            }
+
+            ++stamp;
+            for (auto l: component) {
+                if (marks[Literal(l).negate().get()] == stamp) {
+                    unsat = true; // l and ¬l are equivalent
+                    if (proof != nullptr) {
+                        proof->addClause({Literal(l).negate()});
+                        proof->addClause({Literal(l)});
+                        proof->addClause({});
+                    }
+
+                    return;
+                }
+
+                marks[l] = stamp;
+            }
+
+            const Literal representative(std::ranges::min(component, {}, [this](unsigned l) {
+                return std::pair(not frozen[l / 2], l / 2);
+            }));
+
+            for (auto idx: component) {
+                const Literal l(idx);
+                done[l.get()] = done[l.negate().get()] = 1;
+                if (l != representative && not frozen[var(l).get()]) {
+                    representatives[l.get()] = representative;
+                    representatives[l.negate().get()] = representative.negate();
+                }
+            }
+        };
+
+        // iterative Tarjan
+        constexpr auto Unvisited = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> index(numLiterals, Unvisited);
+        std::vector<std::size_t> lowLink(numLiterals, 0);
+        std::vector<char> onStack(numLiterals, 0);
+        std::vector<unsigned> componentStack;
+        std::vector<std::pair<unsigned, std::size_t>> callStack;
+        std::vector<unsigned> component;
+        std::size_t counter = 0;
+        auto visit = [&](unsigned l) {
+            index[l] = lowLink[l] = counter++;
+            onStack[l] = 1;
+            componentStack.emplace_back(l);
+            callStack.emplace_back(l, offsets[l]);
+        };
+
+        for (unsigned root = 0; root < numLiterals && not unsat; ++root) {
+            if (index[root] != Unvisited || offsets[root] == offsets[root + 1]) {
+                continue;
+            }
+
+            visit(root);
+            while (not callStack.empty() && not unsat) {
+                auto &[node, edge] = callStack.back();
+                if (edge < offsets[node + 1]) {
+                    const auto successor = targets[edge++];
+                    if (index[successor] == Unvisited) {
+                        visit(successor);
+                    } else if (onStack[successor]) {
+                        lowLink[node] = std::min(lowLink[node], index[successor]);
+                    }
+
+                    continue;
+                }
+
+                const auto finished = node;
+                callStack.pop_back();
+                if (not callStack.empty()) {
+                    const auto parent = callStack.back().first;
+                    lowLink[parent] = std::min(lowLink[parent], lowLink[finished]);
+                }
+
+                if (lowLink[finished] == index[finished]) {
+                    component.clear();
+                    unsigned l;
+                    do {
+                        l = componentStack.back();
+                        componentStack.pop_back();
+                        onStack[l] = 0;
+                        component.emplace_back(l);
+                    } while (l != finished);
+
+                    substitute(component);
+                }
+            }
+        }
+
+        return representatives;
+    }
+
+    bool Preprocessor::substituteEquivalences() {
+        // substituted clauses would need the binary implication paths between equivalent literals as LRAT hints
+        if (not propagateUnits() || needsHints()) {
+            return not unsat;
+        }
+
+        for (unsigned round = 0; round < config.substitutionRounds; ++round) {
+            const auto representatives = equivalentLiterals();
+            if (unsat) {
+                return false;
+            }
+
+            std::vector<std::size_t> affected;
+            std::uint64_t substituted = 0;
+            for (unsigned x = 0; x < numVariables; ++x) {
+                const Literal representative = representatives[pos(x).get()];
+                if (representative == pos(x)) {
+                    continue;
+                }
+
+                // x <-> representative
+                reconstruction.push(pos(x), {pos(x), representative.negate()});
+                reconstruction.push(neg(x), {neg(x), representative});
+                eliminated[x] = 1;
+                ++substituted;
+                for (Literal l: {pos(x), neg(x)}) {
+                    const auto &occ = liveOccurrences(l);
+                    affected.insert(affected.end(), occ.begin(), occ.end());
+                    occurrences[l.get()].clear();
+                }
+            }
+
+            if (substituted == 0) {
+                break;
+            }
+
+            statistics.substitutedVariables += substituted;
+            statistics.substitutionsPerRound.emplace_back(substituted);
+            std::ranges::sort(affected);
+            const auto [first, last] = std::ranges::unique(affected);
+            affected.erase(first, last);
+            // all substituted clauses are added before the equivalences used to derive them are removed
+            for (auto index: affected) {
+                auto substitutedClause = clauses[index].literals;
+                for (auto &l: substitutedClause) {
+                    l = representatives[l.get()];
+                }
+
+                add(std::move(substitutedClause), 0);
+            }
+
+            for (auto index: affected) {
+                remove(index);
+            }
+
+            if (not propagateUnits() || (config.subsumption && not backwardSubsumeQueued())) {
+                return false;
+            }
+        }
+
+        return not unsat;
+    }
+
+    bool Preprocessor::run() {
+        if (config.cardinalityCounting && not countCardinalities()) {
+            return false;
+        }
+
+        // before elimination, symmetries are easier to find on the original structure
+        if (config.symmetryBreaking && not breakSymmetries()) {
+            return false;
+        }
+
+        if (config.subsumption) {
+            subsume();
+        }
+
+        if (config.equivalentLiterals) {
+            substituteEquivalences();
+        }
+
+        if (config.variableElimination) {
+            eliminateVariables();
+        }
+
+        if (config.blockedClauses) {
+            eliminateBlocked();
+        }
+
+        if (config.coveredClauses) {
+            eliminateCovered();
+        }
+
+        return propagateUnits();
+    }
+
+    bool Preprocessor::countCardinalities() {
+        if (unsat || proof != nullptr) {
+            return not unsat;
+        }
+
+        std::vector<Clause> formula;
+        formula.reserve(clauses.size());
+        for (const auto &entry: clauses) {
+            if (not entry.deleted) {
+                formula.emplace_back(entry.literals);
+            }
+        }
+
+        const auto constraints = findCardinalities(formula, config.maxCardinalityBound);
+        if (not constraints.empty() && countingConflict(constraints, formula, values)) {
+            unsat = true;
+        }
+
+        return not unsat;
+    }
+
+    bool Preprocessor::breakSymmetries() {
+        if (not propagateUnits() || proof != nullptr) {
+            return not unsat;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<Clause> formula;
+        formula.reserve(clauses.size());
+        for (const auto &entry: clauses) {
+            if (not entry.deleted) {
+                formula.emplace_back(entry.literals);
+            }
+        }
+
+        std::vector<char> fixed(numVariables, 0);
+        for (unsigned x = 0; x < numVariables; ++x) {
+            fixed[x] = frozen[x] || eliminated[x] || values[x] != TruthValue::Undefined;
+        }
+
+        const auto symmetries = findSymmetries(formula, numVariables, fixed, config.symmetryEffort);
+        statistics.symmetryGenerators += symmetries.size();
+        for (const auto &symmetry: symmetries) {
+            auto total = numVariables;
+            auto breaking = lexLeaderClauses(symmetry, total, config.lexLeaderLength);
+            statistics.auxiliaryVariables += total - numVariables;
+            addVariables(total - numVariables);
+
+            statistics.symmetryBreakingClauses += breaking.size();
+            for (auto &clause: breaking) {
+                add(std::move(clause), 0);
+            }
+        }
+
+        statistics.symmetryTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return propagateUnits();
+    }
+
+    void Preprocessor::addVariables(std::size_t count) {
+        if (count == 0) {
+            return;
+        }
+
+        numVariables += count;
+        occurrences.resize(2 * numVariables);
+        values.resize(numVariables, TruthValue::Undefined);
+        eliminated.resize(numVariables, 0);
+        frozen.resize(numVariables, 0);
+        unitIds.resize(numVariables, 0);
+        touched.resize(numVariables, 0);
+        marks.resize(2 * numVariables, 0);
+        checker = SubsumptionChecker(numVariables);
+    }
+
+    bool Preprocessor::eliminateVariables() {
+        if (not propagateUnits()) {
+            return false;
+        }
+
+        for (unsigned round = 0; round < config.eliminationRounds && not unsat; ++round) {
+            std::vector<unsigned> candidates;
+            for (unsigned x = 0; x < numVariables; ++x) {
+                if (touched[x] && not eliminated[x] && not frozen[x] && values[x] == TruthValue::Undefined) {
+                    candidates.emplace_back(x);
+                }
+
+                touched[x] = 0;
+            }
+
+            if (candidates.empty()) {
+                break;
+            }
+
+            // cheap candidates first: the number of resolution steps is the product of the occurrence counts
+            std::ranges::sort(candidates, {}, [this](unsigned x) {
+                return occurrences[pos(x).get()].size() * occurrences[neg(x).get()].size();
+            });
+
+            for (auto x: candidates) {
+                tryEliminate(x);
+                if (unsat) {
+                    return false;
+                }
+            }
+
+            // resolvents often subsume or strengthen other clauses, enabling further eliminations
+            if (config.subsumption && not backwardSubsumeQueued()) {
+                return false;
+            }
+        }
+
+        return not unsat;
+    }
+
+    bool Preprocessor::resolventTautological(const Clause &other, Literal pivot) const {
+        // the literals of the clause being resolved are marked with the current stamp
+        return std::ranges::any_of(other, [this, pivot](Literal m) {
+            return m != pivot.negate() && marks[m.negate().get()] == stamp;
+        });
+    }
+
+    bool Preprocessor::eliminateBlocked() {
+        if (not propagateUnits()) {
+            return false;
+        }
+
+        std::vector<Literal> queue;
+        std::vector<char> queued(2 * numVariables, 0);
+        for (unsigned l = 0; l < 2 * numVariables; ++l) {
+            if (not occurrences[l].empty()) {
+                queue.emplace_back(l);
+                queued[l] = 1;
+            }
+        }
+
+        // the queue is processed from the back: literals with few resolution partners first
+        std::ranges::sort(queue, std::ranges::greater{}, [this](Literal l) {
+            return occurrences[l.negate().get()].size();
+        });
+
+        while (not queue.empty()) {
+            const Literal l = queue.back();
+            queue.pop_back();
+            queued[l.get()] = 0;
+            const auto x = var(l).get();
+            if (frozen[x] || eliminated[x] || values[x] != TruthValue::Undefined ||
+                liveOccurrences(l.negate()).size() > config.occurrenceLimit) {
+                continue;
+            }
+
+            const auto candidates = liveOccurrences(l);
+            const auto &partners = liveOccurrences(l.negate());
+            for (auto index: candidates) {
+                const auto &clause = clauses[index].literals;
+                ++stamp;
+                for (Literal m: clause) {
+                    marks[m.get()] = stamp;
+                }
+
+                if (not std::ranges::all_of(partners, [&](auto partner) {
+                    return resolventTautological(clauses[partner].literals, l);
+                })) {
+                    continue;
+                }
+
+                reconstruction.push(l, clause);
+                remove(index);
+                ++statistics.blockedClauses;
+                // clauses containing ¬m lost a resolution partner on ¬m
+                for (Literal m: clause) {
+                    if (m != l && not queued[m.negate().get()]) {
+                        queued[m.negate().get()] = 1;
+                        queue.emplace_back(m.negate());
+                    }
+                }
+            }
+        }
+
+        return not unsat;
+    }
+
+    bool Preprocessor::coverClause(std::size_t index, std::vector<unsigned> &counts) {
+        Clause covered = clauses[index].literals;
+        ++stamp;
+        for (Literal m: covered) {
+            marks[m.get()] = stamp;
+        }
+
+        std::vector<ReconstructionStack::Entry> steps;
+        std::vector<Literal> candidates;
+        bool progress = true;
+        while (progress && covered.size() <= config.coveredLengthLimit) {
+            progress = false;
+            for (std::size_t i = 0; i < covered.size(); ++i) {
+                const Literal l = covered[i];
+                if (frozen[var(l).get()]) {
+                    continue;
+                }
+
+                const auto &partners = liveOccurrences(l.negate());
+                if (partners.size() > config.occurrenceLimit) {
+                    continue;
+                }
+
+                // covered literals occur in all partners producing non-tautological resolvents
+                unsigned nonTautological = 0;
+                candidates.clear();
+                for (auto partner: partners) {
+                    const auto &other = clauses[partner].literals;
+                    if (resolventTautological(other, l)) {
+                        continue;
+                    }
+
+                    ++nonTautological;
+                    for (Literal m: other) {
+                        if (m != l.negate() && marks[m.get()] != stamp && counts[m.get()]++ == 0) {
+                            candidates.emplace_back(m);
+                        }
+                    }
+                }
+
+                if (nonTautological == 0) {
+                    // the extended clause is blocked on l
+                    for (auto &step: steps) {
+                        reconstruction.push(step.witness, std::move(step.clause));
+                    }
+
+                    reconstruction.push(l, std::move(covered));
+                    return true;
+                }
+
+                const auto size = covered.size();
+                for (Literal m: candidates) {
+                    if (counts[m.get()] == nonTautological) {
+                        if (covered.size() == size) {
+                            steps.emplace_back(l, Clause(covered.begin(), covered.end()));
+                        }
+
+                        covered.emplace_back(m);
+                        marks[m.get()] = stamp;
+                    }
+
+                    counts[m.get()] = 0;
+                }
+
+                progress |= covered.size() > size;
+            }
+        }
+
+        return false;
+    }
+
+    bool Preprocessor::eliminateCovered() {
+        if (not propagateUnits()) {
+            return false;
+        }
+
+        std::vector<unsigned> counts(2 * numVariables, 0);
+        for (std::size_t index = 0; index < clauses.size(); ++index) {
+            if (not clauses[index].deleted && coverClause(index, counts)) {
+                remove(index);
+                ++statistics.coveredClauses;
+            }
+        }
+
+        return not unsat;
+    }
+
+    void Preprocessor::freeze(Variable x) {
+        frozen[x.get()] = 1;
+    }
+
+    bool Preprocessor::isEliminated(Variable x) const {
+        return eliminated[x.get()];
+    }
+
+    auto Preprocessor::getClauses() const -> std::vector<Clause> {
+        std::vector<Clause> ret;
+        if (unsat) {
+            ret.emplace_back();
+            return ret;
+        }
+
+        for (unsigned x = 0; x < numVariables; ++x) {
+            if (values[x] != TruthValue::Undefined) {
+                ret.emplace_back(Clause{values[x] == TruthValue::True ? pos(x) : neg(x)});
+            }
+        }
+
+        for (const auto &entry: clauses) {
+            if (not entry.deleted) {
+                ret.emplace_back(entry.literals);
+            }
+        }
+
+        return ret;
+    }
+
+    bool Preprocessor::transferTo(Solver &solver) const {
+        assert(solver.getNumVariables() == numVariables);
+        // the clauses keep their proof identifiers
+        if (unsat) {
+            return solver.addIrredundant({}, 0);
+        }
+
+        for (unsigned x = 0; x < numVariables; ++x) {
+            if (values[x] != TruthValue::Undefined &&
+                not solver.addIrredundant({values[x] == TruthValue::True ? pos(x) : neg(x)}, unitIds[x])) {
+                return false;
+            }
+        }
+
+        for (const auto &entry: clauses) {
+            if (not entry.deleted && not solver.addIrredundant(entry.literals, entry.id)) {
+                return false;
+            }
+        }
+
+        solver.reconstructionStack().append(reconstruction);
+        return true;
+    }
+
+    auto Preprocessor::getReconstructionStack() const noexcept -> const ReconstructionStack & {
+        return reconstruction;
+    }
+
+    std::size_t Preprocessor::getNumVariables() const noexcept {
+        return numVariables;
+    }
+
+    bool Preprocessor::isUnsat() const noexcept {
+        return unsat;
+    }
+
+    auto Preprocessor::getStatistics() const noexcept -> const PreprocessorStatistics & {
+        return statistics;
+    }
+}
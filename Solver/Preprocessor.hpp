@@ -0,0 +1,255 @@
+/**
+* @author Tim Luchterhand
+* @date 18.10.26
+* @file Preprocessor.hpp
+* @brief Contains the preprocessor that simplifies a formula before it is handed to the solver
+*/
+
+#ifndef PREPROCESSOR_HPP
+#define PREPROCESSOR_HPP
+
+#include <vector>
+#include <cstdint>
+
+#include "basic_structures.hpp"
+#include "Clause.hpp"
+#include "ProofWriter.hpp"
+#include "ReconstructionStack.hpp"
+
+namespace sat {
+    class Solver;
+
+    /**
+     * @brief Parameters of the preprocessor
+     */
+    struct PreprocessorConfig {
+        bool subsumption = true; ///< whether to run subsumption and self-subsuming resolution
+        bool equivalentLiterals = true; ///< whether to run equivalent literal substitution
+        unsigned substitutionRounds = 4; ///< maximum number of equivalent literal substitution passes
+        bool variableElimination = true; ///< whether to run bounded variable elimination
+        unsigned eliminationGrowth = 0; ///< number of additional clauses an elimination may produce
+        unsigned resolventLengthLimit = 20; ///< eliminations producing longer resolvents are rejected
+        unsigned occurrenceLimit = 64; ///< variables occurring more often in both polarities are not eliminated
+        unsigned eliminationRounds = 8; ///< maximum number of elimination passes over the touched variables
+        bool blockedClauses = true; ///< whether to run blocked clause elimination
+        bool coveredClauses = false; ///< whether to run covered clause elimination
+        unsigned coveredLengthLimit = 64; ///< covered literal addition stops at this clause length
+        bool cardinalityCounting = true; ///< whether to try the counting argument over at-most-k constraints first
+        unsigned maxCardinalityBound = 3; ///< largest bound k of an at-most-k constraint used by the counting argument
+        bool symmetryBreaking = false; ///< whether to add lex-leader clauses for the symmetries of the formula
+        std::uint64_t symmetryEffort = 50'000'000; ///< budget of the automorphism search in edge visits
+        unsigned lexLeaderLength = 100; ///< maximum number of positions compared by the clauses of a symmetry
+    };
+
+    /**
+     * @brief Statistics of the preprocessor
+     */
+    struct PreprocessorStatistics {
+        std::uint64_t eliminatedVariables = 0;
+        std::uint64_t removedClauses = 0;
+        std::uint64_t resolvents = 0;
+        std::uint64_t fixedVariables = 0;
+        std::uint64_t subsumedClauses = 0;
+        std::uint64_t strengthenedClauses = 0;
+        std::uint64_t substitutedVariables = 0;
+        std::vector<std::uint64_t> substitutionsPerRound; ///< number of variables substituted in each round
+        std::uint64_t blockedClauses = 0;
+        std::uint64_t coveredClauses = 0;
+        std::uint64_t symmetryGenerators = 0;
+        std::uint64_t symmetryBreakingClauses = 0;
+        std::uint64_t auxiliaryVariables = 0; ///< variables introduced by the symmetry-breaking clauses
+        double symmetryTime = 0; ///< time of the automorphism search in seconds
+    };
+
+    /**
+     * @brief Formula simplification working on occurrence lists.
+     * @details @copybrief
+     * Usage: construct the preprocessor from the clauses returned by inout::read_from_dimacs, call run() and then
+     * either write the simplified formula (getClauses()) or load it into a Solver using transferTo(). Variables
+     * removed by non-equivalence preserving techniques are recorded on a ReconstructionStack such that any model of
+     * the simplified formula can be extended to a model of the original formula.
+     */
+    class Preprocessor {
+        struct Entry {
+            Clause literals;
+            std::uint64_t signature = 0;
+            bool deleted = false;
+            ClauseId id = 0; ///< identifier in the proof
+        };
+
+        std::size_t numVariables;
+        PreprocessorConfig config;
+        std::vector<Entry> clauses;
+        std::vector<std::vector<std::size_t>> occurrences;
+        std::vector<TruthValue> values;
+        std::vector<char> eliminated;
+        std::vector<char> frozen;
+        std::vector<ClauseId> unitIds; ///< proof identifiers of the unit clauses of fixed variables
+        std::vector<char> touched;
+        std::vector<Literal> units;
+        std::vector<unsigned> marks;
+        unsigned stamp = 0;
+        SubsumptionChecker checker;
+        std::vector<std::size_t> subsumptionQueue;
+        bool unsat = false;
+        ReconstructionStack reconstruction;
+        PreprocessorStatistics statistics;
+        ProofWriter *proof;
+
+        TruthValue value(Literal l) const noexcept;
+        bool needsHints() const noexcept;
+        void add(Clause clause, ClauseId id, std::vector<ClauseId> hints = {});
+        void remove(std::size_t index);
+        void assign(Literal l, ClauseId id);
+        bool propagateUnits();
+        auto liveOccurrences(Literal l) -> const std::vector<std::size_t> &;
+        bool resolve(const Clause &positive, const Clause &negative, Variable x, Clause &resolvent);
+        bool tryEliminate(Variable x);
+        void strengthen(std::size_t index, Literal l, ClauseId by);
+        bool forwardSubsume(std::size_t index, const std::vector<std::vector<std::size_t>> &oneWatch);
+        void backwardSubsume(std::size_t index);
+        bool backwardSubsumeQueued();
+        auto equivalentLiterals() -> std::vector<Literal>;
+        bool resolventTautological(const Clause &other, Literal pivot) const;
+        bool coverClause(std::size_t index, std::vector<unsigned> &counts);
+        void addVariables(std::size_t count);
+
+    public:
+        /**
+         * Ctor
+         * @param clauses clauses of the formula
+         * @param numVariables number of variables in the formula
+         * @param config preprocessing parameters
+         * @param proof optional proof output. All clauses derived from the given clauses are added to the proof and
+         * removed clauses are deleted. Must outlive the preprocessor. Equivalent literal substitution is skipped for
+         * LRAT proofs since its lemmas would need the binary implication paths as hints
+         * @param ids proof identifiers of the given clauses. If empty, the clauses are registered as input clauses of
+         * the proof in the given order (see ProofWriter::addInput())
+         */
+        Preprocessor(std::vector<Clause> clauses, std::size_t numVariables, const PreprocessorConfig &config = {},
+                     ProofWriter *proof = nullptr, std::vector<ClauseId> ids = {});
+
+        /**
+         * Runs all enabled simplification techniques
+         * @return false if the formula was found to be unsatisfiable, true otherwise
+         */
+        bool run();
+
+        /**
+         * Tries to refute the formula by the counting argument over its at-most-k constraints (see countingConflict()),
+         * which decides pigeonhole formulas before elimination dissolves their constraints. Skipped with a proof since
+         * the argument has no resolution proof of polynomial size
+         * @return false if the formula was found to be unsatisfiable, true otherwise
+         */
+        bool countCardinalities();
+
+        /**
+         * Static symmetry breaking. Computes generators of the symmetry group of the formula (see findSymmetries())
+         * and adds their lex-leader clauses (see lexLeaderClauses()). Assigned and frozen variables are not moved by
+         * the symmetries. The clauses only preserve satisfiability: models of the simplified formula are still models
+         * of the original formula but not every model is kept. The clauses introduce auxiliary variables, hence
+         * getNumVariables() may grow. Skipped with a proof since the clauses are not implied by the formula
+         * @return false if the formula was found to be unsatisfiable, true otherwise
+         */
+        bool breakSymmetries();
+
+        /**
+         * Removes duplicate and subsumed clauses and strengthens clauses by self-subsuming resolution.
+         * @details @copybrief
+         * Clauses are processed in order of increasing size. Each clause is checked against the smaller clauses
+         * processed before (forward subsumption) using one-watch occurrence lists where every clause is only listed
+         * under its literal with the fewest occurrences. Strengthened clauses are then used for backward subsumption
+         * over the full occurrence lists. 64-bit clause signatures filter out most candidate pairs without looking at
+         * the literals.
+         * @return false if the formula was found to be unsatisfiable, true otherwise
+         */
+        bool subsume();
+
+        /**
+         * Equivalent literal substitution.
+         * @details @copybrief
+         * Computes the strongly connected components of the binary implication graph (iterative Tarjan). All literals
+         * of a component are equivalent and are replaced by a representative literal in all clauses. The substituted
+         * variables are removed from the formula and their equivalence is recorded on the reconstruction stack.
+         * Substitution produces new binary clauses, so several rounds are run until no new equivalences are found.
+         * @return false if the formula was found to be unsatisfiable, true otherwise
+         */
+        bool substituteEquivalences();
+
+        /**
+         * Bounded variable elimination by clause distribution. A variable is eliminated if the number of
+         * non-tautological resolvents does not exceed the number of clauses it occurs in (plus the configured growth).
+         * @return false if the formula was found to be unsatisfiable, true otherwise
+         */
+        bool eliminateVariables();
+
+        /**
+         * Blocked clause elimination. A clause C is blocked on a literal l if all resolvents of C on l are
+         * tautologies. Blocked clauses are removed and pushed onto the reconstruction stack with l as witness.
+         * @return false if the formula was found to be unsatisfiable, true otherwise
+         */
+        bool eliminateBlocked();
+
+        /**
+         * Covered clause elimination. Extends each clause by covered literal addition (literals contained in all
+         * non-tautological resolution partners on some literal of the clause) and removes the clause if the extended
+         * clause is blocked. Each extension step is recorded on the reconstruction stack.
+         * @return false if the formula was found to be unsatisfiable, true otherwise
+         */
+        bool eliminateCovered();
+
+        /**
+         * Prevents a variable from being removed by the preprocessor
+         * @param x variable to freeze
+         */
+        void freeze(Variable x);
+
+        /**
+         * Whether the given variable was eliminated
+         * @param x a variable
+         * @return true if x does not occur in the simplified formula anymore due to elimination
+         */
+        bool isEliminated(Variable x) const;
+
+        /**
+         * Gets the simplified formula. Variables fixed during preprocessing are contained as unit clauses
+         * @return clauses of the simplified formula
+         */
+        auto getClauses() const -> std::vector<Clause>;
+
+        /**
+         * Loads the simplified formula into the solver and hands over the reconstruction stack such that
+         * Solver::val() yields a model of the original formula after a successful search. The clauses keep their proof
+         * identifiers, so a solver logging to the same proof continues it
+         * @param solver solver with the same number of variables as the preprocessor
+         * @return false if the solver detected an unsatisfiable formula while adding the clauses, true otherwise
+         */
+        bool transferTo(Solver &solver) const;
+
+        /**
+         * Gets the reconstruction stack
+         * @return stack of removed clauses
+         */
+        auto getReconstructionStack() const noexcept -> const ReconstructionStack &;
+
+        /**
+         * Number of variables of the formula including the auxiliary variables of the symmetry-breaking clauses
+         * @return number of variables
+         */
+        std::size_t getNumVariables() const noexcept;
+
+        /**
+         * Whether the formula was found to be unsatisfiable
+         * @return true if the formula is unsatisfiable, false if unknown
+         */
+        bool isUnsat() const noexcept;
+
+        /**
+         * Gets the preprocessing statistics
+         * @return statistics
+         */
+        auto getStatistics() const noexcept -> const PreprocessorStatistics &;
+    };
+}
+
+#endif //PREPROCESSOR_HPP
@@ -0,0 +1,180 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+#include "ProofWriter.hpp"
+#include "inout.hpp"
+
+namespace sat {
+    ProofWriter::ProofWriter(std::ostream &out, ProofFormat format, std::size_t bufferSize)
+        : out(out), format(format), bufferSize(bufferSize) {
+        buffer.reserve(bufferSize + 64);
+        pending.reserve(bufferSize + 64);
+        writer = std::thread([this] { run(); });
+    }
+
+    ProofWriter::~ProofWriter() {
+        flush();
+        {
+            std::lock_guard lock(mutex);
+            done = true;
+        }
+
+        condition.notify_all();
+        writer.join();
+    }
+
+    void ProofWriter::write(char type, const Clause &clause) {
+        if (format == ProofFormat::Binary) {
+            buffer.push_back(type);
+            for (Literal l: clause) {
+                auto value = 2 * (static_cast<std::uint64_t>(var(l).get()) + 1) + (l.sign() < 0);
+                while (value > 127) {
+                    buffer.push_back(static_cast<char>((value & 127) | 128));
+                    value >>= 7;
+                }
+
+                buffer.push_back(static_cast<char>(value));
+            }
+
+            buffer.push_back(0);
+        } else {
+            if (type == 'd') {
+                buffer.append("d ");
+            }
+
+            for (Literal l: clause) {
+                writeNumber(inout::to_dimacs(l));
+            }
+
+            buffer.append("0\n");
+        }
+
+        if (buffer.size() >= bufferSize) {
+            handOver();
+        }
+    }
+
+    void ProofWriter::writeNumber(std::int64_t number) {
+        char digits[24];
+        const auto end = std::to_chars(digits, digits + sizeof(digits), number).ptr;
+        buffer.append(digits, end);
+        buffer.push_back(' ');
+    }
+
+    void ProofWriter::writeLrat(const Clause &clause, const std::vector<ClauseId> &hints) {
+        writeNumber(static_cast<std::int64_t>(lastId));
+        for (Literal l: clause) {
+            writeNumber(inout::to_dimacs(l));
+        }
+
+        buffer.append("0 ");
+        for (auto hint: hints) {
+            writeNumber(static_cast<std::int64_t>(hint));
+        }
+
+        buffer.append("0\n");
+        if (buffer.size() >= bufferSize) {
+            handOver();
+        }
+    }
+
+    void ProofWriter::handOver() {
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [this] { return not hasPending; });
+        statistics.bytes += buffer.size();
+        std::swap(buffer, pending);
+        hasPending = true;
+        lock.unlock();
+        condition.notify_all();
+    }
+
+    void ProofWriter::run() {
+        std::unique_lock lock(mutex);
+        while (true) {
+            condition.wait(lock, [this] { return hasPending || done; });
+            if (not hasPending) {
+                return;
+            }
+
+            lock.unlock();
+            out.write(pending.data(), static_cast<std::streamsize>(pending.size()));
+            pending.clear();
+            lock.lock();
+            hasPending = false;
+            condition.notify_all();
+        }
+    }
+
+    ClauseId ProofWriter::addInput() {
+        if (derived && inputs >= reservedInputs && format == ProofFormat::Lrat) {
+            throw std::logic_error("Input clauses must be registered or reserved before the first lemma");
+        }
+
+        ++inputs;
+        lastId = std::max(lastId, inputs);
+        return inputs;
+    }
+
+    void ProofWriter::reserveInputs(ClauseId count) {
+        if (derived) {
+            throw std::logic_error("Input clauses must be reserved before the first lemma");
+        }
+
+        reservedInputs = count;
+        lastId = std::max(lastId, count);
+    }
+
+    ClauseId ProofWriter::addClause(const Clause &clause, const std::vector<ClauseId> &hints) {
+        ++statistics.additions;
+        derived = true;
+        ++lastId;
+        if (format == ProofFormat::Lrat) {
+            writeLrat(clause, hints);
+        } else {
+            write('a', clause);
+        }
+
+        return lastId;
+    }
+
+    void ProofWriter::deleteClause(const Clause &clause, ClauseId id) {
+        if (clause.size() <= 1) {
+            return;
+        }
+
+        ++statistics.deletions;
+        if (format == ProofFormat::Lrat) {
+            writeNumber(static_cast<std::int64_t>(lastId));
+            buffer.append("d ");
+            writeNumber(static_cast<std::int64_t>(id));
+            buffer.append("0\n");
+            if (buffer.size() >= bufferSize) {
+                handOver();
+            }
+        } else {
+            write('d', clause);
+        }
+    }
+
+    bool ProofWriter::needsHints() const noexcept {
+        return format == ProofFormat::Lrat;
+    }
+
+    void ProofWriter::flush() {
+        handOver();
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [this] { return not hasPending; });
+        out.flush();
+    }
+
+    auto ProofWriter::getStatistics() const noexcept -> const ProofStatistics & {
+        return statistics;
+    }
+}
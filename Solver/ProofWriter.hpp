@@ -0,0 +1,150 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @file ProofWriter.hpp
+* @brief Contains the DRAT / LRAT proof writer used to certify unsatisfiability results
+*/
+
+#ifndef PROOFWRITER_HPP
+#define PROOFWRITER_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Clause.hpp"
+#include "util/enum.hpp"
+
+namespace sat {
+    /**
+     * @brief Encoding of the proof (Text and Binary are DRAT encodings)
+     */
+    PENUM(ProofFormat, Text, Binary, Lrat)
+
+    /**
+     * Identifier of a clause in the proof. Input clauses are numbered from 1 in the order they are registered, derived
+     * clauses continue the numbering
+     */
+    using ClauseId = std::uint64_t;
+
+    /**
+     * @brief Statistics of the proof writer
+     */
+    struct ProofStatistics {
+        std::uint64_t additions = 0; ///< lemmas added to the proof
+        std::uint64_t deletions = 0; ///< clause deletions
+        std::uint64_t bytes = 0; ///< size of the proof
+    };
+
+    /**
+     * @brief Writes a DRAT proof (clause additions and deletions) in text or binary encoding or an LRAT proof.
+     * @details @copybrief
+     * Proof lines are appended to an in-memory buffer. Once the buffer is full, it is swapped with the buffer of a
+     * background thread that writes it to the output stream, so the solver only waits if the output is slower than
+     * proof generation. In the binary encoding, each line starts with 'a' or 'd' followed by the literals as variable
+     * length unsigned integers (2 * variable + sign) and a zero byte. Deletions of unit clauses are not written since
+     * proof checkers ignore them.
+     *
+     * LRAT lines carry clause identifiers: an addition "id literals 0 hints 0" lists the antecedents (hints) whose
+     * unit propagation refutes the negation of the lemma, in propagation order, and a deletion "id d ids 0" refers to
+     * the deleted clauses by their identifiers. This allows checking in linear time. Writers of LRAT proofs must
+     * provide the hints of every lemma (needsHints()) and the identifiers of deleted clauses.
+     */
+    class ProofWriter {
+        std::ostream &out;
+        ProofFormat format;
+        std::size_t bufferSize;
+        std::string buffer;
+        std::string pending;
+        bool hasPending = false;
+        bool done = false;
+        std::mutex mutex;
+        std::condition_variable condition;
+        ProofStatistics statistics;
+        std::thread writer;
+        ClauseId lastId = 0;
+        ClauseId inputs = 0;
+        ClauseId reservedInputs = 0;
+        bool derived = false;
+
+        void write(char type, const Clause &clause);
+        void writeLrat(const Clause &clause, const std::vector<ClauseId> &hints);
+        void writeNumber(std::int64_t number);
+        void handOver();
+        void run();
+
+    public:
+        /**
+         * Ctor. Starts the writer thread
+         * @param out output stream. Must outlive the writer
+         * @param format proof encoding
+         * @param bufferSize number of bytes collected before they are handed to the writer thread
+         */
+        ProofWriter(std::ostream &out, ProofFormat format, std::size_t bufferSize = 1 << 22);
+
+        /**
+         * Dtor. Writes all remaining proof lines and stops the writer thread
+         */
+        ~ProofWriter();
+
+        ProofWriter(const ProofWriter &) = delete;
+        ProofWriter &operator=(const ProofWriter &) = delete;
+
+        /**
+         * Registers the next clause of the input formula. Nothing is written, the identifier is needed to refer to
+         * the clause in LRAT proofs. All input clauses must be registered before the first lemma is added unless
+         * they were reserved using reserveInputs()
+         * @return identifier of the input clause
+         * @throws std::logic_error if a lemma was already added to an LRAT proof and the input was not reserved
+         */
+        ClauseId addInput();
+
+        /**
+         * Announces the number of input clauses. Lemma identifiers start after the reserved range, so lemmas can be
+         * added while the input clauses are still being registered (e.g. a solver propagating root level units
+         * while clauses are added)
+         * @param count number of clauses of the input formula
+         * @throws std::logic_error if a lemma was already added
+         */
+        void reserveInputs(ClauseId count);
+
+        /**
+         * Adds a lemma to the proof. Lemmas must be RUP (or RAT on their first literal) with respect to the clauses
+         * added before and not yet deleted
+         * @param clause lemma (empty clause to conclude the proof)
+         * @param hints antecedents of the lemma in unit propagation order (only used by LRAT)
+         * @return identifier of the lemma
+         */
+        ClauseId addClause(const Clause &clause, const std::vector<ClauseId> &hints = {});
+
+        /**
+         * Deletes a clause from the proof
+         * @param clause clause to delete
+         * @param id identifier of the clause (only used by LRAT)
+         */
+        void deleteClause(const Clause &clause, ClauseId id = 0);
+
+        /**
+         * Whether lemmas must be added together with their antecedents
+         * @return true if the proof format is LRAT
+         */
+        bool needsHints() const noexcept;
+
+        /**
+         * Writes all proof lines collected so far and flushes the output stream
+         */
+        void flush();
+
+        /**
+         * Gets the statistics
+         * @return proof statistics
+         */
+        auto getStatistics() const noexcept -> const ProofStatistics &;
+    };
+}
+
+#endif //PROOFWRITER_HPP
@@ -0,0 +1,43 @@
+/**
+* @author Tim Luchterhand
+* @date 18.10.26
+* @brief
+*/
+
+#include <cassert>
+#include <algorithm>
+#include <ranges>
+
+#include "ReconstructionStack.hpp"
+
+namespace sat {
+    void ReconstructionStack::push(Literal witness, Clause clause) {
+        assert(std::ranges::find(clause, witness) != clause.end());
+        entries.emplace_back(witness, std::move(clause));
+    }
+
+    void ReconstructionStack::extend(std::vector<TruthValue> &model) const {
+        auto holds = [&model](Literal l) {
+            const auto value = model[var(l).get()];
+            return value != TruthValue::Undefined && (value == TruthValue::True) == (l.sign() > 0);
+        };
+
+        for (const auto &[witness, clause]: entries | std::views::reverse) {
+            if (std::ranges::none_of(clause, holds)) {
+                model[var(witness).get()] = witness.sign() > 0 ? TruthValue::True : TruthValue::False;
+            }
+        }
+    }
+
+    std::size_t ReconstructionStack::size() const noexcept {
+        return entries.size();
+    }
+
+    bool ReconstructionStack::empty() const noexcept {
+        return entries.empty();
+    }
+
+    void ReconstructionStack::append(const ReconstructionStack &other) {
+        entries.insert(entries.end(), other.entries.begin(), other.entries.end());
+    }
+}
@@ -0,0 +1,82 @@
+/**
+* @author Tim Luchterhand
+* @date 18.10.26
+* @file ReconstructionStack.hpp
+* @brief Contains the stack used to extend models of a simplified formula to models of the original formula
+*/
+
+#ifndef RECONSTRUCTIONSTACK_HPP
+#define RECONSTRUCTIONSTACK_HPP
+
+#include <vector>
+
+#include "basic_structures.hpp"
+#include "Clause.hpp"
+
+namespace sat {
+
+    /**
+     * @brief Records clauses removed by simplification techniques that do not preserve equivalence (e.g. variable
+     * elimination).
+     * @details @copybrief
+     * Each entry consists of a removed clause and a witness literal contained in that clause. A model of the
+     * simplified formula is extended by traversing the entries in reverse order and flipping the witness of every
+     * clause that is not satisfied.
+     */
+    class ReconstructionStack {
+    public:
+        /**
+         * @brief Entry on the reconstruction stack
+         */
+        struct Entry {
+            Literal witness; ///< literal that is set to true if the clause is falsified
+            Clause clause; ///< removed clause (contains the witness)
+        };
+
+        /**
+         * Pushes a removed clause onto the stack
+         * @param witness witness literal (must be contained in the clause)
+         * @param clause the removed clause
+         */
+        void push(Literal witness, Clause clause);
+
+        /**
+         * Extends the given model such that all clauses on the stack are satisfied. Unassigned variables are treated
+         * as false
+         * @param model model of the simplified formula. Is modified in place
+         */
+        void extend(std::vector<TruthValue> &model) const;
+
+        /**
+         * Number of entries on the stack
+         * @return stack size
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * Whether the stack is empty
+         * @return true if no clause was recorded, false otherwise
+         */
+        bool empty() const noexcept;
+
+        /**
+         * Appends all entries of another stack. The entries of other are processed before the entries of this stack
+         * during reconstruction
+         * @param other stack to append
+         */
+        void append(const ReconstructionStack &other);
+
+        auto begin() const noexcept {
+            return entries.begin();
+        }
+
+        auto end() const noexcept {
+            return entries.end();
+        }
+
+    private:
+        std::vector<Entry> entries;
+    };
+}
+
+#endif //RECONSTRUCTIONSTACK_HPP
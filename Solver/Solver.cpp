@@ -4,39 +4,185 @@
 * @brief
 */
 
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
 #include "Solver.hpp"
+#include "BitParallelSolver.hpp"
+#include "CardinalityConstraints.hpp"
+#include "LocalSearch.hpp"
+#include "Preprocessor.hpp"
 #include "util/exception.hpp"
 
 namespace sat {
-    Solver::Solver(unsigned numVariables) {
-        this->numVariables = numVariables;
-        model.resize(numVariables, TruthValue::Undefined);
+    namespace {
+        /**
+         * Computes the luby sequence 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ...
+         * @param y base of the sequence
+         * @param x index in the sequence
+         * @return x-th element of the sequence
+         */
+        double luby(double y, unsigned x) {
+            unsigned size = 1;
+            unsigned seq = 0;
+            while (size < x + 1) {
+                ++seq;
+                size = 2 * size + 1;
+            }
+
+            while (size - 1 != x) {
+                size = (size - 1) >> 1;
+                --seq;
+                x = x % size;
+            }
+
+            double ret = 1;
+            for (unsigned i = 0; i < seq; ++i) {
+                ret *= y;
+            }
+
+            return ret;
+        }
+
+        constexpr unsigned abstractLevel(unsigned level) noexcept {
+            return 1u << (level & 31u);
+        }
+    }
+
+    Solver::Solver(unsigned numVariables) : Solver(numVariables, SolverConfig{}) {}
+
+    Solver::Solver(unsigned numVariables, const SolverConfig &config)
+        : numVariables(numVariables), config(config), model(numVariables, TruthValue::Undefined),
+          watches(2 * static_cast<std::size_t>(numVariables)), levels(numVariables, 0),
+          reasons(numVariables, nullptr), phases(numVariables, TruthValue::False), seen(numVariables, 0),
+          levelStamps(numVariables + 1, 0), heuristic(numVariables, config.variableDecay),
+          nextReduce(config.reduceInterval), subsumption(numVariables), dominators(numVariables, Literal(0)),
+          depths(numVariables, 0), probeStamps(2 * static_cast<std::size_t>(numVariables), 0),
+          nextLocalSearch(config.localSearchInterval), localSearchBudget(config.localSearchFlips),
+          eliminated(numVariables, 0), frozen(numVariables, 0), rng(config.seed), unitIds(numVariables, 0) {
+        if (config.initialPhase != TruthValue::False) {
+            for (auto &phase: phases) {
+                phase = initialPhase();
+            }
+        }
+
+        if (config.seed != 0) {
+            std::uniform_real_distribution<double> noise(0, 1);
+            for (unsigned x = 0; x < numVariables; ++x) {
+                heuristic.bump(x, noise(rng));
+            }
+        }
     }
 
     bool Solver::addClause(Clause clause) {
+        if (std::ranges::any_of(clause, [this](Literal l) { return eliminated[var(l).get()]; })) {
+            throw std::invalid_argument("Clause contains an eliminated variable");
+        }
+
+        return addIrredundant(std::move(clause), proof != nullptr ? proof->addInput() : 0);
+    }
+
+    bool Solver::addIrredundant(Clause clause, ClauseId id) {
+        if (decisionLevel() > 0) {
+            backtrack(0);
+        }
+
+        std::ranges::sort(clause, {}, [](Literal l) { return l.get(); });
+        const auto [first, last] = std::ranges::unique(clause);
+        clause.erase(first, last);
+        for (std::size_t i = 1; i < clause.size(); ++i) {
+            if (clause[i] == clause[i - 1].negate()) {
+                return true; // tautologies are always satisfied
+            }
+        }
+
         if (clause.empty()) {
+            unsat = true;
             return false;
         }
 
         if (clause.size() == 1) {
             Literal unitLiteral = clause[0];
+            const auto &stored = clauses.emplace_back(std::make_shared<StoredClause>(StoredClause{
+                .literals = std::move(clause), .id = id}));
+            if (value(unitLiteral) == TruthValue::Undefined) {
+                unitIds[var(unitLiteral).get()] = id;
+            }
+
             if (!assign(unitLiteral)) {
+                logRefutation(*stored);
+                unsat = true;
                 return false; // La clause unitaire viole le modèle actuel
             }
+
+            return true;
+        }
+
+        const auto sig = signature(clause);
+        subsumption.mark(clause);
+        for (auto [it, end] = originalLookup.equal_range(sig); it != end; ++it) {
+            const auto &other = it->second->literals;
+            if (other.size() == clause.size() && subsumption.check(other).first == SubsumptionChecker::Result::Subsumes) {
+                ++statistics.duplicateClauses;
+                return true;
+            }
+        }
+
+        auto stored = std::make_shared<StoredClause>(StoredClause{.literals = std::move(clause), .id = id});
+        clauses.emplace_back(stored);
+        originalLookup.emplace(sig, stored.get());
+        if (!attachAtRoot(*stored)) {
+            logRefutation(*stored);
+            unsat = true;
+            return false;
         }
-        clauses.push_back(std::make_shared<Clause>(std::move(clause)));
+
         return true;
     }
 
+    Variable Solver::addVariable() {
+        const auto x = numVariables++;
+        model.emplace_back(TruthValue::Undefined);
+        watches.resize(2 * static_cast<std::size_t>(numVariables));
+        levels.emplace_back(0);
+        reasons.emplace_back(nullptr);
+        phases.emplace_back(initialPhase());
+        seen.emplace_back(0);
+        levelStamps.emplace_back(0);
+        heuristic.addVariable();
+        subsumption.addVariable();
+        dominators.emplace_back(0);
+        depths.emplace_back(0);
+        probeStamps.resize(2 * static_cast<std::size_t>(numVariables), 0);
+        eliminated.emplace_back(0);
+        frozen.emplace_back(0);
+        unitIds.emplace_back(0);
+        if (!cardinalityOccurrences.empty()) {
+            cardinalityOccurrences.resize(2 * static_cast<std::size_t>(numVariables));
+        }
+
+        return x;
+    }
+
+    void Solver::freeze(Variable x) {
+        frozen[x.get()] = 1;
+    }
+
     auto Solver::rebase() const -> std::vector<Clause> {
         std::vector<Clause> reducedClauses;
         std::vector<Clause> unitClauses; // Pour stocker les clauses unitaires sans doublons
 
-        for (const auto& clausePtr : clauses) {
+        std::vector<StoredClausePointer> all(clauses);
+        all.insert(all.end(), xorClauses.begin(), xorClauses.end());
+        all.insert(all.end(), cardinalityClauses.begin(), cardinalityClauses.end());
+        for (const auto& clausePtr : all) {
             std::vector<Literal> satisfyingLiterals;
             Clause reducedClause;
 
-            for (const auto& literal : *clausePtr) {
+            for (const auto& literal : clausePtr->literals) {
                 if (satisfied(literal)) {
                     satisfyingLiterals.push_back(literal);
                 } else if (!falsified(literal)) {
@@ -75,64 +221,1833 @@ namespace sat {
     bool Solver::satisfied(Literal l) const {
         Variable var = sat::var(l);
         TruthValue value = val(var);
-        return (l.sign() == 1 && value == TruthValue::True) || 
+        return (l.sign() == 1 && value == TruthValue::True) ||
                 (l.sign() == -1 && value == TruthValue::False);
     }
 
     bool Solver::falsified(Literal l) const {
         Variable var = sat::var(l);
         TruthValue value = val(var);
-        return (l.sign() == 1 && value == TruthValue::False) || 
+        return (l.sign() == 1 && value == TruthValue::False) ||
                 (l.sign() == -1 && value == TruthValue::True);
     }
 
     bool Solver::assign(Literal l) {
-        Variable var = sat::var(l);
-        TruthValue value = val(var);
-        unsigned varIndex = var.get();
-
-        if (value != TruthValue::Undefined){
+        if (val(var(l)) != TruthValue::Undefined){
             return satisfied(l);
         }
 
-        model[varIndex] = l.sign() == 1 ? TruthValue::True : TruthValue::False;
+        enqueue(l, nullptr);
         return true;
     }
 
     bool Solver::unitPropagate() {
-        bool changed = true;
-        while (changed) {
-            changed = false;
-            for (const auto& clausePtr : clauses) {
-                int undefinedCount = 0;
-                Literal unitLiteral = 0;
-                bool clauseSatisfied = false;
-                for (const Literal& lit : *clausePtr) {
-                    if (satisfied(lit)) {
-                        clauseSatisfied = true; // Clause satisfaite, passe à la suivante
+        if (unsat) {
+            return false;
+        }
+
+        conflict = nullptr;
+        // XOR constraints are only propagated once the clauses reach a fixpoint, at-most-k constraints eagerly
+        while (propagationHead < trail.size() || (conflict == nullptr && propagateXors())) {
+            if (!propagateCardinalities()) {
+                propagationHead = trail.size();
+                break;
+            }
+
+            const Literal falseLit = trail[propagationHead++].negate();
+            auto &watchList = watches[falseLit.get()];
+            ++statistics.propagations;
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < watchList.size()) {
+                const Watcher w = watchList[i++];
+                if (value(w.blocker) == TruthValue::True) {
+                    watchList[j++] = w;
+                    continue;
+                }
+
+                auto &lits = w.clause->literals;
+                if (lits[0] == falseLit) {
+                    std::swap(lits[0], lits[1]);
+                }
+
+                const Literal first = lits[0];
+                const Watcher newWatcher{w.clause, first};
+                if (first != w.blocker && value(first) == TruthValue::True) {
+                    watchList[j++] = newWatcher;
+                    continue;
+                }
+
+                bool foundWatch = false;
+                for (std::size_t k = 2; k < lits.size(); ++k) {
+                    if (value(lits[k]) != TruthValue::False) {
+                        std::swap(lits[1], lits[k]);
+                        watches[lits[1].get()].emplace_back(newWatcher);
+                        foundWatch = true;
                         break;
                     }
-                    if (!falsified(lit)) {
-                        ++undefinedCount;
-                        unitLiteral = lit;
+                }
+
+                if (foundWatch) {
+                    continue;
+                }
+
+                watchList[j++] = newWatcher;
+                if (value(first) == TruthValue::False) {
+                    conflict = w.clause;
+                    propagationHead = trail.size();
+                    while (i < watchList.size()) {
+                        watchList[j++] = watchList[i++];
                     }
+                } else {
+                    enqueue(first, w.clause);
                 }
-                if (clauseSatisfied) {
-                    continue; // Clause déjà satisfaite, pas besoin de la traiter
+            }
+
+            watchList.erase(watchList.begin() + static_cast<std::ptrdiff_t>(j), watchList.end());
+        }
+
+        return conflict == nullptr;
+    }
+
+    TruthValue Solver::value(Literal l) const noexcept {
+        const auto v = to_underlying(model[l.get() >> 1]);
+        return static_cast<TruthValue>(l.sign() > 0 ? v : -v);
+    }
+
+    TruthValue Solver::initialPhase() {
+        if (config.initialPhase != TruthValue::Undefined) {
+            return config.initialPhase;
+        }
+
+        return std::bernoulli_distribution{}(rng) ? TruthValue::True : TruthValue::False;
+    }
+
+    void Solver::attach(StoredClause &clause) {
+        assert(clause.literals.size() >= 2);
+        const auto &lits = clause.literals;
+        watches[lits[0].get()].emplace_back(&clause, lits[1]);
+        watches[lits[1].get()].emplace_back(&clause, lits[0]);
+    }
+
+    bool Solver::attachAtRoot(StoredClause &clause) {
+        assert(decisionLevel() == 0);
+        auto &lits = clause.literals;
+        std::ranges::stable_partition(lits, [this](Literal l) { return value(l) != TruthValue::False; });
+        if (value(lits[0]) == TruthValue::False) {
+            return false;
+        }
+
+        attach(clause);
+        if (value(lits[1]) == TruthValue::False && value(lits[0]) == TruthValue::Undefined) {
+            enqueue(lits[0], &clause);
+        }
+
+        return true;
+    }
+
+    void Solver::detach(const StoredClause &clause) {
+        for (unsigned i = 0; i < 2; ++i) {
+            auto &watchList = watches[clause.literals[i].get()];
+            std::erase_if(watchList, [&clause](const Watcher &w) { return w.clause == &clause; });
+        }
+    }
+
+    ClauseId Solver::logAddition(const Clause &clause) {
+        return proof != nullptr ? proof->addClause(clause, hints) : 0;
+    }
+
+    void Solver::logDeletion(const StoredClause &clause) {
+        if (proof != nullptr) {
+            // the implied literal of a reason clause stays available to the proof checker (LRAT proofs contain the
+            // unit clauses of all root level literals anyway)
+            if (!lrat && locked(clause)) {
+                proof->addClause({clause.literals[0]});
+            }
+
+            proof->deleteClause(clause.literals, clause.id);
+        }
+    }
+
+    void Solver::logRefutation(const StoredClause &falsified) {
+        if (proof != nullptr) {
+            if (lrat) {
+                collectHints(falsified.literals, falsified.id, {}, trail.size());
+            }
+
+            proof->addClause({}, hints);
+        }
+    }
+
+    void Solver::collectHints(const Clause &falsified, ClauseId id, const Clause &lemma, std::size_t end) {
+        // the lemma is assumed false and the falsified clause is explained by the reasons of its literals in trail
+        // order. Literals on the root level are explained by their unit clauses, which are listed first
+        hints.clear();
+        hintChain.clear();
+        hintMarked.clear();
+        for (Literal l: lemma) {
+            seen[var(l).get()] = 2;
+            hintMarked.emplace_back(var(l).get());
+        }
+
+        std::size_t pending = 0;
+        const auto visit = [&](Literal q) {
+            const auto x = var(q).get();
+            if (seen[x]) {
+                return;
+            }
+
+            seen[x] = 1;
+            hintMarked.emplace_back(x);
+            if (levels[x] == 0) {
+                assert(unitIds[x] != 0);
+                hints.emplace_back(unitIds[x]);
+            } else {
+                ++pending;
+            }
+        };
+
+        for (Literal q: falsified) {
+            visit(q);
+        }
+
+        for (auto i = end; pending > 0; --i) {
+            const auto x = var(trail[i - 1]).get();
+            if (seen[x] != 1 || levels[x] == 0) {
+                continue;
+            }
+
+            --pending;
+            const auto *reason = reasons[x];
+            assert(reason != nullptr);
+            hintChain.emplace_back(reason->id);
+            for (Literal q: reason->literals) {
+                visit(q);
+            }
+        }
+
+        hints.insert(hints.end(), hintChain.rbegin(), hintChain.rend());
+        hints.emplace_back(id);
+        for (auto x: hintMarked) {
+            seen[x] = 0;
+        }
+    }
+
+    void Solver::deriveUnit(Literal l, const StoredClause &reason) {
+        hintChain.clear();
+        for (Literal q: reason.literals) {
+            if (q != l) {
+                hintChain.emplace_back(unitIds[var(q).get()]);
+            }
+        }
+
+        hintChain.emplace_back(reason.id);
+        unitIds[var(l).get()] = proof->addClause({l}, hintChain);
+    }
+
+    void Solver::enqueue(Literal l, StoredClause *reason) {
+        const auto x = var(l).get();
+        assert(model[x] == TruthValue::Undefined);
+        model[x] = l.sign() > 0 ? TruthValue::True : TruthValue::False;
+        levels[x] = decisionLevel();
+        reasons[x] = reason;
+        trail.emplace_back(l);
+        if (lrat && reason != nullptr && trailLimits.empty()) {
+            deriveUnit(l, *reason);
+        }
+    }
+
+    unsigned Solver::decisionLevel() const noexcept {
+        return static_cast<unsigned>(trailLimits.size());
+    }
+
+    void Solver::newDecisionLevel() {
+        trailLimits.emplace_back(trail.size());
+    }
+
+    void Solver::backtrack(unsigned level) {
+        if (decisionLevel() <= level) {
+            return;
+        }
+
+        const auto limit = trailLimits[level];
+        for (auto i = std::min(cardinalityHead, trail.size()); i > limit; --i) {
+            for (auto c: cardinalityOccurrences[trail[i - 1].get()]) {
+                --cardinalityCounts[c];
+            }
+        }
+
+        cardinalityHead = std::min(cardinalityHead, limit);
+        if (gauss.has_value()) {
+            for (auto i = std::min(xorHead, trail.size()); i > limit; --i) {
+                gauss->unassign(var(trail[i - 1]));
+            }
+        }
+
+        for (auto i = trail.size(); i > limit; --i) {
+            const auto x = var(trail[i - 1]).get();
+            phases[x] = model[x];
+            model[x] = TruthValue::Undefined;
+            reasons[x] = nullptr;
+            heuristic.insert(x);
+        }
+
+        trail.erase(trail.begin() + static_cast<std::ptrdiff_t>(limit), trail.end());
+        trailLimits.resize(level);
+        propagationHead = trail.size();
+        xorHead = std::min(xorHead, trail.size());
+        while (!lazyReasons.empty() && value(lazyReasons.back()->literals[0]) == TruthValue::Undefined) {
+            lazyReasons.pop_back();
+        }
+    }
+
+    bool Solver::locked(const StoredClause &clause) const {
+        const Literal first = clause.literals[0];
+        return satisfied(first) && reasons[var(first).get()] == &clause;
+    }
+
+    void Solver::bumpClause(StoredClause &clause) {
+        if ((clause.activity += clauseIncrement) > 1e20f) {
+            for (auto &c: learnts) {
+                c->activity *= 1e-20f;
+            }
+
+            clauseIncrement *= 1e-20f;
+        }
+    }
+
+    unsigned Solver::computeLBD(const Clause &clause) {
+        ++stamp;
+        unsigned lbd = 0;
+        for (Literal l: clause) {
+            const auto level = levels[var(l).get()];
+            if (levelStamps[level] != stamp) {
+                levelStamps[level] = stamp;
+                ++lbd;
+            }
+        }
+
+        return lbd;
+    }
+
+    bool Solver::redundant(Literal l, unsigned abstractLevels, std::vector<Literal> &toClear) {
+        std::vector<Literal> stack{l};
+        const auto top = toClear.size();
+        while (!stack.empty()) {
+            const Literal current = stack.back();
+            stack.pop_back();
+            const auto *reason = reasons[var(current).get()];
+            assert(reason != nullptr);
+            for (std::size_t i = 1; i < reason->literals.size(); ++i) {
+                const Literal q = reason->literals[i];
+                const auto x = var(q).get();
+                if (seen[x] || levels[x] == 0) {
+                    continue;
                 }
-                if (undefinedCount == 0) {
-                    // Tous les littéraux sont falsifiés : conflit détecté
+
+                if (reasons[x] != nullptr && (abstractLevel(levels[x]) & abstractLevels) != 0) {
+                    seen[x] = 1;
+                    stack.emplace_back(q);
+                    toClear.emplace_back(q);
+                } else {
+                    for (auto k = top; k < toClear.size(); ++k) {
+                        seen[var(toClear[k]).get()] = 0;
+                    }
+
+                    toClear.erase(toClear.begin() + static_cast<std::ptrdiff_t>(top), toClear.end());
                     return false;
                 }
-                if (undefinedCount == 1) {
-                    // Clause unitaire détectée, assignation nécessaire
-                    if (!assign(unitLiteral)) {
-                        return false; // Propagation échoue
+            }
+        }
+
+        return true;
+    }
+
+    auto Solver::analyze() -> std::pair<Clause, unsigned> {
+        Clause learnt{Literal(0)};
+        unsigned pathCount = 0;
+        auto index = trail.size();
+        StoredClause *reason = conflict;
+        Literal p = 0;
+        bool first = true;
+        do {
+            assert(reason != nullptr);
+            if (reason->learned) {
+                bumpClause(*reason);
+            }
+
+            for (std::size_t i = first ? 0 : 1; i < reason->literals.size(); ++i) {
+                const Literal q = reason->literals[i];
+                const auto x = var(q).get();
+                if (!seen[x] && levels[x] > 0) {
+                    heuristic.bump(x);
+                    seen[x] = 1;
+                    if (levels[x] >= decisionLevel()) {
+                        ++pathCount;
+                    } else {
+                        learnt.emplace_back(q);
+                    }
+                }
+            }
+
+            while (!seen[var(trail[--index]).get()]) {}
+            p = trail[index];
+            reason = reasons[var(p).get()];
+            seen[var(p).get()] = 0;
+            --pathCount;
+            first = false;
+        } while (pathCount > 0);
+
+        learnt[0] = p.negate();
+
+        // recursive conflict clause minimization
+        std::vector<Literal> toClear(learnt.begin(), learnt.end());
+        unsigned abstractLevels = 0;
+        for (std::size_t i = 1; i < learnt.size(); ++i) {
+            abstractLevels |= abstractLevel(levels[var(learnt[i]).get()]);
+        }
+
+        std::size_t j = 1;
+        for (std::size_t i = 1; i < learnt.size(); ++i) {
+            if (reasons[var(learnt[i]).get()] == nullptr || !redundant(learnt[i], abstractLevels, toClear)) {
+                learnt[j++] = learnt[i];
+            }
+        }
+
+        learnt.erase(learnt.begin() + static_cast<std::ptrdiff_t>(j), learnt.end());
+        for (Literal l: toClear) {
+            seen[var(l).get()] = 0;
+        }
+
+        unsigned backtrackLevel = 0;
+        if (learnt.size() > 1) {
+            std::size_t maxIdx = 1;
+            for (std::size_t i = 2; i < learnt.size(); ++i) {
+                if (levels[var(learnt[i]).get()] > levels[var(learnt[maxIdx]).get()]) {
+                    maxIdx = i;
+                }
+            }
+
+            std::swap(learnt[1], learnt[maxIdx]);
+            backtrackLevel = levels[var(learnt[1]).get()];
+        }
+
+        return {std::move(learnt), backtrackLevel};
+    }
+
+    void Solver::analyzeFinal(Literal assumption) {
+        failedAssumptions.assign({assumption});
+        if (decisionLevel() == 0) {
+            return;
+        }
+
+        // the negation of the assumption was propagated: collect the assumptions (decisions) it depends on
+        seen[var(assumption).get()] = 1;
+        for (auto i = trail.size(); i > trailLimits.front(); --i) {
+            const auto x = var(trail[i - 1]).get();
+            if (!seen[x]) {
+                continue;
+            }
+
+            if (const auto *reason = reasons[x]; reason == nullptr) {
+                assert(levels[x] > 0);
+                failedAssumptions.emplace_back(trail[i - 1]);
+            } else {
+                for (std::size_t k = 1; k < reason->literals.size(); ++k) {
+                    const auto y = var(reason->literals[k]).get();
+                    if (levels[y] > 0) {
+                        seen[y] = 1;
                     }
-                    changed = true;
                 }
             }
+
+            seen[x] = 0;
         }
-        return true;
+
+        seen[var(assumption).get()] = 0;
+    }
+
+    void Solver::learn(Clause clause, unsigned lbd) {
+        ++statistics.learnedClauses;
+        const auto id = logAddition(clause);
+        if (clause.size() == 1) {
+            enqueue(clause[0], nullptr);
+            unitIds[var(clause[0]).get()] = id;
+            return;
+        }
+
+        if (sharing != nullptr) {
+            ++statistics.exportedClauses;
+            sharing->exportClause(clause, lbd);
+        }
+
+        auto stored = std::make_shared<StoredClause>(StoredClause{
+            .literals = std::move(clause), .learned = true, .lbd = lbd, .id = id});
+        attach(*stored);
+        bumpClause(*stored);
+        enqueue(stored->literals[0], stored.get());
+        learnts.emplace_back(std::move(stored));
+    }
+
+    void Solver::reduceLearned() {
+        std::ranges::sort(learnts, [](const auto &a, const auto &b) {
+            return a->lbd < b->lbd || (a->lbd == b->lbd && a->activity > b->activity);
+        });
+
+        const auto keep = learnts.size() / 2;
+        for (std::size_t i = keep; i < learnts.size(); ++i) {
+            auto &clause = *learnts[i];
+            if (clause.lbd > config.glueLimit && clause.literals.size() > 2 && !locked(clause)) {
+                logDeletion(clause);
+                clause.deleted = true;
+                ++statistics.deletedClauses;
+            }
+        }
+
+        for (auto &watchList: watches) {
+            std::erase_if(watchList, [](const Watcher &w) { return w.clause->deleted; });
+        }
+
+        std::erase_if(learnts, [](const auto &c) { return c->deleted; });
+    }
+
+    void Solver::simplify() {
+        assert(decisionLevel() == 0);
+        if (trail.size() == rootUnitsAtSimplify) {
+            return;
+        }
+
+        rootUnitsAtSimplify = trail.size();
+        auto removeSatisfied = [this](std::vector<StoredClausePointer> &db) {
+            for (auto &clause: db) {
+                if (std::ranges::any_of(clause->literals, [this](Literal l) { return satisfied(l); })) {
+                    logDeletion(*clause);
+                    if (locked(*clause)) {
+                        reasons[var(clause->literals[0]).get()] = nullptr;
+                    }
+
+                    clause->deleted = true;
+                }
+            }
+        };
+
+        removeSatisfied(clauses);
+        removeSatisfied(learnts);
+        for (auto &watchList: watches) {
+            std::erase_if(watchList, [](const Watcher &w) { return w.clause->deleted; });
+        }
+
+        std::erase_if(originalLookup, [](const auto &entry) { return entry.second->deleted; });
+
+        std::erase_if(clauses, [](const auto &c) { return c->deleted; });
+        std::erase_if(learnts, [](const auto &c) { return c->deleted; });
+    }
+
+    void Solver::subsumeLearned() {
+        using enum SubsumptionChecker::Result;
+        assert(decisionLevel() == 0);
+        std::vector<StoredClause *> order;
+        order.reserve(learnts.size());
+        for (const auto &clause: learnts) {
+            if (!locked(*clause)) {
+                order.emplace_back(clause.get());
+            }
+        }
+
+        std::ranges::stable_sort(order, {}, [](const auto *c) { return c->literals.size(); });
+        std::vector<std::uint64_t> signatures;
+        signatures.reserve(order.size());
+        std::vector<std::vector<std::size_t>> oneWatch(watches.size());
+        std::vector<ClauseId> strengthening;
+        for (std::size_t idx = 0; idx < order.size() && !unsat; ++idx) {
+            auto &clause = *order[idx];
+            bool strengthened = false;
+            Clause original;
+            strengthening.clear();
+            signatures.emplace_back(signature(clause.literals));
+            bool changed = true;
+            while (changed && !clause.deleted) {
+                changed = false;
+                subsumption.mark(clause.literals);
+                for (std::size_t k = 0; k < clause.literals.size() && !changed && !clause.deleted; ++k) {
+                    const Literal l = clause.literals[k];
+                    for (Literal w: {l, l.negate()}) {
+                        for (auto candidate: oneWatch[w.get()]) {
+                            const auto &other = order[candidate]->literals;
+                            if (order[candidate]->deleted || other.size() > clause.literals.size() ||
+                                (signatures[candidate] & ~signatures[idx]) != 0) {
+                                continue;
+                            }
+
+                            const auto [result, removable] = subsumption.check(other);
+                            if (result == Subsumes) {
+                                if (proof != nullptr) {
+                                    proof->deleteClause(strengthened ? original : clause.literals, clause.id);
+                                }
+
+                                clause.deleted = true;
+                                ++statistics.subsumedClauses;
+                                break;
+                            }
+
+                            if (result == Strengthens) {
+                                if (!strengthened) {
+                                    detach(clause);
+                                    strengthened = true;
+                                    if (proof != nullptr) {
+                                        original = clause.literals;
+                                    }
+                                }
+
+                                std::erase(clause.literals, removable);
+                                strengthening.emplace_back(order[candidate]->id);
+                                signatures[idx] = signature(clause.literals);
+                                ++statistics.strengthenedClauses;
+                                changed = true;
+                                break;
+                            }
+                        }
+
+                        if (changed || clause.deleted) {
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if (clause.deleted) {
+                continue;
+            }
+
+            if (strengthened) {
+                if (lrat) {
+                    // each self-subsuming resolution step resolves with one of the strengthening clauses
+                    hints.assign(strengthening.rbegin(), strengthening.rend());
+                    hints.emplace_back(clause.id);
+                }
+
+                const auto id = logAddition(clause.literals);
+                if (proof != nullptr) {
+                    proof->deleteClause(original, clause.id);
+                }
+
+                clause.id = id;
+                clause.lbd = std::min(clause.lbd, static_cast<unsigned>(clause.literals.size()));
+                if (clause.literals.size() == 1) {
+                    const Literal unit = clause.literals.front();
+                    if (value(unit) == TruthValue::False) {
+                        logRefutation(clause);
+                        unsat = true;
+                    } else if (value(unit) == TruthValue::Undefined) {
+                        enqueue(unit, nullptr);
+                        unitIds[var(unit).get()] = id;
+                    }
+
+                    clause.deleted = true;
+                    continue;
+                }
+
+                if (!attachAtRoot(clause)) {
+                    logRefutation(clause);
+                    unsat = true;
+                    continue;
+                }
+            }
+
+            const Literal watch = *std::ranges::min_element(clause.literals, {}, [&oneWatch](Literal l) {
+                return oneWatch[l.get()].size();
+            });
+
+            oneWatch[watch.get()].emplace_back(idx);
+        }
+
+        for (auto &watchList: watches) {
+            std::erase_if(watchList, [](const Watcher &w) { return w.clause->deleted; });
+        }
+
+        std::erase_if(learnts, [](const auto &c) { return c->deleted; });
+    }
+
+    void Solver::vivifyLearned(Clock::time_point deadline) {
+        assert(decisionLevel() == 0);
+        if (!unitPropagate()) {
+            logRefutation(*conflict);
+            unsat = true;
+            return;
+        }
+
+        std::vector<StoredClause *> candidates;
+        for (const auto &clause: learnts) {
+            if (!clause->vivified && clause->literals.size() > 2) {
+                candidates.emplace_back(clause.get());
+            }
+        }
+
+        // clauses most likely to survive the next reductions first
+        std::ranges::sort(candidates, [](const auto *a, const auto *b) {
+            return a->lbd < b->lbd || (a->lbd == b->lbd && a->activity > b->activity);
+        });
+
+        const auto savedPhases = phases;
+        Clause kept;
+        for (std::size_t count = 0; count < candidates.size() && !unsat; ++count) {
+            if (count % 8 == 7 && Clock::now() >= deadline) {
+                break;
+            }
+
+            auto *clause = candidates[count];
+            if (locked(*clause)) {
+                continue;
+            }
+
+            // the clause must not take part in the propagation of its own negated literals
+            clause->vivified = true;
+            detach(*clause);
+            kept.clear();
+            bool conflicting = false;
+            for (Literal l: clause->literals) {
+                const auto v = value(l);
+                if (v == TruthValue::False) {
+                    continue; // implied by the negation of the literals before
+                }
+
+                kept.emplace_back(l);
+                if (v == TruthValue::True) {
+                    break;
+                }
+
+                newDecisionLevel();
+                enqueue(l.negate(), nullptr);
+                if (!unitPropagate()) {
+                    conflicting = true;
+                    break;
+                }
+            }
+
+            const bool shrunk = kept.size() < clause->literals.size();
+            if (shrunk && lrat) {
+                // the shortened clause is implied by the conflict, by the reason of its last (true) literal or by the
+                // clause itself if only falsified literals were dropped
+                const auto x = var(kept.back()).get();
+                if (conflicting) {
+                    collectHints(conflict->literals, conflict->id, kept, trail.size());
+                } else if (value(kept.back()) == TruthValue::True && levels[x] == 0) {
+                    collectHints({kept.back()}, unitIds[x], kept, trail.size());
+                } else if (value(kept.back()) == TruthValue::True) {
+                    collectHints(reasons[x]->literals, reasons[x]->id, kept, trail.size());
+                } else {
+                    collectHints(clause->literals, clause->id, kept, trail.size());
+                }
+            }
+
+            backtrack(0);
+            if (shrunk) {
+                ++statistics.vivifiedClauses;
+                statistics.vivifiedLiterals += clause->literals.size() - kept.size();
+                const auto id = logAddition(kept);
+                if (proof != nullptr) {
+                    proof->deleteClause(clause->literals, clause->id);
+                }
+
+                clause->id = id;
+                clause->literals.assign(kept.begin(), kept.end());
+                clause->lbd = std::min(clause->lbd, static_cast<unsigned>(kept.size()));
+            }
+
+            if (kept.size() == 1) {
+                clause->deleted = true;
+                if (value(kept.front()) == TruthValue::Undefined) {
+                    enqueue(kept.front(), nullptr);
+                    unitIds[var(kept.front()).get()] = clause->id;
+                }
+
+                if (!unitPropagate()) {
+                    logRefutation(*conflict);
+                    unsat = true;
+                }
+            } else if (!attachAtRoot(*clause)) {
+                logRefutation(*clause);
+                unsat = true;
+            } else if (!unitPropagate()) {
+                logRefutation(*conflict);
+                unsat = true;
+            }
+        }
+
+        phases = savedPhases;
+        std::erase_if(learnts, [](const auto &c) { return c->deleted; });
+    }
+
+    std::size_t Solver::countBinaries() const {
+        std::size_t count = 0;
+        for (const auto &watchList: watches) {
+            count += static_cast<std::size_t>(std::ranges::count_if(watchList, [](const Watcher &w) {
+                return w.clause->literals.size() == 2;
+            }));
+        }
+
+        return count / 2;
+    }
+
+    void Solver::fillProbeQueue() {
+        std::vector<char> inBinary(watches.size(), 0);
+        for (std::size_t l = 0; l < watches.size(); ++l) {
+            inBinary[l] = std::ranges::any_of(watches[l], [](const Watcher &w) {
+                return w.clause->literals.size() == 2;
+            });
+        }
+
+        // the queue is processed from the back: roots of the binary implication graph (literals that do not occur in
+        // binary clauses but whose negation does) are probed first, then all other literals with binary implications
+        probeQueue.clear();
+        for (bool roots: {false, true}) {
+            for (std::size_t idx = 0; idx < watches.size(); ++idx) {
+                const Literal l(static_cast<unsigned>(idx));
+                const bool hasImplications = inBinary[l.negate().get()];
+                if (hasImplications && value(l) == TruthValue::Undefined && roots == !inBinary[idx]) {
+                    probeQueue.emplace_back(l);
+                }
+            }
+        }
+
+        ++probeRound;
+    }
+
+    Literal Solver::dominator(Literal a, Literal b) const {
+        while (a != b) {
+            if (depths[var(a).get()] > depths[var(b).get()]) {
+                a = dominators[var(a).get()];
+            } else {
+                b = dominators[var(b).get()];
+            }
+        }
+
+        return a;
+    }
+
+    bool Solver::probeLiteral(Literal l, std::vector<StoredClausePointer> &hyperBinaries) {
+        assert(decisionLevel() == 0);
+        ++statistics.probedLiterals;
+        newDecisionLevel();
+        enqueue(l, nullptr);
+        if (!unitPropagate()) {
+            if (lrat) {
+                collectHints(conflict->literals, conflict->id, {l.negate()}, trail.size());
+            }
+
+            backtrack(0);
+            ++statistics.failedLiterals;
+            const auto id = logAddition({l.negate()});
+            enqueue(l.negate(), nullptr);
+            unitIds[var(l).get()] = id;
+            if (!unitPropagate()) {
+                logRefutation(*conflict);
+                unsat = true;
+                return false;
+            }
+
+            return true;
+        }
+
+        // the binary implication tree rooted at l is built in trail order. Literals propagated by longer clauses are
+        // attached to the dominator of their antecedents, which yields the hyper-binary resolvent (¬dominator v u)
+        dominators[var(l).get()] = l;
+        depths[var(l).get()] = 0;
+        probeStamps[l.get()] = probeRound;
+        for (auto i = trailLimits[0] + 1; i < trail.size(); ++i) {
+            const Literal u = trail[i];
+            const auto *reason = reasons[var(u).get()];
+            assert(reason != nullptr && reason->literals[0] == u);
+            probeStamps[u.get()] = probeRound;
+            std::optional<Literal> dom;
+            unsigned antecedents = 0;
+            for (std::size_t k = 1; k < reason->literals.size(); ++k) {
+                const Literal antecedent = reason->literals[k].negate();
+                if (levels[var(antecedent).get()] > 0) {
+                    dom = dom.has_value() ? dominator(*dom, antecedent) : antecedent;
+                    ++antecedents;
+                }
+            }
+
+            assert(dom.has_value());
+            dominators[var(u).get()] = *dom;
+            depths[var(u).get()] = depths[var(*dom).get()] + 1;
+            if (antecedents > 1) {
+                // the resolvent is logged while its derivation is still on the trail
+                auto &binary = hyperBinaries.emplace_back(std::make_shared<StoredClause>(StoredClause{
+                    .literals = {u, dom->negate()}, .learned = true, .lbd = 2}));
+                if (lrat) {
+                    collectHints(reason->literals, reason->id, binary->literals, i + 1);
+                }
+
+                binary->id = logAddition(binary->literals);
+            }
+        }
+
+        backtrack(0);
+        for (auto &binary: hyperBinaries) {
+            attach(*binary);
+            learnts.emplace_back(std::move(binary));
+            ++statistics.hyperBinaries;
+        }
+
+        hyperBinaries.clear();
+        return true;
+    }
+
+    bool Solver::probe(Clock::time_point deadline) {
+        backtrack(0);
+        if (unsat) {
+            return false;
+        }
+
+        if (!unitPropagate()) {
+            logRefutation(*conflict);
+            unsat = true;
+            return false;
+        }
+
+        const auto savedPhases = phases;
+        std::vector<StoredClausePointer> hyperBinaries;
+        for (unsigned count = 1; !probeQueue.empty(); ++count) {
+            if (count % 16 == 0 && Clock::now() >= deadline) {
+                break;
+            }
+
+            const Literal l = probeQueue.back();
+            probeQueue.pop_back();
+            if (value(l) != TruthValue::Undefined || probeStamps[l.get()] == probeRound) {
+                continue;
+            }
+
+            if (!probeLiteral(l, hyperBinaries)) {
+                break;
+            }
+        }
+
+        if (probeQueue.empty()) {
+            rootUnitsAtProbing = trail.size();
+            binariesAtProbing = countBinaries();
+        }
+
+        phases = savedPhases;
+        return !unsat;
+    }
+
+    bool Solver::probe() {
+        backtrack(0);
+        fillProbeQueue();
+        return probe(Clock::time_point::max());
+    }
+
+    auto Solver::lookahead(Literal l) -> std::optional<std::size_t> {
+        const auto before = trail.size();
+        newDecisionLevel();
+        enqueue(l, nullptr);
+        const bool consistent = unitPropagate();
+        const auto propagated = trail.size() - before;
+        backtrack(decisionLevel() - 1);
+        return consistent ? std::optional(propagated) : std::nullopt;
+    }
+
+    void Solver::splitCube(Cube &current, unsigned depth, const std::vector<std::size_t> &occurrences,
+                           std::vector<Cube> &cubes, std::vector<Cube> *refuted) {
+        const auto refute = [&] {
+            if (refuted != nullptr) {
+                refuted->emplace_back(current);
+            }
+        };
+
+        if (depth == 0 || trail.size() == numVariables) {
+            cubes.emplace_back(current);
+            return;
+        }
+
+        std::vector<unsigned> candidates;
+        for (unsigned x = 0; x < numVariables; ++x) {
+            if (model[x] == TruthValue::Undefined && !eliminated[x]) {
+                candidates.emplace_back(x);
+            }
+        }
+
+        const auto score = [&occurrences](unsigned x) {
+            return (occurrences[pos(x).get()] + 1) * (occurrences[neg(x).get()] + 1);
+        };
+
+        const auto numCandidates = std::min<std::size_t>(candidates.size(), config.lookaheadCandidates);
+        std::ranges::partial_sort(candidates, candidates.begin() + static_cast<std::ptrdiff_t>(numCandidates),
+                                  std::greater{}, score);
+        const auto prefixSize = current.size();
+        std::optional<Literal> best;
+        double bestScore = -1;
+        for (std::size_t i = 0; i < numCandidates; ++i) {
+            const Variable x(candidates[i]);
+            if (model[x.get()] != TruthValue::Undefined) {
+                continue;
+            }
+
+            const auto positive = lookahead(pos(x));
+            const auto negative = lookahead(neg(x));
+            if (!positive.has_value() || !negative.has_value()) {
+                // failed literal: the other polarity is implied by the current cube
+                if (!positive.has_value() && !negative.has_value()) {
+                    refute();
+                    current.erase(current.begin() + static_cast<std::ptrdiff_t>(prefixSize), current.end());
+                    return;
+                }
+
+                const Literal implied = positive.has_value() ? pos(x) : neg(x);
+                current.emplace_back(implied.negate());
+                refute();
+                current.back() = implied;
+                if (decisionLevel() == 0) {
+                    logAddition({implied});
+                }
+
+                enqueue(implied, nullptr);
+                if (!unitPropagate()) {
+                    refute();
+                    current.erase(current.begin() + static_cast<std::ptrdiff_t>(prefixSize), current.end());
+                    return;
+                }
+
+                // the propagation may have assigned the best candidate so far, its lookahead counts are outdated
+                best.reset();
+                bestScore = -1;
+                continue;
+            }
+
+            const auto a = static_cast<double>(*positive);
+            const auto b = static_cast<double>(*negative);
+            if (const auto s = 1024 * a * b + a + b; s > bestScore) {
+                bestScore = s;
+                best = a >= b ? pos(x) : neg(x);
+            }
+        }
+
+        if (!best.has_value()) {
+            cubes.emplace_back(current);
+        } else {
+            for (Literal l: {*best, best->negate()}) {
+                current.emplace_back(l);
+                newDecisionLevel();
+                enqueue(l, nullptr);
+                if (unitPropagate()) {
+                    splitCube(current, depth - 1, occurrences, cubes, refuted);
+                } else {
+                    refute();
+                }
+
+                backtrack(decisionLevel() - 1);
+                current.pop_back();
+            }
+        }
+
+        current.erase(current.begin() + static_cast<std::ptrdiff_t>(prefixSize), current.end());
+    }
+
+    auto Solver::cube(const Cube &prefix, unsigned depth, std::vector<Cube> *refuted) -> std::vector<Cube> {
+        std::vector<Cube> cubes;
+        backtrack(0);
+        if (!unsat && !unitPropagate()) {
+            logRefutation(*conflict);
+            unsat = true;
+        }
+
+        if (unsat) {
+            if (refuted != nullptr) {
+                refuted->emplace_back(prefix);
+            }
+
+            return cubes;
+        }
+
+        std::vector<std::size_t> occurrences(2 * static_cast<std::size_t>(numVariables), 0);
+        for (const auto &clause: clauses) {
+            for (Literal l: clause->literals) {
+                ++occurrences[l.get()];
+            }
+        }
+
+        const auto savedPhases = phases;
+        Cube current;
+        bool consistent = true;
+        for (Literal l: prefix) {
+            current.emplace_back(l);
+            if (value(l) == TruthValue::False) {
+                consistent = false;
+                break;
+            }
+
+            newDecisionLevel();
+            if (value(l) == TruthValue::Undefined) {
+                enqueue(l, nullptr);
+                if (!unitPropagate()) {
+                    consistent = false;
+                    break;
+                }
+            }
+        }
+
+        if (consistent) {
+            splitCube(current, depth, occurrences, cubes, refuted);
+        } else if (refuted != nullptr) {
+            refuted->emplace_back(prefix);
+        }
+
+        backtrack(0);
+        phases = savedPhases;
+        return cubes;
+    }
+
+    bool Solver::terminated() const {
+        return (terminationFlag != nullptr && terminationFlag->load(std::memory_order_relaxed)) ||
+               (terminationCallback && terminationCallback());
+    }
+
+    bool Solver::exchangeClauses() {
+        assert(decisionLevel() == 0);
+        for (; exportedUnits < trail.size(); ++exportedUnits) {
+            ++statistics.exportedClauses;
+            sharing->exportClause(Clause{trail[exportedUnits]}, 1);
+        }
+
+        imported.clear();
+        sharing->importClauses(imported);
+        for (auto &[literals, lbd]: imported) {
+            if (std::ranges::any_of(literals, [this](Literal l) {
+                return eliminated[var(l).get()] || value(l) == TruthValue::True;
+            })) {
+                continue;
+            }
+
+            ++statistics.importedClauses;
+            if (literals.size() == 1) {
+                if (value(literals.front()) == TruthValue::False) {
+                    unsat = true;
+                    return false;
+                }
+
+                enqueue(literals.front(), nullptr);
+                continue;
+            }
+
+            auto stored = std::make_shared<StoredClause>(StoredClause{
+                .literals = std::move(literals), .learned = true, .lbd = lbd});
+            if (!attachAtRoot(*stored)) {
+                unsat = true;
+                return false;
+            }
+
+            learnts.emplace_back(std::move(stored));
+        }
+
+        if (!unitPropagate()) {
+            unsat = true;
+            return false;
+        }
+
+        return true;
+    }
+
+    auto Solver::search(std::uint64_t conflictBudget) -> SolverResult {
+        std::uint64_t conflicts = 0;
+        while (true) {
+            if (terminated()) {
+                backtrack(0);
+                return SolverResult::Unknown;
+            }
+
+            if (!unitPropagate()) {
+                ++statistics.conflicts;
+                ++conflicts;
+                if (decisionLevel() == 0) {
+                    logRefutation(*conflict);
+                    unsat = true;
+                    return SolverResult::Unsat;
+                }
+
+                auto [learnt, backtrackLevel] = analyze();
+                if (lrat) {
+                    collectHints(conflict->literals, conflict->id, learnt, trail.size());
+                }
+
+                const auto lbd = computeLBD(learnt);
+                backtrack(backtrackLevel);
+                learn(std::move(learnt), lbd);
+                heuristic.decay();
+                clauseIncrement /= static_cast<float>(config.clauseDecay);
+                continue;
+            }
+
+            if (conflicts >= conflictBudget) {
+                backtrack(0);
+                return SolverResult::Unknown;
+            }
+
+            if (decisionLevel() == 0) {
+                simplify();
+            }
+
+            if (statistics.conflicts >= nextReduce) {
+                reduceLearned();
+                nextReduce = statistics.conflicts + config.reduceInterval +
+                             config.reduceIncrement * ++statistics.reductions;
+            }
+
+            // assumptions are decided first, satisfied assumptions get an empty decision level
+            if (decisionLevel() < assumptions.size()) {
+                const Literal a = assumptions[decisionLevel()];
+                if (value(a) == TruthValue::False) {
+                    analyzeFinal(a);
+                    backtrack(0);
+                    return SolverResult::Unsat;
+                }
+
+                newDecisionLevel();
+                if (value(a) == TruthValue::Undefined) {
+                    enqueue(a, nullptr);
+                }
+
+                continue;
+            }
+
+            if (trail.size() == numVariables) {
+                return SolverResult::Sat;
+            }
+
+            const Variable x = heuristic(model, numVariables - trail.size());
+            ++statistics.decisions;
+            newDecisionLevel();
+            enqueue(phases[x.get()] == TruthValue::True ? pos(x) : neg(x), nullptr);
+        }
+    }
+
+    bool Solver::eliminate() {
+        assert(decisionLevel() == 0);
+        if (!unitPropagate()) {
+            logRefutation(*conflict);
+            unsat = true;
+            return false;
+        }
+
+        // learned binaries (e.g. hyper-binary resolvents) are implied by the formula and help finding equivalences
+        std::vector<Clause> formula;
+        std::vector<ClauseId> ids;
+        formula.reserve(clauses.size() + trail.size());
+        ids.reserve(clauses.size() + trail.size());
+        for (Literal l: trail) {
+            // root units are made explicit in the proof since the preprocessor deletes their reasons
+            ids.emplace_back(lrat ? unitIds[var(l).get()] : logAddition({l}));
+            formula.emplace_back(Clause{l});
+        }
+
+        for (const auto &clause: clauses) {
+            ids.emplace_back(clause->id);
+            formula.emplace_back(clause->literals);
+        }
+
+        for (const auto &clause: learnts) {
+            if (clause->literals.size() == 2) {
+                ids.emplace_back(clause->id);
+                formula.emplace_back(clause->literals);
+                clause->deleted = true;
+            }
+        }
+
+        Preprocessor preprocessor(std::move(formula), numVariables, {}, proof, std::move(ids));
+        for (unsigned x = 0; x < numVariables; ++x) {
+            if (frozen[x]) {
+                preprocessor.freeze(x);
+            }
+        }
+
+        if (!preprocessor.run()) {
+            unsat = true;
+            return false;
+        }
+
+        const auto &preprocessorStats = preprocessor.getStatistics();
+        statistics.eliminatedVariables += preprocessorStats.eliminatedVariables + preprocessorStats.substitutedVariables;
+
+        for (unsigned x = 0; x < numVariables; ++x) {
+            eliminated[x] |= preprocessor.isEliminated(x);
+        }
+
+        // learned clauses over removed variables would constrain their reconstructed values
+        for (const auto &clause: learnts) {
+            if (!clause->deleted && std::ranges::any_of(clause->literals, [&preprocessor](Literal l) {
+                return preprocessor.isEliminated(var(l));
+            })) {
+                logDeletion(*clause);
+                clause->deleted = true;
+            }
+        }
+
+        std::erase_if(learnts, [](const auto &c) { return c->deleted; });
+        for (auto &watchList: watches) {
+            watchList.clear();
+        }
+
+        for (Literal l: trail) {
+            reasons[var(l).get()] = nullptr;
+        }
+
+        clauses.clear();
+        originalLookup.clear();
+        for (const auto &clause: learnts) {
+            if (!attachAtRoot(*clause)) {
+                logRefutation(*clause);
+                unsat = true;
+                return false;
+            }
+        }
+
+        if (!preprocessor.transferTo(*this)) {
+            return false;
+        }
+
+        // witnesses of removed clauses may be flipped during reconstruction and must not be constrained later either
+        for (const auto &entry: preprocessor.getReconstructionStack()) {
+            eliminated[var(entry.witness).get()] = 1;
+        }
+
+        rootUnitsAtSimplify = 0;
+        if (!unitPropagate()) {
+            logRefutation(*conflict);
+            unsat = true;
+            return false;
+        }
+
+        return true;
+    }
+
+    auto Solver::rootSimplifiedClauses() const -> std::vector<Clause> {
+        assert(decisionLevel() == 0);
+        std::vector<Clause> formula;
+        formula.reserve(clauses.size() + xorClauses.size() + cardinalityClauses.size());
+        for (const auto *db: {&clauses, &xorClauses, &cardinalityClauses}) {
+            for (const auto &clause: *db) {
+                if (std::ranges::any_of(clause->literals, [this](Literal l) { return value(l) == TruthValue::True; })) {
+                    continue;
+                }
+
+                auto &reduced = formula.emplace_back();
+                for (Literal l: clause->literals) {
+                    if (value(l) == TruthValue::Undefined) {
+                        reduced.emplace_back(l);
+                    }
+                }
+            }
+        }
+
+        return formula;
+    }
+
+    bool Solver::detectXors() {
+        assert(decisionLevel() == 0);
+        std::vector<Clause> candidates;
+        std::vector<std::size_t> positions;
+        for (std::size_t i = 0; i < clauses.size(); ++i) {
+            if (clauses[i]->literals.size() >= 3 && clauses[i]->literals.size() <= config.maxXorSize) {
+                candidates.emplace_back(clauses[i]->literals);
+                positions.emplace_back(i);
+            }
+        }
+
+        auto found = findXors(candidates, config.maxXorSize);
+        xorsDetected = true;
+        if (found.empty()) {
+            return true;
+        }
+
+        // the encoding clauses are kept for rebase(), local search and the bit-parallel search but are not watched.
+        // Elimination only sees the remaining clauses and therefore must not remove variables of the constraints
+        std::vector<char> removed(clauses.size(), 0);
+        for (auto &constraint: found) {
+            for (auto c: constraint.clauses) {
+                removed[positions[c]] = 1;
+                detach(*clauses[positions[c]]);
+                xorClauses.emplace_back(clauses[positions[c]]);
+            }
+
+            for (auto x: constraint.variables) {
+                frozen[x] = 1;
+            }
+
+            constraint.clauses.clear();
+            xors.emplace_back(std::move(constraint));
+        }
+
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < clauses.size(); ++i) {
+            if (!removed[i]) {
+                clauses[j++] = std::move(clauses[i]);
+            }
+        }
+
+        clauses.resize(j);
+        statistics.xorConstraints += found.size();
+        // the eliminated matrix follows the trail from the root level on
+        gauss.emplace(xors, numVariables);
+        xorHead = 0;
+        if (!unitPropagate()) {
+            logRefutation(*conflict);
+            unsat = true;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool Solver::detectCardinalities() {
+        assert(decisionLevel() == 0);
+        std::vector<Clause> candidates;
+        std::vector<std::size_t> positions;
+        for (std::size_t i = 0; i < clauses.size(); ++i) {
+            if (clauses[i]->literals.size() >= 2 && clauses[i]->literals.size() <= config.maxCardinalityBound + 1) {
+                candidates.emplace_back(clauses[i]->literals);
+                positions.emplace_back(i);
+            }
+        }
+
+        auto found = findCardinalities(candidates, config.maxCardinalityBound);
+        cardinalitiesDetected = true;
+        if (found.empty()) {
+            return true;
+        }
+
+        // at-most-one constraints keep their binary clauses: they propagate faster than a counter and take part in
+        // probing. Otherwise, as for the XOR constraints, the encoding clauses are only kept for rebase() and the
+        // other engines. The at-most-one constraints are found again in the clauses
+        std::erase_if(cardinalities, [](const auto &constraint) { return constraint.bound == 1; });
+        std::vector<char> removed(clauses.size(), 0);
+        for (auto &constraint: found) {
+            if (constraint.bound > 1) {
+                for (auto c: constraint.clauses) {
+                    removed[positions[c]] = 1;
+                    detach(*clauses[positions[c]]);
+                    cardinalityClauses.emplace_back(clauses[positions[c]]);
+                }
+
+                for (Literal l: constraint.literals) {
+                    frozen[var(l).get()] = 1;
+                }
+
+                statistics.cardinalityClauses += constraint.clauses.size();
+            }
+
+            constraint.clauses.clear();
+            cardinalities.emplace_back(std::move(constraint));
+        }
+
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < clauses.size(); ++i) {
+            if (!removed[i]) {
+                clauses[j++] = std::move(clauses[i]);
+            }
+        }
+
+        clauses.resize(j);
+        statistics.cardinalityConstraints = cardinalities.size();
+        cardinalityOccurrences.clear();
+        for (unsigned c = 0; c < cardinalities.size(); ++c) {
+            if (cardinalities[c].bound > 1) {
+                cardinalityOccurrences.resize(2 * static_cast<std::size_t>(numVariables));
+                for (Literal l: cardinalities[c].literals) {
+                    cardinalityOccurrences[l.get()].emplace_back(c);
+                }
+            }
+        }
+
+        // the counters are rebuilt from the root level trail
+        cardinalityCounts.assign(cardinalities.size(), 0);
+        cardinalityHead = 0;
+        if (!unitPropagate()) {
+            logRefutation(*conflict);
+            unsat = true;
+            return false;
+        }
+
+        std::vector<Clause> remaining;
+        remaining.reserve(clauses.size());
+        for (const auto &clause: clauses) {
+            remaining.emplace_back(clause->literals);
+        }
+
+        if (countingConflict(cardinalities, remaining, model)) {
+            unsat = true;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool Solver::propagateCardinalities() {
+        if (cardinalityOccurrences.empty()) {
+            return true;
+        }
+
+        while (cardinalityHead < trail.size()) {
+            const Literal l = trail[cardinalityHead++];
+            // all counters are updated first, backtrack() relies on them being in sync with cardinalityHead
+            for (auto c: cardinalityOccurrences[l.get()]) {
+                ++cardinalityCounts[c];
+            }
+
+            for (auto c: cardinalityOccurrences[l.get()]) {
+                const auto &constraint = cardinalities[c];
+                const auto count = cardinalityCounts[c];
+                if (count < constraint.bound) {
+                    continue;
+                }
+
+                // the true literals of the constraint (possibly more than counted) are the reason
+                lazyConflict.literals.clear();
+                for (Literal other: constraint.literals) {
+                    if (value(other) == TruthValue::True) {
+                        lazyConflict.literals.emplace_back(other.negate());
+                    }
+                }
+
+                if (count > constraint.bound) {
+                    ++statistics.cardinalityConflicts;
+                    conflict = &lazyConflict;
+                    return false;
+                }
+
+                for (Literal other: constraint.literals) {
+                    if (value(other) != TruthValue::Undefined) {
+                        continue;
+                    }
+
+                    ++statistics.cardinalityPropagations;
+                    if (decisionLevel() == 0) {
+                        enqueue(other.negate(), nullptr);
+                        continue;
+                    }
+
+                    auto reason = std::make_shared<StoredClause>(StoredClause{.literals = {other.negate()}});
+                    reason->literals.insert(reason->literals.end(), lazyConflict.literals.begin(),
+                                            lazyConflict.literals.end());
+                    enqueue(other.negate(), reason.get());
+                    lazyReasons.emplace_back(std::move(reason));
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool Solver::propagateXors() {
+        if (!gauss.has_value()) {
+            return false;
+        }
+
+        for (; xorHead < trail.size(); ++xorHead) {
+            gauss->assign(trail[xorHead]);
+        }
+
+        if (!gauss->propagate(xorImplications, lazyConflict.literals)) {
+            ++statistics.xorConflicts;
+            conflict = &lazyConflict;
+            return false;
+        }
+
+        for (auto &implication: xorImplications) {
+            ++statistics.xorPropagations;
+            if (decisionLevel() == 0) {
+                enqueue(implication.front(), nullptr);
+                continue;
+            }
+
+            const auto &reason = lazyReasons.emplace_back(std::make_shared<StoredClause>(StoredClause{
+                .literals = std::move(implication)}));
+            enqueue(reason->literals.front(), reason.get());
+        }
+
+        // the implied literals are passed to the matrix with the next call
+        return !xorImplications.empty();
+    }
+
+    void Solver::walk() {
+        // the walk works on the irredundant clauses simplified by the root level assignment
+        const auto formula = rootSimplifiedClauses();
+        LocalSearch search(formula, numVariables, {.seed = config.seed + static_cast<unsigned>(statistics.flips)});
+        search.setTerminationFlag(terminationFlag);
+        search.setAssignment(phases);
+        const auto initial = search.numUnsatisfied();
+        search.solve(localSearchBudget);
+        const auto best = search.getBestUnsatisfied();
+        const auto &assignment = search.getBestAssignment();
+        for (unsigned x = 0; x < numVariables; ++x) {
+            if (model[x] == TruthValue::Undefined) {
+                phases[x] = assignment[x];
+            }
+        }
+
+        statistics.flips += search.getStatistics().flips;
+        statistics.walkImprovement += initial - best;
+        // longer walks while they get closer to a model than any walk before, shorter walks otherwise
+        if (best < bestLocalSearch) {
+            bestLocalSearch = best;
+            localSearchBudget = std::min(2 * localSearchBudget, 64 * config.localSearchFlips);
+        } else {
+            localSearchBudget = std::max(localSearchBudget / 2, config.localSearchFlips / 8);
+        }
+    }
+
+    SolverResult Solver::solveBitParallel(std::uint64_t conflictLimit) {
+        ++statistics.bitParallelCalls;
+        clausesAtBitParallel = clauses.size();
+        const auto budget = std::min(config.bitParallelConflicts, conflictLimit);
+        const auto [result, values, stats] = sat::solveBitParallel(rootSimplifiedClauses(), numVariables, budget,
+                                                                    terminationFlag);
+        statistics.conflicts += stats.conflicts;
+        statistics.bitParallelConflicts += stats.conflicts;
+        if (result == SolverResult::Unsat) {
+            unsat = true;
+        } else if (result == SolverResult::Sat) {
+            // the model gets a decision level of its own such that the next call retracts it like a CDCL model
+            newDecisionLevel();
+            for (unsigned x = 0; x < numVariables; ++x) {
+                if (model[x] == TruthValue::Undefined) {
+                    enqueue(values[x] == TruthValue::True ? pos(x) : neg(x), nullptr);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    double Solver::inprocessingBudget(const InprocessingStatistics &stats, double fraction) const {
+        return fraction * statistics.searchTime - stats.time;
+    }
+
+    template<typename Technique, typename Effect>
+    void Solver::runTechnique(InprocessingStatistics &stats, Technique &&technique, Effect &&effect) {
+        const auto before = effect();
+        const auto start = Clock::now();
+        technique();
+        stats.time += std::chrono::duration<double>(Clock::now() - start).count();
+        stats.effect += effect() - before;
+        ++stats.calls;
+    }
+
+    bool Solver::inprocess() {
+        assert(decisionLevel() == 0);
+        auto deadline = [](double budget) {
+            return Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(budget));
+        };
+
+        // learned clause simplification after each database reduction
+        if (statistics.reductions > reductionsAtInprocessing) {
+            reductionsAtInprocessing = statistics.reductions;
+            if (config.subsumption && inprocessingBudget(statistics.subsumption, config.subsumptionTimeFraction) > 0) {
+                runTechnique(statistics.subsumption, [this] { subsumeLearned(); }, [this] {
+                    return statistics.subsumedClauses + statistics.strengthenedClauses;
+                });
+            }
+
+            const auto budget = inprocessingBudget(statistics.vivification, config.vivificationTimeFraction);
+            if (config.vivification && budget > 0 && !unsat) {
+                runTechnique(statistics.vivification, [&] { vivifyLearned(deadline(budget)); }, [this] {
+                    return statistics.vivifiedLiterals;
+                });
+            }
+        }
+
+        if (config.probing && !unsat) {
+            const auto budget = inprocessingBudget(statistics.probing, config.probingTimeFraction);
+            if (budget > 0 && probeQueue.empty() &&
+                (trail.size() != rootUnitsAtProbing || countBinaries() != binariesAtProbing)) {
+                fillProbeQueue();
+            }
+
+            if (budget > 0 && !probeQueue.empty()) {
+                runTechnique(statistics.probing, [&] { probe(deadline(budget)); }, [this] {
+                    return statistics.failedLiterals;
+                });
+            }
+        }
+
+        // elimination cannot be interrupted, it is only run if the budget covers the duration of the last run (or an
+        // estimate based on the formula size before the first run)
+        const auto eliminationBudget = inprocessingBudget(statistics.elimination, config.eliminationTimeFraction);
+        if (config.elimination && !unsat && eliminationBudget > 0 && statistics.elimination.calls == 0) {
+            std::size_t size = 0;
+            for (const auto &clause: clauses) {
+                size += clause->literals.size();
+            }
+
+            lastEliminationTime = 1e-6 * static_cast<double>(size);
+        }
+
+        if (config.elimination && assumptions.empty() && !shrinking && !unsat &&
+            eliminationBudget > lastEliminationTime &&
+            (trail.size() != rootUnitsAtElimination || countBinaries() != binariesAtElimination)) {
+            const auto timeBefore = statistics.elimination.time;
+            runTechnique(statistics.elimination, [this] { eliminate(); }, [this] {
+                return statistics.eliminatedVariables;
+            });
+
+            lastEliminationTime = statistics.elimination.time - timeBefore;
+            rootUnitsAtElimination = trail.size();
+            binariesAtElimination = countBinaries();
+        }
+
+        if (config.localSearch && !unsat && statistics.conflicts >= nextLocalSearch &&
+            inprocessingBudget(statistics.localSearch, config.localSearchTimeFraction) > 0) {
+            runTechnique(statistics.localSearch, [this] { walk(); }, [this] { return statistics.walkImprovement; });
+            nextLocalSearch = statistics.conflicts + config.localSearchInterval;
+        }
+
+        return !unsat;
+    }
+
+    SolverResult Solver::solve() {
+        return solve({});
+    }
+
+    SolverResult Solver::solve(const Cube &assumptions, std::uint64_t conflictLimit) {
+        if (std::ranges::any_of(assumptions, [this](Literal l) { return eliminated[var(l).get()]; })) {
+            throw std::invalid_argument("Assumption on eliminated variable");
+        }
+
+        failedAssumptions.clear();
+        if (unsat) {
+            return SolverResult::Unsat;
+        }
+
+        backtrack(0);
+        // the constraints are only searched for before the first search, rescanning the whole clause database would
+        // dominate the short incremental calls
+        if (config.xorReasoning && proof == nullptr && !xorsDetected && !detectXors()) {
+            return SolverResult::Unsat;
+        }
+
+        if (config.cardinalityReasoning && proof == nullptr && !cardinalitiesDetected && !detectCardinalities()) {
+            return SolverResult::Unsat;
+        }
+
+        // without proof, clause exchange or assumptions, small formulas are decided by the bit-parallel engine. It is
+        // deterministic, so it is only run again once clauses were added, and never after the CDCL search ran since
+        // that search keeps its learned clauses for later calls. It only polls the termination flag, a termination
+        // callback is checked before. Its conflicts count towards the conflict limit
+        const auto conflictsBefore = statistics.conflicts;
+        if (config.bitParallel && numVariables <= MaxBitParallelVariables && assumptions.empty() && proof == nullptr &&
+            sharing == nullptr && !searched && clauses.size() != clausesAtBitParallel && !terminated()) {
+            const auto result = solveBitParallel(conflictLimit);
+            if (result == SolverResult::Sat) {
+                reconstruction.extend(model);
+            }
+
+            if (result != SolverResult::Unknown || statistics.conflicts - conflictsBefore >= conflictLimit) {
+                return result;
+            }
+        }
+
+        this->assumptions = assumptions;
+        searched = true;
+        auto result = SolverResult::Unknown;
+        // the luby sequence continues across calls such that interrupted searches still reach long restart intervals
+        for (; result == SolverResult::Unknown; ++lubyIndex) {
+            const auto used = statistics.conflicts - conflictsBefore;
+            const auto budget = std::min(static_cast<std::uint64_t>(luby(2, lubyIndex) * config.restartUnit),
+                                         conflictLimit - std::min(used, conflictLimit));
+            const auto start = Clock::now();
+            result = search(budget);
+            statistics.searchTime += std::chrono::duration<double>(Clock::now() - start).count();
+            if (result == SolverResult::Unknown) {
+                if (terminated() || statistics.conflicts - conflictsBefore >= conflictLimit) {
+                    break;
+                }
+
+                ++statistics.restarts;
+                if ((sharing != nullptr && !exchangeClauses()) || (config.inprocessing && !inprocess())) {
+                    result = SolverResult::Unsat;
+                }
+            }
+        }
+
+        this->assumptions.clear();
+        if (result == SolverResult::Sat) {
+            reconstruction.extend(model);
+        }
+
+        return result;
+    }
+
+    auto Solver::getFailedAssumptions() const noexcept -> const Cube & {
+        return failedAssumptions;
+    }
+
+    auto Solver::shrinkFailedAssumptions(std::uint64_t conflictBudget) -> const Cube & {
+        Cube necessary;
+        Cube candidates = failedAssumptions;
+        std::uint64_t used = 0;
+        // the last check may run without assumptions, elimination must not remove variables the caller assumes again
+        shrinking = true;
+        while (!candidates.empty() && used < conflictBudget) {
+            const Literal dropped = candidates.back();
+            candidates.pop_back();
+            Cube remaining = necessary;
+            remaining.insert(remaining.end(), candidates.begin(), candidates.end());
+            const auto conflictsBefore = statistics.conflicts;
+            const auto result = solve(remaining, conflictBudget - used);
+            used += statistics.conflicts - conflictsBefore;
+            if (result != SolverResult::Unsat) {
+                necessary.emplace_back(dropped);
+                continue;
+            }
+
+            // the new refutation may need even fewer of the remaining candidates
+            std::erase_if(candidates, [this](Literal l) {
+                return std::ranges::find(failedAssumptions, l) == failedAssumptions.end();
+            });
+
+            if (unsat) {
+                necessary.clear();
+            }
+        }
+
+        shrinking = false;
+        necessary.insert(necessary.end(), candidates.begin(), candidates.end());
+        failedAssumptions = std::move(necessary);
+        return failedAssumptions;
+    }
+
+    void Solver::setTerminationFlag(const std::atomic_bool *flag) noexcept {
+        terminationFlag = flag;
+    }
+
+    void Solver::setTerminationCallback(std::function<bool()> callback) {
+        terminationCallback = std::move(callback);
+    }
+
+    void Solver::setProof(ProofWriter *proofWriter) noexcept {
+        proof = proofWriter;
+        lrat = proof != nullptr && proof->needsHints();
+    }
+
+    void Solver::setClauseSharing(ClauseSharing *clauseSharing) noexcept {
+        sharing = clauseSharing;
+        exportedUnits = 0;
+    }
+
+    auto Solver::getModel() const -> const std::vector<TruthValue> & {
+        return model;
+    }
+
+    auto Solver::reconstructionStack() -> ReconstructionStack & {
+        return reconstruction;
+    }
+
+    unsigned Solver::getNumVariables() const noexcept {
+        return numVariables;
+    }
+
+    auto Solver::getStatistics() const noexcept -> const SolverStatistics & {
+        return statistics;
     }
-} // sat
\ No newline at end of file
+} // sat
@@ -8,10 +8,26 @@
 #ifndef SOLVER_HPP
 #define SOLVER_HPP
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
 
 #include "basic_structures.hpp"
 #include "Clause.hpp"
+#include "CardinalityConstraints.hpp"
+#include "ClauseSharing.hpp"
+#include "heuristics.hpp"
+#include "ProofWriter.hpp"
+#include "ReconstructionStack.hpp"
+#include "XorConstraints.hpp"
+#include "util/enum.hpp"
 
 namespace sat {
     /*
@@ -23,15 +39,274 @@ namespace sat {
     using ClausePointer = std::shared_ptr<Clause>;
     using ConstClausePointer = std::shared_ptr<const Clause>;
 
+    /**
+     * @brief Outcome of a call to Solver::solve
+     */
+    PENUM(SolverResult, Sat, Unsat, Unknown)
+
+    /**
+     * @brief Clause as stored inside the solver together with the bookkeeping data needed by the search
+     * @details @copybrief
+     * The first two literals of a clause of size >= 2 are its watched literals.
+     */
+    struct StoredClause {
+        Clause literals;
+        bool learned = false;
+        bool deleted = false;
+        unsigned lbd = 0; ///< literal block distance (only meaningful for learned clauses)
+        float activity = 0;
+        bool vivified = false; ///< whether vivification was already attempted on this clause
+        ClauseId id = 0; ///< identifier in the proof (if one is logged)
+    };
+
+    using StoredClausePointer = std::shared_ptr<StoredClause>;
+
+    /**
+     * Conjunction of literals, used as assumptions that restrict the search to a part of the search space
+     */
+    using Cube = std::vector<Literal>;
+
+    /**
+     * @brief Search parameters of the solver
+     */
+    struct SolverConfig {
+        double variableDecay = 0.95; ///< VSIDS activity decay
+        double clauseDecay = 0.999; ///< learned clause activity decay
+        unsigned restartUnit = 100; ///< number of conflicts per unit of the luby restart sequence
+        unsigned reduceInterval = 2000; ///< number of conflicts before the first learned clause database reduction
+        unsigned reduceIncrement = 300; ///< increment of the reduction interval after each reduction
+        unsigned glueLimit = 2; ///< learned clauses with an LBD up to this value are never deleted
+        TruthValue initialPhase = TruthValue::False; ///< initial saved phase of all variables (Undefined: random)
+        unsigned seed = 0; ///< random seed. If non-zero, the initial variable order is randomized
+        bool inprocessing = true; ///< whether to run simplification techniques at restarts
+        bool subsumption = true; ///< whether to subsume and strengthen learned clauses after database reductions
+        double subsumptionTimeFraction = 0.05; ///< maximum fraction of the search time spent on subsumption
+        bool probing = true; ///< whether to run failed literal probing
+        double probingTimeFraction = 0.1; ///< maximum fraction of the search time spent on probing
+        bool elimination = false; ///< whether to run the preprocessor on the irredundant clauses (see freeze())
+        double eliminationTimeFraction = 0.1; ///< maximum fraction of the search time spent on elimination
+        bool vivification = true; ///< whether to vivify learned clauses after database reductions
+        double vivificationTimeFraction = 0.1; ///< maximum fraction of the search time spent on vivification
+        unsigned lookaheadCandidates = 64; ///< number of preselected variables evaluated per lookahead split
+        bool localSearch = false; ///< whether to rephase with bounded local search runs (hybrid mode, see walk())
+        unsigned localSearchInterval = 2000; ///< minimum number of conflicts between two local search runs
+        double localSearchTimeFraction = 0.1; ///< maximum fraction of the search time spent on local search
+        std::uint64_t localSearchFlips = 50000; ///< initial flip budget of a local search run, adapted during search
+        bool bitParallel = true; ///< whether to try the BitParallelSolver first on formulas with at most 256 variables
+        std::uint64_t bitParallelConflicts = 3000; ///< conflict budget of the BitParallelSolver before CDCL takes over
+        bool xorReasoning = true; ///< whether to propagate XOR constraints found in the clauses by Gaussian elimination
+        unsigned maxXorSize = 6; ///< largest number of variables of a detected XOR constraint
+        bool cardinalityReasoning = true; ///< whether to propagate at-most-k constraints in the clauses natively
+        unsigned maxCardinalityBound = 3; ///< largest bound k of a detected at-most-k constraint
+    };
+
+    /**
+     * @brief Cost and effectiveness of an inprocessing technique
+     */
+    struct InprocessingStatistics {
+        std::uint64_t calls = 0;
+        double time = 0; ///< seconds spent in the technique
+        std::uint64_t effect = 0; ///< technique specific measure of simplification (see SolverStatistics)
+    };
+
+    /**
+     * @brief Search statistics of the solver
+     */
+    struct SolverStatistics {
+        std::uint64_t decisions = 0;
+        std::uint64_t propagations = 0;
+        std::uint64_t conflicts = 0;
+        std::uint64_t restarts = 0;
+        std::uint64_t learnedClauses = 0;
+        std::uint64_t deletedClauses = 0;
+        std::uint64_t reductions = 0;
+        std::uint64_t duplicateClauses = 0;
+        std::uint64_t subsumedClauses = 0;
+        std::uint64_t strengthenedClauses = 0;
+        std::uint64_t probedLiterals = 0;
+        std::uint64_t failedLiterals = 0;
+        std::uint64_t hyperBinaries = 0;
+        std::uint64_t vivifiedClauses = 0;
+        std::uint64_t vivifiedLiterals = 0; ///< literals removed by vivification
+        std::uint64_t eliminatedVariables = 0; ///< variables eliminated or substituted during inprocessing
+        std::uint64_t exportedClauses = 0; ///< learned clauses and units offered to the clause exchange
+        std::uint64_t importedClauses = 0; ///< clauses of other solvers added to the learned clauses
+        std::uint64_t flips = 0; ///< variable flips of all local search runs
+        std::uint64_t walkImprovement = 0; ///< clauses falsified by the saved phases and satisfied by local search
+        std::uint64_t bitParallelCalls = 0; ///< calls to solve() dispatched to the BitParallelSolver
+        std::uint64_t bitParallelConflicts = 0; ///< conflicts of the BitParallelSolver (included in conflicts)
+        std::uint64_t xorConstraints = 0; ///< XOR constraints found in the clauses
+        std::uint64_t xorPropagations = 0; ///< literals implied by Gaussian elimination
+        std::uint64_t xorConflicts = 0; ///< conflicts found by Gaussian elimination
+        std::uint64_t cardinalityConstraints = 0; ///< at-most-k constraints found in the clauses
+        std::uint64_t cardinalityClauses = 0; ///< clauses replaced by at-most-k constraints with k > 1
+        std::uint64_t cardinalityPropagations = 0; ///< literals implied by at-most-k constraints
+        std::uint64_t cardinalityConflicts = 0; ///< conflicts found by at-most-k constraints
+        double searchTime = 0; ///< seconds spent in the CDCL search (excluding inprocessing)
+        InprocessingStatistics subsumption; ///< effect: subsumed or strengthened learned clauses
+        InprocessingStatistics probing; ///< effect: failed literals
+        InprocessingStatistics elimination; ///< effect: eliminated or substituted variables
+        InprocessingStatistics vivification; ///< effect: literals removed from learned clauses
+        InprocessingStatistics localSearch; ///< effect: walkImprovement
+    };
 
     /**
      * @brief Main solver class
+     * @details @copybrief
+     * CDCL solver with two watched literals, first UIP clause learning, VSIDS branching, phase saving, luby restarts
+     * and LBD based learned clause database reduction. At restarts, an inprocessing scheduler runs learned clause
+     * subsumption, failed literal probing, elimination (the Preprocessor applied to the irredundant clauses) and
+     * learned clause vivification. Each technique may use a configurable fraction of the search time. In hybrid mode
+     * (SolverConfig::localSearch), bounded local search runs starting from the saved phases supply new phases.
+     * XOR constraints encoded in the clauses are removed from the watch lists and propagated by Gauss-Jordan
+     * elimination once clause propagation reaches a fixpoint (SolverConfig::xorReasoning, not with proofs). The reasons
+     * of its implications are created on demand and released on backtracking. Variables of XOR constraints are frozen.
+     * Likewise, at-most-k constraints with k > 1 replace their clauses and are propagated eagerly by counting their
+     * true literals (SolverConfig::cardinalityReasoning). At-most-one constraints (e.g. in pigeonhole formulas) keep
+     * their binary clauses. A counting argument over the constraints and the remaining clauses may refute the formula
+     * right away. Variables of replaced constraints are frozen. Both kinds of constraints are only searched for before
+     * the first search, clauses added later are kept as they are.
+     *
+     * The solver is incremental: clauses and variables may be added between calls to solve(), which may be given
+     * assumptions. Learned clauses, activities and saved phases are kept across calls. Elimination is disabled by
+     * default since the variables it removes can no longer be used in later clauses or assumptions. When it is
+     * enabled (SolverConfig::elimination), such variables must be frozen (freeze()).
      */
     class Solver {
     private:
+        struct Watcher {
+            StoredClause *clause;
+            Literal blocker;
+        };
+
+        using Clock = std::chrono::steady_clock;
+
         unsigned numVariables;
+        SolverConfig config;
         std::vector<TruthValue> model;
-        std::vector<ClausePointer> clauses;
+        std::vector<StoredClausePointer> clauses;
+        std::vector<StoredClausePointer> learnts;
+        std::vector<std::vector<Watcher>> watches;
+        std::vector<Literal> trail;
+        std::vector<std::size_t> trailLimits;
+        std::size_t propagationHead = 0;
+        std::vector<unsigned> levels;
+        std::vector<StoredClause *> reasons;
+        std::vector<TruthValue> phases;
+        std::vector<char> seen;
+        std::vector<unsigned> levelStamps;
+        unsigned stamp = 0;
+        VSIDS heuristic;
+        StoredClause *conflict = nullptr;
+        bool unsat = false;
+        float clauseIncrement = 1;
+        std::uint64_t nextReduce;
+        std::size_t rootUnitsAtSimplify = 0;
+        ReconstructionStack reconstruction;
+        SubsumptionChecker subsumption;
+        std::unordered_multimap<std::uint64_t, StoredClause *> originalLookup;
+        std::uint64_t reductionsAtInprocessing = 0;
+        std::vector<Literal> probeQueue;
+        std::vector<Literal> dominators;
+        std::vector<unsigned> depths;
+        std::vector<std::uint64_t> probeStamps;
+        std::uint64_t probeRound = 0;
+        std::size_t rootUnitsAtProbing = 0;
+        std::size_t binariesAtProbing = 0;
+        std::size_t rootUnitsAtElimination = 0;
+        std::size_t binariesAtElimination = 0;
+        double lastEliminationTime = 0;
+        std::uint64_t nextLocalSearch = 0;
+        std::uint64_t localSearchBudget;
+        std::size_t bestLocalSearch = std::numeric_limits<std::size_t>::max();
+        std::vector<char> eliminated; ///< variables removed by elimination or witnesses of removed clauses
+        std::vector<char> frozen;
+        std::default_random_engine rng;
+        const std::atomic_bool *terminationFlag = nullptr;
+        std::function<bool()> terminationCallback;
+        ClauseSharing *sharing = nullptr;
+        ProofWriter *proof = nullptr;
+        bool lrat = false; ///< whether the proof needs antecedents of lemmas
+        std::vector<ClauseId> unitIds; ///< proof identifiers of the unit clauses of root level literals (LRAT)
+        std::vector<ClauseId> hints;
+        std::vector<ClauseId> hintChain;
+        std::vector<unsigned> hintMarked;
+        std::vector<ClauseSharing::SharedClause> imported;
+        std::size_t exportedUnits = 0;
+        std::vector<XorConstraint> xors;
+        std::optional<GaussianElimination> gauss;
+        std::vector<StoredClausePointer> xorClauses; ///< clauses encoding the XOR constraints (not watched)
+        std::vector<StoredClausePointer> lazyReasons; ///< reasons of literals implied by XOR or cardinality constraints
+        std::vector<Clause> xorImplications;
+        StoredClause lazyConflict;
+        std::size_t xorHead = 0; ///< trail position up to which the XOR constraints have seen the assignment
+        bool xorsDetected = false; ///< constraints are only detected before the first search
+        std::vector<CardinalityConstraint> cardinalities;
+        std::vector<std::vector<unsigned>> cardinalityOccurrences; ///< constraints containing each literal
+        std::vector<unsigned> cardinalityCounts; ///< true literals of each constraint in trail[0, cardinalityHead)
+        std::vector<StoredClausePointer> cardinalityClauses; ///< encoding clauses of the constraints (not watched)
+        std::size_t cardinalityHead = 0;
+        bool cardinalitiesDetected = false; ///< constraints are only detected before the first search
+        std::size_t clausesAtBitParallel = 0;
+        bool searched = false; ///< whether the CDCL search ran in a previous call
+        Cube assumptions;
+        Cube failedAssumptions;
+        bool shrinking = false; ///< whether shrinkFailedAssumptions() is running, elimination must keep its variables
+        unsigned lubyIndex = 0;
+        SolverStatistics statistics;
+
+        TruthValue value(Literal l) const noexcept;
+        TruthValue initialPhase();
+        void attach(StoredClause &clause);
+        bool attachAtRoot(StoredClause &clause);
+        bool addIrredundant(Clause clause, ClauseId id);
+        void detach(const StoredClause &clause);
+        ClauseId logAddition(const Clause &clause);
+        void logDeletion(const StoredClause &clause);
+        void logRefutation(const StoredClause &falsified);
+        void collectHints(const Clause &falsified, ClauseId id, const Clause &lemma, std::size_t end);
+        void deriveUnit(Literal l, const StoredClause &reason);
+        void enqueue(Literal l, StoredClause *reason);
+        unsigned decisionLevel() const noexcept;
+        void newDecisionLevel();
+        void backtrack(unsigned level);
+        bool locked(const StoredClause &clause) const;
+        void bumpClause(StoredClause &clause);
+        unsigned computeLBD(const Clause &clause);
+        bool redundant(Literal l, unsigned abstractLevels, std::vector<Literal> &toClear);
+        auto analyze() -> std::pair<Clause, unsigned>;
+        void analyzeFinal(Literal assumption);
+        void learn(Clause clause, unsigned lbd);
+        void reduceLearned();
+        void simplify();
+        void subsumeLearned();
+        std::size_t countBinaries() const;
+        void fillProbeQueue();
+        Literal dominator(Literal a, Literal b) const;
+        bool probeLiteral(Literal l, std::vector<StoredClausePointer> &hyperBinaries);
+        bool probe(Clock::time_point deadline);
+        void vivifyLearned(Clock::time_point deadline);
+        bool eliminate();
+        auto rootSimplifiedClauses() const -> std::vector<Clause>;
+        bool detectXors();
+        bool propagateXors();
+        bool detectCardinalities();
+        bool propagateCardinalities();
+        void walk();
+        SolverResult solveBitParallel(std::uint64_t conflictLimit);
+        double inprocessingBudget(const InprocessingStatistics &stats, double fraction) const;
+        template<typename Technique, typename Effect>
+        void runTechnique(InprocessingStatistics &stats, Technique &&technique, Effect &&effect);
+        bool inprocess();
+        bool terminated() const;
+        auto lookahead(Literal l) -> std::optional<std::size_t>;
+        void splitCube(Cube &current, unsigned depth, const std::vector<std::size_t> &occurrences,
+                       std::vector<Cube> &cubes, std::vector<Cube> *refuted);
+        bool exchangeClauses();
+        auto search(std::uint64_t conflictBudget) -> SolverResult;
+
+        friend class Preprocessor;
+
     public:
 
         /**
@@ -41,24 +316,38 @@ namespace sat {
          */
         explicit Solver(unsigned numVariables);
 
-        /*
-         * @TODO if you want, you can declare additional constructors here
-         */
-
-
-        /*
-         * You can design the interface of your solver as you want. You can for example add clauses already in the
-         * constructor. The tests require the addClause method, however.
+        /**
+         * Ctor. Allocates enough space for the variables and uses custom search parameters
+         * @param numVariables Number of variables in the problem
+         * @param config search parameters
          */
+        Solver(unsigned numVariables, const SolverConfig &config);
 
         /**
-         * Adds a clause to the solver.
+         * Adds a clause to the solver. Duplicates of clauses already contained in the solver are ignored.
          * @param clause The clause to add
          * @return bool true if clause was successfully added, false if clause is empty or unit and violates the current
          * model
+         * @note If decisions have been made (e.g. after a successful solve()), the solver backtracks to the root level
+         * first and the model of the last search is discarded
+         * @throws std::invalid_argument if the clause contains a variable eliminated during an earlier search
          */
         bool addClause(Clause clause);
 
+        /**
+         * Adds a fresh variable. All data structures are extended in place, learned clauses and heuristic state are
+         * kept
+         * @return the new variable (the previous number of variables)
+         */
+        Variable addVariable();
+
+        /**
+         * Prevents a variable from being removed by elimination (SolverConfig::elimination) such that it can be used
+         * in clauses added later and in assumptions
+         * @param x variable to freeze
+         */
+        void freeze(Variable x);
+
         /**
          * Returns a reduced set of clauses. Excludes satisfied clauses and removes falsified literals from clauses
          * @return equivalent set of clauses
@@ -99,6 +388,134 @@ namespace sat {
          */
         bool unitPropagate();
 
+        /**
+         * Failed literal probing with hyper-binary resolution.
+         * @details @copybrief
+         * Tentatively assigns literals at decision level 1 (roots of the binary implication graph first) and
+         * propagates. Literals leading to a conflict are fixed to the opposite value. For every literal propagated by a
+         * longer clause, the binary clause connecting it to its dominator in the binary implication tree is learned.
+         * During solve(), probing is scheduled at restarts and limited to SolverConfig::probingTimeFraction of the
+         * search time.
+         * @return false if the problem was found to be unsatisfiable, true otherwise
+         */
+        bool probe();
+
+        /**
+         * Runs the CDCL search.
+         * @return SolverResult::Sat if a model was found (accessible via val()), SolverResult::Unsat if the problem is
+         * unsatisfiable
+         */
+        SolverResult solve();
+
+        /**
+         * Runs the CDCL search under assumptions. The assumptions are decided first (one decision level each) and
+         * retracted after the search. Learned clauses and heuristic state are kept.
+         * @param assumptions literals that are assumed to be true. Variables eliminated during an earlier search
+         * (SolverConfig::elimination) must not be used (see freeze()). Elimination is skipped while searching under
+         * assumptions
+         * @param conflictLimit the search is interrupted after this number of conflicts
+         * @return SolverResult::Sat if a model satisfying all assumptions was found, SolverResult::Unsat if the
+         * formula is unsatisfiable under the assumptions, SolverResult::Unknown if the search was interrupted
+         * @throws std::invalid_argument if an assumption refers to an eliminated variable
+         */
+        SolverResult solve(const Cube &assumptions,
+                           std::uint64_t conflictLimit = std::numeric_limits<std::uint64_t>::max());
+
+        /**
+         * Gets the assumptions responsible for the last unsatisfiable result (final conflict analysis).
+         * @details @copybrief
+         * The returned literals are a subset of the assumptions of the last call to solve() which is unsatisfiable
+         * together with the formula. The subset is not necessarily minimal (see shrinkFailedAssumptions())
+         * @return failed assumptions. Empty if the last call did not return SolverResult::Unsat or if the formula is
+         * unsatisfiable without assumptions
+         */
+        auto getFailedAssumptions() const noexcept -> const Cube &;
+
+        /**
+         * Shrinks the failed assumptions of the last unsatisfiable call. Each failed assumption is dropped in turn
+         * and the remaining ones are solved again. If they are still unsatisfiable, the assumption is removed
+         * together with all others not involved in the new refutation. Assumptions whose removal leads to a model or
+         * exceeds the budget are kept. Elimination is suspended meanwhile, so the assumptions remain usable
+         * @param conflictBudget maximum total number of conflicts spent on all checks
+         * @return the shrunk failed assumptions (also returned by getFailedAssumptions() afterwards)
+         */
+        auto shrinkFailedAssumptions(std::uint64_t conflictBudget) -> const Cube &;
+
+        /**
+         * Splits the search space below the given cube into smaller cubes using lookahead.
+         * @details @copybrief
+         * At each node of the split tree, the SolverConfig::lookaheadCandidates free variables with the most
+         * occurrences are preselected. Both polarities of each candidate are propagated and the variable maximizing
+         * 1024 * a * b + a + b (a and b: number of propagated literals) is split on. If one polarity fails, the other
+         * one is implied and added to the cube. Cubes whose propagation leads to a conflict are refuted and not
+         * returned. The disjunction of all returned and refuted cubes covers the given cube
+         * @param prefix cube to split (may be empty)
+         * @param depth maximum number of split decisions added to the prefix
+         * @param refuted optional output for refuted cubes
+         * @return cubes extending the prefix, empty if all cubes were refuted
+         */
+        auto cube(const Cube &prefix, unsigned depth, std::vector<Cube> *refuted = nullptr) -> std::vector<Cube>;
+
+        /**
+         * Sets a flag that is polled during the search. Once the flag is set, solve() returns SolverResult::Unknown
+         * @param flag termination flag (nullptr to disable). Must outlive the solver or be reset
+         */
+        void setTerminationFlag(const std::atomic_bool *flag) noexcept;
+
+        /**
+         * Sets a callback that is polled during the search. Once it returns true, solve() returns
+         * SolverResult::Unknown
+         * @param callback termination callback (empty to disable)
+         */
+        void setTerminationCallback(std::function<bool()> callback);
+
+        /**
+         * Connects the solver to a clause exchange. Short learned clauses and root level units are exported, clauses
+         * of other solvers are imported at restarts
+         * @param clauseSharing connection to the exchange (nullptr to disable). Must outlive the solver or be reset
+         */
+        void setClauseSharing(ClauseSharing *clauseSharing) noexcept;
+
+        /**
+         * Logs a DRAT or LRAT proof of the search. All clauses derived by the search and inprocessing are added to the
+         * proof, clauses removed from the solver are deleted and the empty clause concludes the proof once the formula
+         * is found to be unsatisfiable. Clauses passed to addClause() are registered as input clauses
+         * (ProofWriter::addInput()), so the proof must be set before the first clause is added. Imported clauses
+         * (setClauseSharing()) cannot be justified, so proofs of solvers connected to a clause exchange are invalid.
+         *
+         * For LRAT, the antecedents of learned clauses are the reasons visited by conflict analysis (including
+         * minimization) in trail order, preceded by the unit clauses of root level literals. Each root level literal
+         * gets such a unit clause when it is assigned, which may happen while clauses are still being added (see
+         * ProofWriter::reserveInputs()). Lookahead cubing (cube()) is not covered by LRAT proofs
+         * @param proofWriter proof output (nullptr to disable). Must outlive the solver or be reset
+         */
+        void setProof(ProofWriter *proofWriter) noexcept;
+
+        /**
+         * Gets the current model for all variables
+         * @return vector containing the truth value of each variable
+         */
+        auto getModel() const -> const std::vector<TruthValue> &;
+
+        /**
+         * Gets the stack used to extend the model found by the search to eliminated variables. Entries pushed here
+         * are applied after each successful search
+         * @return reconstruction stack of the solver
+         */
+        auto reconstructionStack() -> ReconstructionStack &;
+
+        /**
+         * Number of variables in the solver
+         * @return number of variables
+         */
+        unsigned getNumVariables() const noexcept;
+
+        /**
+         * Gets the search statistics
+         * @return statistics of all searches so far
+         */
+        auto getStatistics() const noexcept -> const SolverStatistics &;
+
     };
 } // sat
 
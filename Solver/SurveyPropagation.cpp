@@ -0,0 +1,437 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+#include "SurveyPropagation.hpp"
+#include "LocalSearch.hpp"
+
+namespace sat {
+    SurveyPropagation::SurveyPropagation(const std::vector<Clause> &clauses, std::size_t numVariables,
+                                         const SurveyPropagationConfig &config)
+        : numVariables(numVariables), config(config), products(2 * numVariables), zeros(2 * numVariables),
+          assignment(numVariables, TruthValue::Undefined), rng(config.seed) {
+        clauseBegin.emplace_back(0);
+        Clause normalized;
+        for (const auto &clause: clauses) {
+            normalized = clause;
+            std::ranges::sort(normalized, {}, [](Literal l) { return l.get(); });
+            const auto [first, last] = std::ranges::unique(normalized);
+            normalized.erase(first, last);
+            bool tautology = false;
+            for (std::size_t i = 1; i < normalized.size(); ++i) {
+                tautology |= normalized[i] == normalized[i - 1].negate();
+            }
+
+            if (tautology) {
+                continue;
+            }
+
+            if (normalized.empty()) {
+                emptyClause = true;
+                continue;
+            }
+
+            literals.insert(literals.end(), normalized.begin(), normalized.end());
+            clauseBegin.emplace_back(static_cast<std::uint32_t>(literals.size()));
+        }
+
+        std::uniform_real_distribution<double> distribution(0, 1);
+        surveys.resize(literals.size());
+        for (auto &eta: surveys) {
+            eta = distribution(rng);
+        }
+    }
+
+    bool SurveyPropagation::terminated() const {
+        return terminationFlag != nullptr && terminationFlag->load(std::memory_order_relaxed);
+    }
+
+    void SurveyPropagation::computeLiteralProducts() {
+        std::ranges::fill(products, 1.0);
+        std::ranges::fill(zeros, 0);
+        for (std::size_t e = 0; e < surveys.size(); ++e) {
+            const double factor = 1 - surveys[e];
+            const bool zero = factor <= 0;
+            zeros[literalIndex[e]] += zero;
+            products[literalIndex[e]] *= zero ? 1.0 : factor;
+        }
+    }
+
+    double SurveyPropagation::sweep() {
+        computeLiteralProducts();
+        double maxDelta = 0;
+        const auto numClauses = static_cast<std::uint32_t>(clauseBegin.size() - 1);
+        for (std::uint32_t c = 0; c < numClauses; ++c) {
+            const auto begin = clauseBegin[c];
+            const auto end = clauseBegin[c + 1];
+            // cavity ratio of an occurrence: probability that the variable is forced to violate the clause, computed
+            // from the surveys of all other clauses containing the variable
+            double product = 1;
+            unsigned numZeros = 0;
+            for (auto e = begin; e < end; ++e) {
+                const double factor = 1 - surveys[e];
+                const bool zero = factor <= 0;
+                const auto l = literalIndex[e];
+                const auto n = negatedIndex[e];
+                const double same = zeros[l] > static_cast<std::uint32_t>(zero) ? 0.0 : products[l] / (zero ? 1.0 : factor);
+                const double opposite = zeros[n] > 0 ? 0.0 : products[n];
+                const double total = same + opposite - same * opposite;
+                ratios[e] = total > 0 ? (1 - opposite) * same / total : 1.0;
+                numZeros += ratios[e] <= 0;
+                product *= ratios[e] <= 0 ? 1.0 : ratios[e];
+            }
+
+            for (auto e = begin; e < end; ++e) {
+                double eta;
+                if (ratios[e] <= 0) {
+                    eta = numZeros == 1 ? product : 0.0;
+                } else {
+                    eta = numZeros > 0 ? 0.0 : product / ratios[e];
+                }
+
+                eta = config.damping * surveys[e] + (1 - config.damping) * eta;
+                maxDelta = std::max(maxDelta, std::abs(eta - surveys[e]));
+                // the new survey replaces the old one in the product of its literal
+                const auto l = literalIndex[e];
+                const double oldFactor = 1 - surveys[e];
+                const double newFactor = 1 - eta;
+                if (oldFactor <= 0) {
+                    --zeros[l];
+                } else {
+                    products[l] /= oldFactor;
+                }
+
+                if (newFactor <= 0) {
+                    ++zeros[l];
+                } else {
+                    products[l] *= newFactor;
+                }
+
+                surveys[e] = eta;
+            }
+        }
+
+        ++statistics.sweeps;
+        return maxDelta;
+    }
+
+    bool SurveyPropagation::converge() {
+        for (unsigned i = 0; i < config.maxSweeps; ++i) {
+            if (sweep() < config.epsilon) {
+                return true;
+            }
+
+            if (terminated()) {
+                break;
+            }
+        }
+
+        return false;
+    }
+
+    bool SurveyPropagation::decimate() {
+        computeLiteralProducts();
+        std::vector<std::pair<double, unsigned>> biases;
+        std::vector<char> occurs(numVariables, 0);
+        for (Literal l: literals) {
+            occurs[var(l).get()] = 1;
+        }
+
+        for (unsigned x = 0; x < numVariables; ++x) {
+            if (!occurs[x]) {
+                continue;
+            }
+
+            // pTrue / pFalse: probability that no clause containing pos(x) / neg(x) sends a warning
+            const double pTrue = zeros[pos(x).get()] > 0 ? 0.0 : products[pos(x).get()];
+            const double pFalse = zeros[neg(x).get()] > 0 ? 0.0 : products[neg(x).get()];
+            const double total = pTrue + pFalse - pTrue * pFalse;
+            if (total <= 0) {
+                continue;
+            }
+
+            const double forcedTrue = (1 - pTrue) * pFalse;
+            const double forcedFalse = (1 - pFalse) * pTrue;
+            biases.emplace_back((forcedTrue - forcedFalse) / total, x);
+        }
+
+        if (biases.empty()) {
+            return false;
+        }
+
+        const auto count = std::max<std::size_t>(1, static_cast<std::size_t>(config.fixFraction * biases.size()));
+        const auto byStrength = [](const auto &a, const auto &b) { return std::abs(a.first) > std::abs(b.first); };
+        std::ranges::partial_sort(biases, biases.begin() + static_cast<std::ptrdiff_t>(count), byStrength);
+        if (std::abs(biases.front().first) < config.trivialBias) {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < count && std::abs(biases[i].first) >= config.trivialBias; ++i) {
+            const auto [bias, x] = biases[i];
+            assignment[x] = bias > 0 ? TruthValue::True : TruthValue::False;
+            ++statistics.fixedVariables;
+        }
+
+        return true;
+    }
+
+    bool SurveyPropagation::simplify() {
+        const auto numClauses = clauseBegin.size() - 1;
+        const auto isTrue = [this](Literal l) {
+            return to_underlying(assignment[var(l).get()]) == l.sign();
+        };
+        const auto isFalse = [this](Literal l) {
+            return to_underlying(assignment[var(l).get()]) == -l.sign();
+        };
+
+        std::vector<std::uint32_t> occurrenceBegin(2 * numVariables + 1, 0);
+        std::vector<std::uint32_t> clauseOf(literals.size());
+        for (std::uint32_t c = 0; c < numClauses; ++c) {
+            for (auto e = clauseBegin[c]; e < clauseBegin[c + 1]; ++e) {
+                ++occurrenceBegin[literals[e].get() + 1];
+                clauseOf[e] = c;
+            }
+        }
+
+        for (std::size_t l = 1; l < occurrenceBegin.size(); ++l) {
+            occurrenceBegin[l] += occurrenceBegin[l - 1];
+        }
+
+        std::vector<std::uint32_t> occurrences(literals.size());
+        auto fill = occurrenceBegin;
+        for (std::uint32_t e = 0; e < literals.size(); ++e) {
+            occurrences[fill[literals[e].get()]++] = e;
+        }
+
+        // unit propagation with a counter of the non-false literals of each clause
+        std::vector<std::uint32_t> numFree(numClauses, 0);
+        std::vector<char> sat(numClauses, 0);
+        std::vector<Literal> queue;
+        const auto unit = [&](std::uint32_t c) {
+            for (auto e = clauseBegin[c]; e < clauseBegin[c + 1]; ++e) {
+                if (!isFalse(literals[e])) {
+                    return literals[e];
+                }
+            }
+
+            assert(false);
+            return Literal(0);
+        };
+
+        for (std::uint32_t c = 0; c < numClauses; ++c) {
+            for (auto e = clauseBegin[c]; e < clauseBegin[c + 1]; ++e) {
+                sat[c] |= isTrue(literals[e]);
+                numFree[c] += !isFalse(literals[e]);
+            }
+
+            if (!sat[c] && numFree[c] == 0) {
+                emptyClause = true;
+            } else if (!sat[c] && numFree[c] == 1) {
+                queue.emplace_back(unit(c));
+            }
+        }
+
+        while (!queue.empty() && !emptyClause) {
+            const auto l = queue.back();
+            queue.pop_back();
+            if (isTrue(l)) {
+                continue;
+            }
+
+            if (isFalse(l)) {
+                emptyClause = true;
+                break;
+            }
+
+            assignment[var(l).get()] = l.sign() == 1 ? TruthValue::True : TruthValue::False;
+            ++statistics.propagatedVariables;
+            for (auto i = occurrenceBegin[l.get()]; i < occurrenceBegin[l.get() + 1]; ++i) {
+                sat[clauseOf[occurrences[i]]] = 1;
+            }
+
+            const auto falsified = l.negate().get();
+            for (auto i = occurrenceBegin[falsified]; i < occurrenceBegin[falsified + 1]; ++i) {
+                const auto c = clauseOf[occurrences[i]];
+                if (sat[c]) {
+                    continue;
+                }
+
+                if (--numFree[c] == 0) {
+                    emptyClause = true;
+                    break;
+                }
+
+                if (numFree[c] == 1) {
+                    queue.emplace_back(unit(c));
+                }
+            }
+        }
+
+        if (emptyClause) {
+            statistics.contradiction = true;
+            return false;
+        }
+
+        // compaction: the surveys of the remaining occurrences are kept
+        std::uint32_t size = 0;
+        std::uint32_t numRemaining = 0;
+        for (std::uint32_t c = 0; c < numClauses; ++c) {
+            const auto begin = clauseBegin[c];
+            const auto end = clauseBegin[c + 1];
+            if (sat[c]) {
+                continue;
+            }
+
+            clauseBegin[numRemaining++] = size;
+            for (auto e = begin; e < end; ++e) {
+                if (assignment[var(literals[e]).get()] == TruthValue::Undefined) {
+                    literals[size] = literals[e];
+                    surveys[size++] = surveys[e];
+                }
+            }
+        }
+
+        clauseBegin[numRemaining] = size;
+        clauseBegin.resize(numRemaining + 1);
+        literals.erase(literals.begin() + size, literals.end());
+        surveys.resize(size);
+        ratios.resize(size);
+        literalIndex.resize(size);
+        negatedIndex.resize(size);
+        for (std::uint32_t e = 0; e < size; ++e) {
+            literalIndex[e] = static_cast<std::uint32_t>(literals[e].get());
+            negatedIndex[e] = static_cast<std::uint32_t>(literals[e].negate().get());
+        }
+
+        return true;
+    }
+
+    SolverResult SurveyPropagation::solve() {
+        if (emptyClause) {
+            return SolverResult::Unknown;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto stopClock = [this, start] {
+            statistics.time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        if (!simplify()) {
+            stopClock();
+            return SolverResult::Unknown;
+        }
+
+        while (clauseBegin.size() > 1 && !terminated()) {
+            if (!converge()) {
+                statistics.converged = false;
+                break;
+            }
+
+            if (!decimate()) {
+                break;
+            }
+
+            ++statistics.decimationSteps;
+            if (!simplify()) {
+                stopClock();
+                return SolverResult::Unknown;
+            }
+        }
+
+        stopClock();
+        const auto residual = getClauses();
+        statistics.residualClauses = residual.size();
+        std::vector<char> occurs(numVariables, 0);
+        for (Literal l: literals) {
+            occurs[var(l).get()] = 1;
+        }
+
+        statistics.residualVariables = static_cast<std::size_t>(std::ranges::count(occurs, 1));
+        if (terminated()) {
+            return SolverResult::Unknown;
+        }
+
+        // the residual formula is mostly binary and under-constrained: local search usually solves it at once
+        model = assignment;
+        LocalSearch search(residual, numVariables, {.seed = config.seed});
+        search.setTerminationFlag(terminationFlag);
+        if (search.solve(std::uint64_t{config.residualFlips} * residual.size()) == SolverResult::Sat) {
+            for (unsigned x = 0; x < numVariables; ++x) {
+                if (model[x] == TruthValue::Undefined) {
+                    model[x] = search.val(x);
+                }
+            }
+        } else {
+            Solver solver(static_cast<unsigned>(numVariables), {.elimination = true});
+            solver.setTerminationFlag(terminationFlag);
+            for (const auto &clause: residual) {
+                solver.addClause(clause);
+            }
+
+            if (solver.solve({}, config.conflictLimit) != SolverResult::Sat) {
+                model.clear();
+                return SolverResult::Unknown;
+            }
+
+            for (unsigned x = 0; x < numVariables; ++x) {
+                if (model[x] == TruthValue::Undefined) {
+                    model[x] = solver.val(x);
+                }
+            }
+        }
+
+        reconstruction.extend(model);
+        return SolverResult::Sat;
+    }
+
+    void SurveyPropagation::setTerminationFlag(const std::atomic_bool *flag) noexcept {
+        terminationFlag = flag;
+    }
+
+    TruthValue SurveyPropagation::val(Variable x) const {
+        if (x.get() >= model.size()) {
+            throw std::out_of_range("Variable index out of range");
+        }
+
+        return model[x.get()];
+    }
+
+    bool SurveyPropagation::satisfied(Literal l) const {
+        const auto value = val(var(l));
+        return (l.sign() == 1 && value == TruthValue::True) || (l.sign() == -1 && value == TruthValue::False);
+    }
+
+    auto SurveyPropagation::getModel() const -> const std::vector<TruthValue> & {
+        return model;
+    }
+
+    auto SurveyPropagation::getAssignment() const noexcept -> const std::vector<TruthValue> & {
+        return assignment;
+    }
+
+    auto SurveyPropagation::getClauses() const -> std::vector<Clause> {
+        std::vector<Clause> result;
+        result.reserve(clauseBegin.size() - 1);
+        for (std::size_t c = 0; c + 1 < clauseBegin.size(); ++c) {
+            result.emplace_back(literals.begin() + clauseBegin[c], literals.begin() + clauseBegin[c + 1]);
+        }
+
+        return result;
+    }
+
+    auto SurveyPropagation::reconstructionStack() -> ReconstructionStack & {
+        return reconstruction;
+    }
+
+    auto SurveyPropagation::getStatistics() const noexcept -> const SurveyPropagationStatistics & {
+        return statistics;
+    }
+}
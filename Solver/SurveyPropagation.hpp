@@ -0,0 +1,168 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @file SurveyPropagation.hpp
+* @brief Contains the survey propagation decimation engine for random k-SAT
+*/
+
+#ifndef SURVEYPROPAGATION_HPP
+#define SURVEYPROPAGATION_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "basic_structures.hpp"
+#include "Clause.hpp"
+#include "ReconstructionStack.hpp"
+#include "Solver.hpp"
+
+namespace sat {
+
+    /**
+     * @brief Parameters of the survey propagation decimation
+     */
+    struct SurveyPropagationConfig {
+        double epsilon = 1e-3; ///< surveys have converged once no survey changes by more than epsilon in a sweep
+        unsigned maxSweeps = 1000; ///< sweeps per decimation step before the surveys are considered divergent
+        double damping = 0.3; ///< weight of the old survey in each update (0: no damping)
+        double fixFraction = 0.01; ///< fraction of the free variables fixed per decimation step (at least one)
+        double trivialBias = 0.01; ///< decimation stops once no variable has a larger bias (paramagnetic state)
+        unsigned residualFlips = 100; ///< flip budget of the local search per clause of the residual formula
+        std::uint64_t conflictLimit = 100000; ///< conflict budget of the CDCL search if local search fails
+        unsigned seed = 0; ///< random seed of the initial surveys
+    };
+
+    /**
+     * @brief Statistics of the survey propagation decimation
+     */
+    struct SurveyPropagationStatistics {
+        std::uint64_t sweeps = 0;
+        std::uint64_t decimationSteps = 0;
+        std::uint64_t fixedVariables = 0; ///< variables fixed by their survey bias
+        std::uint64_t propagatedVariables = 0; ///< variables fixed by unit propagation after decimation
+        std::size_t residualClauses = 0; ///< clauses handed to the local search
+        std::size_t residualVariables = 0; ///< free variables occurring in the residual clauses
+        bool converged = true; ///< whether the surveys converged in every decimation step
+        bool contradiction = false; ///< whether unit propagation after decimation falsified a clause
+        double time = 0; ///< seconds spent on message passing and decimation (excluding the residual search)
+    };
+
+    /**
+     * @brief Survey propagation (SP) guided decimation for large random k-SAT instances close to the threshold.
+     * @details @copybrief
+     * A survey eta(a->i) is the probability that clause a warns variable i to satisfy it, because all other variables
+     * of a are forced to violate a. Surveys are iterated until they converge, then the variables with the largest
+     * bias |W+ - W-| are fixed to their preferred value, the formula is simplified by unit propagation and the surveys
+     * are recomputed on the remaining formula. Once the surveys become trivial (all biases are small), the residual
+     * formula is usually easy: it is handed to the LocalSearch and, if that fails, to the CDCL Solver.
+     * The surveys are stored in a flat array parallel to the literal array of the clauses, such that the surveys of a
+     * clause are contiguous and each literal occurrence has exactly one survey. For every literal, the product of
+     * (1 - eta) over its occurrences is kept as product of the non-zero factors and number of zero factors, such that
+     * the cavity product of an occurrence is obtained by one division. A sweep recomputes these products in a single
+     * pass over the occurrence arrays and then updates the surveys clause by clause in storage order, adjusting the
+     * literal products after each clause (in place updates converge where simultaneous updates of all surveys
+     * oscillate). Both passes stream through contiguous arrays.
+     * After every decimation step the formula is compacted and the surveys of the remaining occurrences are kept as
+     * starting point of the next step. The decimation cannot prove unsatisfiability.
+     */
+    class SurveyPropagation {
+        std::size_t numVariables;
+        SurveyPropagationConfig config;
+        std::vector<std::uint32_t> clauseBegin; ///< literals of clause c are literals[clauseBegin[c], clauseBegin[c + 1])
+        std::vector<Literal> literals;
+        std::vector<std::uint32_t> literalIndex; ///< literals[e].get() for every occurrence e
+        std::vector<std::uint32_t> negatedIndex; ///< literals[e].negate().get() for every occurrence e
+        std::vector<double> surveys; ///< eta of each literal occurrence
+        std::vector<double> ratios; ///< cavity ratio of each literal occurrence
+        std::vector<double> products; ///< product of the non-zero factors (1 - eta) over the occurrences of a literal
+        std::vector<std::uint32_t> zeros; ///< number of zero factors (1 - eta) over the occurrences of a literal
+        std::vector<TruthValue> assignment;
+        bool emptyClause = false;
+        std::default_random_engine rng;
+        std::vector<TruthValue> model;
+        ReconstructionStack reconstruction;
+        SurveyPropagationStatistics statistics;
+        const std::atomic_bool *terminationFlag = nullptr;
+
+        bool terminated() const;
+        double sweep();
+        bool converge();
+        void computeLiteralProducts();
+        bool decimate();
+        bool simplify();
+
+    public:
+        /**
+         * Ctor. Draws random initial surveys
+         * @param clauses clauses of the formula
+         * @param numVariables number of variables in the formula
+         * @param config decimation parameters
+         */
+        SurveyPropagation(const std::vector<Clause> &clauses, std::size_t numVariables,
+                          const SurveyPropagationConfig &config = {});
+
+        /**
+         * Runs the decimation and solves the residual formula with LocalSearch and, if the flip budget is exhausted, with
+         * the CDCL Solver
+         * @return SolverResult::Sat if a model was found (accessible via val()), SolverResult::Unknown if the
+         * decimation fixed variables inconsistently, the solver exhausted its conflict budget or the search was
+         * terminated
+         */
+        SolverResult solve();
+
+        /**
+         * Sets a flag that is polled during the search. Once the flag is set, solve() returns SolverResult::Unknown
+         * @param flag termination flag (nullptr to disable). Must outlive the search or be reset
+         */
+        void setTerminationFlag(const std::atomic_bool *flag) noexcept;
+
+        /**
+         * Gets the value of a variable in the model found by the search
+         * @param x variable
+         * @return the value of the variable
+         */
+        TruthValue val(Variable x) const;
+
+        /**
+         * Checks whether the literal is satisfied in the model
+         * @param l literal to check
+         * @return true if the literal is satisfied, false otherwise
+         */
+        bool satisfied(Literal l) const;
+
+        /**
+         * Gets the model found by the search
+         * @return vector of truth values for each variable (empty if no model was found)
+         */
+        auto getModel() const -> const std::vector<TruthValue> &;
+
+        /**
+         * Gets the assignment made by the decimation
+         * @return value of each variable fixed by decimation or unit propagation (undefined for free variables)
+         */
+        auto getAssignment() const noexcept -> const std::vector<TruthValue> &;
+
+        /**
+         * Gets the current formula, i.e. the residual formula once solve() has run
+         * @return clauses not satisfied by the decimation, restricted to their free literals
+         */
+        auto getClauses() const -> std::vector<Clause>;
+
+        /**
+         * Gets the reconstruction stack that is used to extend the model (e.g. to undo preprocessing)
+         * @return reconstruction stack of the search
+         */
+        auto reconstructionStack() -> ReconstructionStack &;
+
+        /**
+         * Gets the decimation statistics
+         * @return statistics
+         */
+        auto getStatistics() const noexcept -> const SurveyPropagationStatistics &;
+    };
+}
+
+#endif //SURVEYPROPAGATION_HPP
@@ -0,0 +1,484 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <algorithm>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include "Symmetry.hpp"
+
+namespace sat {
+    namespace {
+        /**
+         * Undirected vertex colored graph in compressed adjacency format
+         */
+        struct Graph {
+            std::vector<std::size_t> offsets;
+            std::vector<unsigned> neighbours; ///< sorted for each vertex
+            std::vector<unsigned> colors;
+            std::size_t numLiterals = 0; ///< the literals are the vertices [0, numLiterals)
+
+            std::size_t size() const noexcept {
+                return colors.size();
+            }
+
+            auto adjacent(unsigned v) const -> std::span<const unsigned> {
+                return std::span(neighbours).subspan(offsets[v], offsets[v + 1] - offsets[v]);
+            }
+
+            bool hasEdge(unsigned v, unsigned w) const {
+                return std::ranges::binary_search(adjacent(v), w);
+            }
+        };
+
+        /**
+         * Ordered partition of the vertices. Cells are contiguous ranges of elements identified by their first
+         * position
+         */
+        struct Partition {
+            std::vector<unsigned> elements; ///< vertices ordered by cell
+            std::vector<unsigned> positions; ///< position of each vertex in elements
+            std::vector<unsigned> cells; ///< first position of the cell of each vertex
+            std::vector<unsigned> ends; ///< end of the cell starting at a position
+            std::size_t numCells = 0;
+
+            bool discrete() const noexcept {
+                return numCells == elements.size();
+            }
+        };
+
+        class AutomorphismSearch {
+            const Graph &graph;
+            std::uint64_t effort;
+            std::uint64_t work = 0;
+            std::vector<unsigned> counts;
+            std::vector<unsigned> touched;
+            std::vector<unsigned> queue;
+            std::vector<char> queued;
+            std::vector<Partition> path; ///< partitions along the first path of the search tree
+            std::vector<unsigned> targets; ///< cell individualized at each level of the first path
+            std::vector<unsigned> chosen; ///< vertex individualized at each level of the first path
+            std::vector<unsigned> mapping;
+            std::vector<unsigned> orbits; ///< union-find over the orbits of the generators found so far
+            std::vector<char> failed; ///< orbits (by representative) not containing the vertex of the current level
+
+            bool exhausted() const noexcept {
+                return work > effort;
+            }
+
+            void enqueue(unsigned cell) {
+                if (!queued[cell]) {
+                    queued[cell] = 1;
+                    queue.emplace_back(cell);
+                }
+            }
+
+            /**
+             * Refines the partition until it is equitable with respect to the queued cells: all vertices of a cell have
+             * the same number of neighbours in each splitter. Cells are split in a canonical order (by count, new cells
+             * after the cell they are split from) such that isomorphic inputs yield isomorphic partitions
+             */
+            void refine(Partition &p) {
+                for (std::size_t head = 0; head < queue.size(); ++head) {
+                    const auto splitter = queue[head];
+                    queued[splitter] = 0;
+                    for (auto i = splitter; i < p.ends[splitter]; ++i) {
+                        const auto adjacent = graph.adjacent(p.elements[i]);
+                        work += adjacent.size() + 1;
+                        for (auto w: adjacent) {
+                            if (counts[w]++ == 0) {
+                                touched.emplace_back(w);
+                            }
+                        }
+                    }
+
+                    std::ranges::sort(touched, [&p, this](unsigned a, unsigned b) {
+                        return p.cells[a] < p.cells[b] || (p.cells[a] == p.cells[b] && counts[a] < counts[b]);
+                    });
+
+                    for (std::size_t first = 0, last = 0; first < touched.size(); first = last) {
+                        const auto cell = p.cells[touched[first]];
+                        while (last < touched.size() && p.cells[touched[last]] == cell) {
+                            ++last;
+                        }
+
+                        const auto end = p.ends[cell];
+                        const auto numTouched = static_cast<unsigned>(last - first);
+                        if (numTouched == end - cell && counts[touched[first]] == counts[touched[last - 1]]) {
+                            continue;
+                        }
+
+                        // the touched vertices are moved to the end of the cell in order of increasing count
+                        const auto middle = end - numTouched;
+                        for (unsigned k = 0; k < numTouched; ++k) {
+                            const auto v = touched[first + k];
+                            const auto from = p.positions[v];
+                            const auto displaced = p.elements[middle + k];
+                            p.elements[from] = displaced;
+                            p.positions[displaced] = from;
+                            p.elements[middle + k] = v;
+                            p.positions[v] = middle + k;
+                        }
+
+                        if (middle > cell) {
+                            p.ends[cell] = middle;
+                            enqueue(cell);
+                        }
+
+                        for (auto i = middle; i < end;) {
+                            auto j = i + 1;
+                            while (j < end && counts[p.elements[j]] == counts[p.elements[i]]) {
+                                ++j;
+                            }
+
+                            p.ends[i] = j;
+                            if (i != cell) {
+                                for (auto k = i; k < j; ++k) {
+                                    p.cells[p.elements[k]] = i;
+                                }
+
+                                ++p.numCells;
+                            }
+
+                            enqueue(i);
+                            i = j;
+                        }
+                    }
+
+                    for (auto w: touched) {
+                        counts[w] = 0;
+                    }
+
+                    touched.clear();
+                }
+
+                queue.clear();
+            }
+
+            /**
+             * Moves the vertex into a cell of its own in front of the rest of its cell and refines the partition
+             */
+            void individualize(Partition &p, unsigned v) {
+                const auto cell = p.cells[v];
+                const auto end = p.ends[cell];
+                const auto displaced = p.elements[cell];
+                p.elements[p.positions[v]] = displaced;
+                p.positions[displaced] = p.positions[v];
+                p.elements[cell] = v;
+                p.positions[v] = cell;
+                p.ends[cell] = cell + 1;
+                p.ends[cell + 1] = end;
+                for (auto i = cell + 1; i < end; ++i) {
+                    p.cells[p.elements[i]] = cell + 1;
+                }
+
+                ++p.numCells;
+                work += graph.size();
+                enqueue(cell);
+                refine(p);
+            }
+
+            static unsigned firstNonSingleton(const Partition &p) {
+                unsigned i = 0;
+                while (p.ends[i] - i == 1) {
+                    i = p.ends[i];
+                }
+
+                return i;
+            }
+
+            static bool compatible(const Partition &a, const Partition &b) {
+                if (a.numCells != b.numCells) {
+                    return false;
+                }
+
+                for (unsigned i = 0; i < a.elements.size(); i = a.ends[i]) {
+                    if (b.cells[b.elements[i]] != i || b.ends[i] != a.ends[i]) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * Checks whether mapping the first leaf onto the given discrete partition is an automorphism that commutes
+             * with negation. The latter is not implied since binary clauses are edges between literals as well. Only
+             * edges of moved vertices need to be checked
+             */
+            bool isAutomorphism(const Partition &leaf) {
+                const auto &first = path.back();
+                for (std::size_t i = 0; i < leaf.elements.size(); ++i) {
+                    mapping[first.elements[i]] = leaf.elements[i];
+                }
+
+                for (unsigned l = 0; l < graph.numLiterals; ++l) {
+                    if (mapping[l ^ 1] != (mapping[l] ^ 1)) {
+                        return false;
+                    }
+                }
+
+                for (unsigned v = 0; v < graph.size(); ++v) {
+                    if (mapping[v] == v) {
+                        continue;
+                    }
+
+                    const auto adjacent = graph.adjacent(v);
+                    work += adjacent.size();
+                    if (std::ranges::any_of(adjacent, [this, v](unsigned w) {
+                        return !graph.hasEdge(mapping[v], mapping[w]);
+                    })) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * Descends from a partition compatible with the first path at the given depth until a leaf yields an
+             * automorphism. The vertex individualized on the first path is tried first, which prefers sparse
+             * automorphisms
+             */
+            bool match(const Partition &right, std::size_t depth) {
+                if (right.discrete()) {
+                    return isAutomorphism(right);
+                }
+
+                const auto cell = targets[depth];
+                std::vector<unsigned> candidates(right.elements.begin() + cell,
+                                                 right.elements.begin() + right.ends[cell]);
+                if (auto it = std::ranges::find(candidates, chosen[depth]); it != candidates.end()) {
+                    std::iter_swap(candidates.begin(), it);
+                }
+
+                for (auto u: candidates) {
+                    auto next = right;
+                    individualize(next, u);
+                    if (compatible(path[depth + 1], next) && match(next, depth + 1)) {
+                        return true;
+                    }
+
+                    if (exhausted()) {
+                        return false;
+                    }
+                }
+
+                return false;
+            }
+
+            unsigned find(unsigned v) {
+                while (orbits[v] != v) {
+                    orbits[v] = orbits[orbits[v]];
+                    v = orbits[v];
+                }
+
+                return v;
+            }
+
+            void unite(unsigned v, unsigned w) {
+                v = find(v);
+                w = find(w);
+                if (v != w) {
+                    orbits[w] = v;
+                    failed[v] |= failed[w];
+                }
+            }
+
+        public:
+            AutomorphismSearch(const Graph &graph, std::uint64_t effort)
+                : graph(graph), effort(effort), counts(graph.size(), 0), queued(graph.size(), 0),
+                  mapping(graph.size()), orbits(graph.size()), failed(graph.size(), 0) {}
+
+            auto run() -> std::vector<std::vector<unsigned>> {
+                const auto n = static_cast<unsigned>(graph.size());
+                std::vector<std::vector<unsigned>> generators;
+                if (n == 0) {
+                    return generators;
+                }
+
+                Partition initial;
+                initial.elements.resize(n);
+                std::iota(initial.elements.begin(), initial.elements.end(), 0u);
+                std::ranges::stable_sort(initial.elements, {}, [this](unsigned v) { return graph.colors[v]; });
+                initial.positions.resize(n);
+                initial.cells.resize(n);
+                initial.ends.resize(n);
+                for (unsigned i = 0, start = 0; i < n; ++i) {
+                    const auto v = initial.elements[i];
+                    if (graph.colors[v] != graph.colors[initial.elements[start]]) {
+                        start = i;
+                    }
+
+                    initial.positions[v] = i;
+                    initial.cells[v] = start;
+                    if (start == i) {
+                        enqueue(start);
+                        ++initial.numCells;
+                    }
+
+                    initial.ends[start] = i + 1;
+                }
+
+                refine(initial);
+                path.emplace_back(std::move(initial));
+                while (!path.back().discrete() && !exhausted()) {
+                    targets.emplace_back(firstNonSingleton(path.back()));
+                    chosen.emplace_back(path.back().elements[targets.back()]);
+                    auto next = path.back();
+                    individualize(next, chosen.back());
+                    path.emplace_back(std::move(next));
+                }
+
+                if (exhausted()) {
+                    return generators;
+                }
+
+                std::iota(orbits.begin(), orbits.end(), 0u);
+                for (auto depth = targets.size(); depth-- > 0;) {
+                    std::ranges::fill(failed, 0);
+                    const auto &level = path[depth];
+                    const auto v = chosen[depth];
+                    for (auto i = targets[depth]; i < level.ends[targets[depth]]; ++i) {
+                        const auto w = level.elements[i];
+                        if (find(w) == find(v) || failed[find(w)]) {
+                            continue;
+                        }
+
+                        auto right = level;
+                        individualize(right, w);
+                        if (compatible(path[depth + 1], right) && match(right, depth + 1)) {
+                            generators.emplace_back(mapping);
+                            for (unsigned x = 0; x < n; ++x) {
+                                unite(x, mapping[x]);
+                            }
+                        } else if (exhausted()) {
+                            return generators;
+                        } else {
+                            failed[find(w)] = 1;
+                        }
+                    }
+                }
+
+                return generators;
+            }
+        };
+    }
+
+    auto findSymmetries(const std::vector<Clause> &clauses, std::size_t numVariables, const std::vector<char> &fixed,
+                        std::uint64_t effort) -> std::vector<LiteralPermutation> {
+        // literal vertices first, then one vertex per clause. Binary clauses are edges between their literals. Colors:
+        // 0 for movable literals, 1 for clauses and a unique color for each literal of a fixed or unused variable
+        const auto numLiterals = 2 * numVariables;
+        std::vector<std::vector<unsigned>> adjacency(numLiterals);
+        for (const auto &clause: clauses) {
+            if (clause.size() == 2) {
+                adjacency[clause[0].get()].emplace_back(clause[1].get());
+                adjacency[clause[1].get()].emplace_back(clause[0].get());
+                continue;
+            }
+
+            const auto vertex = static_cast<unsigned>(adjacency.size());
+            auto &neighbours = adjacency.emplace_back();
+            for (Literal l: clause) {
+                neighbours.emplace_back(l.get());
+                adjacency[l.get()].emplace_back(vertex);
+            }
+        }
+
+        Graph graph;
+        graph.numLiterals = numLiterals;
+        graph.colors.assign(adjacency.size(), 1);
+        unsigned nextColor = 2;
+        for (unsigned x = 0; x < numVariables; ++x) {
+            adjacency[pos(x).get()].emplace_back(neg(x).get());
+            adjacency[neg(x).get()].emplace_back(pos(x).get());
+            const bool unused = adjacency[pos(x).get()].size() == 1 && adjacency[neg(x).get()].size() == 1;
+            if (unused || (x < fixed.size() && fixed[x])) {
+                graph.colors[pos(x).get()] = nextColor++;
+                graph.colors[neg(x).get()] = nextColor++;
+            } else {
+                graph.colors[pos(x).get()] = graph.colors[neg(x).get()] = 0;
+            }
+        }
+
+        graph.offsets.reserve(adjacency.size() + 1);
+        graph.offsets.emplace_back(0);
+        for (auto &neighbours: adjacency) {
+            std::ranges::sort(neighbours);
+            const auto [first, last] = std::ranges::unique(neighbours);
+            graph.neighbours.insert(graph.neighbours.end(), neighbours.begin(), first);
+            graph.offsets.emplace_back(graph.neighbours.size());
+        }
+
+        adjacency.clear();
+        std::vector<LiteralPermutation> symmetries;
+        for (const auto &generator: AutomorphismSearch(graph, effort).run()) {
+            LiteralPermutation permutation;
+            permutation.reserve(numLiterals);
+            bool moved = false;
+            for (unsigned l = 0; l < numLiterals; ++l) {
+                permutation.emplace_back(generator[l]);
+                moved |= generator[l] != l;
+            }
+
+            // automorphisms only permuting clauses stem from duplicate clauses
+            if (moved) {
+                symmetries.emplace_back(std::move(permutation));
+            }
+        }
+
+        return symmetries;
+    }
+
+    auto lexLeaderClauses(const LiteralPermutation &permutation, std::size_t &numVariables,
+                          unsigned maxLength) -> std::vector<Clause> {
+        std::vector<Clause> clauses;
+        std::optional<Literal> equal; ///< implied while all previous positions are equal, none for the first one
+        std::optional<std::pair<Literal, Literal>> previous;
+        unsigned length = 0;
+        for (unsigned x = 0; 2 * x < permutation.size() && length < maxLength; ++x) {
+            const auto image = permutation[pos(x).get()];
+            // for a 2-cycle (x' x), the position of x is equal if the position of x' was
+            if (image == pos(x) || (var(image).get() < x && permutation[image.get()] == pos(x))) {
+                continue;
+            }
+
+            if (previous) {
+                // equal ∧ (x' = σ(x')) → equal'. Given x' <= σ(x'), the positions are equal if x' is true or σ(x') is
+                // false
+                const Literal next = pos(static_cast<unsigned>(numVariables++));
+                const auto [lastLiteral, lastImage] = *previous;
+                for (Literal l: {lastLiteral.negate(), lastImage}) {
+                    auto &clause = clauses.emplace_back(Clause{l, next});
+                    if (equal) {
+                        clause.emplace_back(equal->negate());
+                    }
+                }
+
+                equal = next;
+            }
+
+            // equal → x <= σ(x)
+            auto &clause = clauses.emplace_back(image == neg(x) ? Clause{neg(x)} : Clause{neg(x), image});
+            if (equal) {
+                clause.emplace_back(equal->negate());
+            }
+
+            // x < σ(x) is the only option if σ(x) = ¬x, the following positions are not compared
+            if (image == neg(x)) {
+                break;
+            }
+
+            previous.emplace(pos(x), image);
+            ++length;
+        }
+
+        return clauses;
+    }
+}
@@ -0,0 +1,62 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @file Symmetry.hpp
+* @brief Contains the detection of the symmetries of a formula and their lex-leader symmetry-breaking clauses
+*/
+
+#ifndef SYMMETRY_HPP
+#define SYMMETRY_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "basic_structures.hpp"
+#include "Clause.hpp"
+
+namespace sat {
+    /**
+     * Permutation of the literals of a formula: the image of literal l is permutation[l.get()]. The image of ¬l is
+     * always the negation of the image of l
+     */
+    using LiteralPermutation = std::vector<Literal>;
+
+    /**
+     * Computes generators of the automorphism group of the colored literal graph of the formula.
+     * @details @copybrief
+     * The graph has a vertex per literal and per clause of size other than two. Each clause is connected to its
+     * literals, the literals of binary clauses are connected directly and each literal is connected to its negation.
+     * Automorphisms of the graph which preserve the vertex colors (literals, clauses and a unique color for each
+     * literal of a fixed variable) and commute with negation are exactly the symmetries of the formula. The generators
+     * are found by an individualization-refinement search: the partition of the vertices is refined to an equitable
+     * partition by counting neighbours in splitter cells. Along the first path of the search tree, the first vertex of
+     * the first non-singleton cell is individualized until the partition is discrete. Then, for every level from the
+     * bottom up, the other vertices of the individualized cell that are not yet known to be in the same orbit are tried
+     * and the search descends until a discrete partition is reached whose mapping to the first leaf is a symmetry.
+     * @param clauses clauses of the formula
+     * @param numVariables number of variables
+     * @param fixed variables that must not be moved by the symmetries (e.g. assigned or frozen variables), may be
+     * empty
+     * @param effort maximum number of edge visits of the search. The generators found so far are returned if the
+     * budget is exhausted
+     * @return symmetries of the formula, each moves at least one literal
+     */
+    auto findSymmetries(const std::vector<Clause> &clauses, std::size_t numVariables, const std::vector<char> &fixed,
+                        std::uint64_t effort) -> std::vector<LiteralPermutation>;
+
+    /**
+     * Lex-leader symmetry-breaking clauses for a symmetry σ: the assignment (x1, ..., xn) must be lexicographically
+     * at most (σ(x1), ..., σ(xn)) with variables ordered by index. Every orbit of assignments under the symmetry group
+     * contains an assignment satisfying the clauses of all its generators, so satisfiability is preserved. Uses the
+     * linear encoding with an auxiliary variable per compared position, which is implied while all previous positions
+     * are equal. The second variable of a 2-cycle is not compared since its position is equal if the first one is
+     * @param permutation a symmetry of the formula
+     * @param numVariables number of variables, incremented for each auxiliary variable
+     * @param maxLength maximum number of compared positions
+     * @return symmetry-breaking clauses
+     */
+    auto lexLeaderClauses(const LiteralPermutation &permutation, std::size_t &numVariables,
+                          unsigned maxLength) -> std::vector<Clause>;
+}
+
+#endif //SYMMETRY_HPP
@@ -0,0 +1,264 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <algorithm>
+#include <bit>
+
+#include "XorConstraints.hpp"
+
+namespace sat {
+    auto findXors(const std::vector<Clause> &clauses, unsigned maxSize) -> std::vector<XorConstraint> {
+        struct Candidate {
+            std::vector<unsigned> variables;
+            unsigned negations; ///< bit i is set if the literal of the i-th variable is negative
+            std::size_t index;
+        };
+
+        std::vector<Candidate> candidates;
+        for (std::size_t i = 0; i < clauses.size(); ++i) {
+            if (clauses[i].size() < 3 || clauses[i].size() > maxSize) {
+                continue;
+            }
+
+            auto literals = clauses[i];
+            std::ranges::sort(literals, {}, [](Literal l) { return l.get(); });
+            Candidate candidate{.variables = {}, .negations = 0, .index = i};
+            for (Literal l: literals) {
+                if (!candidate.variables.empty() && candidate.variables.back() == var(l).get()) {
+                    break;
+                }
+
+                if (l.sign() < 0) {
+                    candidate.negations |= 1u << candidate.variables.size();
+                }
+
+                candidate.variables.emplace_back(var(l).get());
+            }
+
+            if (candidate.variables.size() == literals.size()) {
+                candidates.emplace_back(std::move(candidate));
+            }
+        }
+
+        std::ranges::sort(candidates, [](const auto &a, const auto &b) {
+            return a.variables < b.variables || (a.variables == b.variables && a.negations < b.negations);
+        });
+
+        std::vector<XorConstraint> xors;
+        for (std::size_t first = 0, last = 0; first < candidates.size(); first = last) {
+            while (last < candidates.size() && candidates[last].variables == candidates[first].variables) {
+                ++last;
+            }
+
+            // a clause excludes the assignment that sets exactly its negative variables to true. The constraint with
+            // the given parity needs the clauses excluding all 2^(k-1) assignments of the opposite parity
+            const auto &variables = candidates[first].variables;
+            const auto needed = std::size_t{1} << (variables.size() - 1);
+            for (bool parity: {false, true}) {
+                XorConstraint constraint{.variables = variables, .parity = parity, .clauses = {}};
+                for (auto i = first; i < last; ++i) {
+                    const bool excludedParity = std::popcount(candidates[i].negations) % 2 == 1;
+                    if (excludedParity != parity &&
+                        (i == first || candidates[i].negations != candidates[i - 1].negations)) {
+                        constraint.clauses.emplace_back(candidates[i].index);
+                    }
+                }
+
+                if (constraint.clauses.size() == needed) {
+                    xors.emplace_back(std::move(constraint));
+                }
+            }
+        }
+
+        return xors;
+    }
+
+    GaussianElimination::GaussianElimination(const std::vector<XorConstraint> &constraints, std::size_t numVariables)
+        : columns(numVariables, NoColumn), numRows(constraints.size()), parities(constraints.size()),
+          basicColumns(constraints.size(), NoColumn), dirty(constraints.size(), 0) {
+        for (const auto &constraint: constraints) {
+            for (auto x: constraint.variables) {
+                if (columns[x] == NoColumn) {
+                    columns[x] = static_cast<unsigned>(variables.size());
+                    variables.emplace_back(x);
+                }
+            }
+        }
+
+        words = (variables.size() + 63) / 64;
+        rows.resize(numRows * words, 0);
+        for (std::size_t r = 0; r < numRows; ++r) {
+            for (auto x: constraints[r].variables) {
+                rows[r * words + columns[x] / 64] |= std::uint64_t{1} << (columns[x] % 64);
+            }
+
+            parities[r] = constraints[r].parity;
+        }
+
+        basicRows.assign(variables.size(), NoRow);
+        freeColumns.assign(words, 0);
+        trueColumns.assign(words, 0);
+        for (std::size_t c = 0; c < variables.size(); ++c) {
+            freeColumns[c / 64] |= std::uint64_t{1} << (c % 64);
+        }
+
+        // the earlier pivot steps removed their basic columns from the row, any of its columns may become basic
+        for (unsigned r = 0; r < numRows; ++r) {
+            markDirty(r);
+            const auto *row = rows.data() + static_cast<std::size_t>(r) * words;
+            for (std::size_t w = 0; w < words; ++w) {
+                if (row[w] != 0) {
+                    pivot(r, static_cast<unsigned>(64 * w) + static_cast<unsigned>(std::countr_zero(row[w])));
+                    break;
+                }
+            }
+        }
+    }
+
+    bool GaussianElimination::contains(Variable x) const noexcept {
+        return x.get() < columns.size() && columns[x.get()] != NoColumn;
+    }
+
+    std::size_t GaussianElimination::size() const noexcept {
+        return numRows;
+    }
+
+    void GaussianElimination::markDirty(unsigned row) {
+        if (!dirty[row]) {
+            dirty[row] = 1;
+            dirtyRows.emplace_back(row);
+        }
+    }
+
+    void GaussianElimination::pivot(unsigned row, unsigned column) {
+        const auto word = column / 64;
+        const auto bit = std::uint64_t{1} << (column % 64);
+        const auto *pivotRow = rows.data() + static_cast<std::size_t>(row) * words;
+        // the basic columns of the other rows do not occur in the pivot row and stay basic
+        for (unsigned other = 0; other < numRows; ++other) {
+            auto *current = rows.data() + static_cast<std::size_t>(other) * words;
+            if (other != row && (current[word] & bit) != 0) {
+                for (std::size_t w = 0; w < words; ++w) {
+                    current[w] ^= pivotRow[w];
+                }
+
+                parities[other] ^= parities[row];
+                markDirty(other);
+            }
+        }
+
+        if (basicColumns[row] != NoColumn) {
+            basicRows[basicColumns[row]] = NoRow;
+        }
+
+        basicColumns[row] = column;
+        basicRows[column] = row;
+    }
+
+    void GaussianElimination::assign(Literal l) {
+        if (!contains(var(l))) {
+            return;
+        }
+
+        const auto column = columns[var(l).get()];
+        const auto bit = std::uint64_t{1} << (column % 64);
+        freeColumns[column / 64] &= ~bit;
+        if (l.sign() > 0) {
+            trueColumns[column / 64] |= bit;
+        }
+
+        assigned.emplace_back(column);
+    }
+
+    void GaussianElimination::unassign(Variable x) {
+        if (!contains(x)) {
+            return;
+        }
+
+        const auto column = columns[x.get()];
+        const auto bit = std::uint64_t{1} << (column % 64);
+        freeColumns[column / 64] |= bit;
+        trueColumns[column / 64] &= ~bit;
+    }
+
+    void GaussianElimination::rowClause(const std::uint64_t *row, unsigned skipped, Clause &clause) const {
+        for (std::size_t w = 0; w < words; ++w) {
+            for (auto bits = row[w]; bits != 0; bits &= bits - 1) {
+                const auto column = static_cast<unsigned>(64 * w) + static_cast<unsigned>(std::countr_zero(bits));
+                if (column != skipped) {
+                    const auto x = variables[column];
+                    clause.emplace_back((trueColumns[w] >> (column % 64)) & 1 ? neg(x) : pos(x));
+                }
+            }
+        }
+    }
+
+    bool GaussianElimination::propagate(std::vector<Clause> &implications, Clause &conflict) {
+        implications.clear();
+        for (auto column: assigned) {
+            const auto r = basicRows[column];
+            if (r == NoRow) {
+                continue;
+            }
+
+            const auto *row = rows.data() + static_cast<std::size_t>(r) * words;
+            for (std::size_t w = 0; w < words; ++w) {
+                if (const auto free = row[w] & freeColumns[w]; free != 0) {
+                    pivot(r, static_cast<unsigned>(64 * w) + static_cast<unsigned>(std::countr_zero(free)));
+                    break;
+                }
+            }
+        }
+
+        // only rows containing a newly assigned column or changed by a pivot step can have lost unassigned variables
+        for (auto column: assigned) {
+            const auto word = column / 64;
+            const auto bit = std::uint64_t{1} << (column % 64);
+            for (unsigned r = 0; r < numRows; ++r) {
+                if ((rows[static_cast<std::size_t>(r) * words + word] & bit) != 0) {
+                    markDirty(r);
+                }
+            }
+        }
+
+        assigned.clear();
+        for (auto r: dirtyRows) {
+            dirty[r] = 0;
+        }
+
+        for (auto r: dirtyRows) {
+            const auto *row = rows.data() + static_cast<std::size_t>(r) * words;
+            unsigned numFree = 0;
+            unsigned freeColumn = 0;
+            bool residual = parities[r];
+            for (std::size_t w = 0; w < words; ++w) {
+                const auto free = row[w] & freeColumns[w];
+                if (free != 0) {
+                    freeColumn = static_cast<unsigned>(64 * w) + static_cast<unsigned>(std::countr_zero(free));
+                }
+
+                numFree += static_cast<unsigned>(std::popcount(free));
+                residual ^= std::popcount(row[w] & trueColumns[w]) % 2 == 1;
+            }
+
+            if (numFree == 0 && residual) {
+                conflict.clear();
+                rowClause(row, NoColumn, conflict);
+                dirtyRows.clear();
+                return false;
+            }
+
+            if (numFree == 1) {
+                const auto x = variables[freeColumn];
+                auto &reason = implications.emplace_back(Clause{residual ? pos(x) : neg(x)});
+                rowClause(row, freeColumn, reason);
+            }
+        }
+
+        dirtyRows.clear();
+        return true;
+    }
+}
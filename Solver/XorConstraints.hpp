@@ -0,0 +1,115 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @file XorConstraints.hpp
+* @brief Contains the detection of XOR constraints encoded as clauses and their Gauss-Jordan elimination
+*/
+
+#ifndef XORCONSTRAINTS_HPP
+#define XORCONSTRAINTS_HPP
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "basic_structures.hpp"
+#include "Clause.hpp"
+
+namespace sat {
+    /**
+     * @brief XOR constraint x1 ^ ... ^ xk = parity
+     */
+    struct XorConstraint {
+        std::vector<unsigned> variables; ///< distinct variables in increasing order
+        bool parity;
+        std::vector<std::size_t> clauses; ///< indices of the clauses encoding the constraint
+    };
+
+    /**
+     * Finds XOR constraints encoded by the clauses. A constraint over k variables is found if all 2^(k-1) clauses
+     * excluding the assignments of the wrong parity are present
+     * @param clauses clauses of the formula
+     * @param maxSize largest number of variables of a constraint
+     * @return constraints with at least 3 variables together with their encoding clauses. Each clause belongs to at
+     * most one constraint
+     */
+    auto findXors(const std::vector<Clause> &clauses, unsigned maxSize) -> std::vector<XorConstraint>;
+
+    /**
+     * @brief Propagation on a system of XOR constraints by Gauss-Jordan elimination over GF(2).
+     * @details @copybrief
+     * Each constraint is a row of a bit-packed matrix (one column per variable occurring in a constraint). The matrix
+     * is kept eliminated: each row has a basic column that occurs in no other row. Once the basic variable of a row is
+     * assigned, an unassigned variable of the row becomes basic by one elimination step. A row without unassigned
+     * variables whose assigned variables have the wrong parity is then a conflict and a row with a single unassigned
+     * variable implies its value. Since every row is a sum of constraints, the reason of such an implication (or
+     * conflict) is the clause falsified by the assigned variables of the row. With unassigned basic columns, this finds
+     * every implication and conflict of the linear system. Row operations keep the system equivalent and a row only
+     * keeps an assigned basic variable if none of its variables is assigned on a higher decision level, so backtracking
+     * just retracts the assignment.
+     */
+    class GaussianElimination {
+        static constexpr unsigned NoColumn = std::numeric_limits<unsigned>::max();
+        static constexpr unsigned NoRow = std::numeric_limits<unsigned>::max();
+        std::vector<unsigned> columns; ///< column of each variable (NoColumn if it occurs in no constraint)
+        std::vector<unsigned> variables; ///< variable of each column
+        std::size_t words;
+        std::size_t numRows;
+        std::vector<std::uint64_t> rows; ///< row r is rows[r * words, (r + 1) * words)
+        std::vector<char> parities;
+        std::vector<unsigned> basicColumns; ///< basic column of each row (NoColumn if the row is empty)
+        std::vector<unsigned> basicRows; ///< row of each basic column (NoRow for other columns)
+        std::vector<std::uint64_t> freeColumns; ///< unassigned columns
+        std::vector<std::uint64_t> trueColumns; ///< columns assigned to true
+        std::vector<unsigned> assigned; ///< columns assigned since the last call to propagate()
+        std::vector<unsigned> dirtyRows; ///< rows that may imply a literal or be in conflict
+        std::vector<char> dirty;
+
+        void markDirty(unsigned row);
+        void pivot(unsigned row, unsigned column);
+        void rowClause(const std::uint64_t *row, unsigned skipped, Clause &clause) const;
+
+    public:
+        /**
+         * Ctor. Eliminates the constraints with all variables unassigned
+         * @param constraints XOR constraints
+         * @param numVariables number of variables in the formula
+         */
+        GaussianElimination(const std::vector<XorConstraint> &constraints, std::size_t numVariables);
+
+        /**
+         * Checks whether a variable occurs in a constraint
+         * @param x variable
+         * @return true if the variable is a column of the matrix, false otherwise
+         */
+        bool contains(Variable x) const noexcept;
+
+        /**
+         * Assigns a literal. Literals of variables that occur in no constraint are ignored
+         * @param l literal that became true
+         */
+        void assign(Literal l);
+
+        /**
+         * Retracts the assignment of a variable on backtracking
+         * @param x variable
+         */
+        void unassign(Variable x);
+
+        /**
+         * Updates the matrix with the literals assigned since the last call and derives the resulting implications
+         * @param implications output: clauses whose first literal is implied, all other literals are false
+         * @param conflict output: clause falsified by the assignment (only set if the assignment is inconsistent)
+         * @return false if the constraints are inconsistent with the assignment, true otherwise
+         */
+        bool propagate(std::vector<Clause> &implications, Clause &conflict);
+
+        /**
+         * Number of constraints
+         * @return number of rows of the matrix
+         */
+        std::size_t size() const noexcept;
+    };
+}
+
+#endif //XORCONSTRAINTS_HPP
@@ -31,7 +31,7 @@ namespace sat {
     }
 
     Literal Literal::negate() const {
-        return Literal(this->lit + 1);
+        return Literal(this->lit ^ 1u);
     }
 
     short Literal::sign() const {
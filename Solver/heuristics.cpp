@@ -21,6 +21,123 @@ namespace sat {
         throw std::runtime_error("Found no open variable");
     }
 
+    VSIDS::VSIDS(std::size_t numVariables, double decay) : activity(numVariables, 0), position(numVariables, -1),
+                                                           decayFactor(decay) {
+        heap.reserve(numVariables);
+        for (unsigned x = 0; x < numVariables; ++x) {
+            insert(x);
+        }
+    }
+
+    bool VSIDS::higher(unsigned a, unsigned b) const {
+        return activity[a] > activity[b];
+    }
+
+    void VSIDS::siftUp(std::size_t pos) {
+        const unsigned x = heap[pos];
+        while (pos > 0) {
+            const std::size_t parent = (pos - 1) / 2;
+            if (not higher(x, heap[parent])) {
+                break;
+            }
+
+            heap[pos] = heap[parent];
+            position[heap[pos]] = static_cast<int>(pos);
+            pos = parent;
+        }
+
+        heap[pos] = x;
+        position[x] = static_cast<int>(pos);
+    }
+
+    void VSIDS::siftDown(std::size_t pos) {
+        const unsigned x = heap[pos];
+        while (true) {
+            std::size_t child = 2 * pos + 1;
+            if (child >= heap.size()) {
+                break;
+            }
+
+            if (child + 1 < heap.size() && higher(heap[child + 1], heap[child])) {
+                ++child;
+            }
+
+            if (not higher(heap[child], x)) {
+                break;
+            }
+
+            heap[pos] = heap[child];
+            position[heap[pos]] = static_cast<int>(pos);
+            pos = child;
+        }
+
+        heap[pos] = x;
+        position[x] = static_cast<int>(pos);
+    }
+
+    void VSIDS::bump(Variable x) {
+        bump(x, 1);
+    }
+
+    void VSIDS::bump(Variable x, double factor) {
+        const auto id = x.get();
+        if ((activity[id] += factor * increment) > 1e100) {
+            for (auto &a: activity) {
+                a *= 1e-100;
+            }
+
+            increment *= 1e-100;
+        }
+
+        if (position[id] >= 0) {
+            siftUp(static_cast<std::size_t>(position[id]));
+        }
+    }
+
+    void VSIDS::decay() {
+        increment /= decayFactor;
+    }
+
+    void VSIDS::insert(Variable x) {
+        const auto id = x.get();
+        if (position[id] >= 0) {
+            return;
+        }
+
+        heap.emplace_back(id);
+        siftUp(heap.size() - 1);
+    }
+
+    Variable VSIDS::addVariable() {
+        const auto id = static_cast<unsigned>(activity.size());
+        activity.emplace_back(0);
+        position.emplace_back(-1);
+        insert(id);
+        return id;
+    }
+
+    double VSIDS::getActivity(Variable x) const {
+        return activity[x.get()];
+    }
+
+    Variable VSIDS::operator()(const std::vector<TruthValue> &model, std::size_t) {
+        while (not heap.empty()) {
+            const unsigned top = heap.front();
+            if (model[top] == TruthValue::Undefined) {
+                return top;
+            }
+
+            position[top] = -1;
+            heap.front() = heap.back();
+            heap.pop_back();
+            if (not heap.empty()) {
+                siftDown(0);
+            }
+        }
+
+        throw std::runtime_error("Found no open variable");
+    }
+
     Variable Heuristic::operator()(const std::vector<TruthValue> &values, std::size_t numOpenVariables) const {
         if (nullptr == impl) {
             throw BadHeuristicCall("heuristic wrapper does not contain a heuristic");
@@ -30,6 +30,74 @@ namespace sat {
         Variable operator()(const std::vector<TruthValue> &model, std::size_t) const;
     };
 
+    /**
+     * @brief Variable State Independent Decaying Sum heuristic. Selects the unassigned variable with the highest
+     * activity.
+     * @details @copybrief
+     * Activities are kept in a binary max-heap indexed by variable. The solver bumps the activity of all variables
+     * that take part in a conflict and decays all activities afterwards (implemented by growing the bump increment).
+     * Assigned variables are removed lazily when selecting and must be reinserted using insert() when they are
+     * unassigned.
+     */
+    class VSIDS {
+        std::vector<double> activity;
+        std::vector<unsigned> heap;
+        std::vector<int> position;
+        double increment = 1;
+        double decayFactor;
+
+        bool higher(unsigned a, unsigned b) const;
+        void siftUp(std::size_t pos);
+        void siftDown(std::size_t pos);
+
+    public:
+        /**
+         * Ctor
+         * @param numVariables number of variables in the problem
+         * @param decay activity decay factor in (0, 1)
+         */
+        explicit VSIDS(std::size_t numVariables, double decay = 0.95);
+
+        /**
+         * Increases the activity of the given variable
+         * @param x variable to bump
+         */
+        void bump(Variable x);
+
+        /**
+         * Increases the activity of the given variable by a fraction of the current increment
+         * @param x variable to bump
+         * @param factor fraction of the increment to add
+         */
+        void bump(Variable x, double factor);
+
+        /**
+         * Decays the activities of all variables
+         */
+        void decay();
+
+        /**
+         * (Re)inserts a variable into the selection heap. Does nothing if the variable is already contained
+         * @param x variable to insert
+         */
+        void insert(Variable x);
+
+        /**
+         * Adds a new variable with zero activity
+         * @return the new variable
+         */
+        Variable addVariable();
+
+        /**
+         * Gets the activity of a variable
+         * @param x variable
+         * @return current activity of x
+         */
+        double getActivity(Variable x) const;
+
+        Variable operator()(const std::vector<TruthValue> &model, std::size_t numOpenVariables);
+    };
+
     namespace detail {
         /**
          * @brief This is a helper class for the implementation of a type erasure heuristic wrapper
@@ -4,6 +4,7 @@
 * @brief
 */
 
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 
@@ -91,6 +92,57 @@ namespace sat::inout {
 
         return {std::move(ret), numVars};
     }
+
+    auto read_from_icnf(std::istream &in)
+        -> std::tuple<std::vector<std::vector<Literal>>, std::vector<std::vector<Literal>>, std::size_t> {
+        std::string line;
+        std::vector<std::vector<Literal>> clauses;
+        std::vector<std::vector<Literal>> cubes;
+        std::size_t numVars = 0;
+        bool header = false;
+        while (std::getline(in, line)) {
+            if (line.empty()) {
+                continue;
+            }
+
+            if (line.starts_with("c")) {
+                std::stringstream ss(line.substr(1));
+                std::string key;
+                std::size_t count;
+                if (ss >> key >> count && key == "variables") {
+                    numVars = std::max(numVars, count);
+                }
+
+                continue;
+            }
+
+            if (line.starts_with("p")) {
+                if (line.find("inccnf") == std::string::npos) {
+                    throw std::runtime_error("invalid format");
+                }
+
+                header = true;
+                continue;
+            }
+
+            if (not header) {
+                throw std::runtime_error("missing header");
+            }
+
+            const bool cube = line.starts_with("a");
+            std::stringstream ss(cube ? line.substr(1) : line);
+            std::vector<Literal> lits;
+            int val;
+            while (ss >> val && val != 0) {
+                numVars = std::max<std::size_t>(numVars, std::abs(val));
+                lits.emplace_back(from_dimacs(val));
+            }
+
+            (cube ? cubes : clauses).emplace_back(std::move(lits));
+        }
+
+        return {std::move(clauses), std::move(cubes), numVars};
+    }
 }
 
 namespace sat {
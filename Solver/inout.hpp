@@ -13,6 +13,7 @@
 #include <vector>
 #include <iterator>
 #include <sstream>
+#include <tuple>
 
 #include "basic_structures.hpp"
 #include "Clause.hpp"
@@ -45,6 +46,17 @@ namespace sat::inout {
      */
     auto read_from_dimacs(std::istream &in) -> std::pair<std::vector<std::vector<Literal>>, std::size_t>;
 
+    /**
+     * Reads an incremental SAT problem in iCNF format (clauses followed by lines "a <literals> 0" each containing a
+     * cube of assumptions)
+     * @param in input stream to read from
+     * @return std::tuple containing (all clauses of the problem, all cubes in file order, the number of variables).
+     * The number of variables is the largest variable in the file or the count of a comment line "c variables <n>"
+     * (see to_icnf()) if that is larger
+     */
+    auto read_from_icnf(std::istream &in)
+        -> std::tuple<std::vector<std::vector<Literal>>, std::vector<std::vector<Literal>>, std::size_t>;
+
     /**
      * Converts a range of clauses to dimacs format
      * @tparam R clause range type
@@ -86,6 +98,47 @@ namespace sat::inout {
         return ss.str();
     }
 
+    /**
+     * Converts a formula and a list of cubes to iCNF format ("p inccnf" header, clauses, then one "a <literals> 0"
+     * line per cube)
+     * @tparam R clause range type
+     * @tparam C cube range type
+     * @param clauses A range of clauses
+     * @param cubes A range of cubes
+     * @param numVariables number of variables of the formula, written as comment line "c variables <n>" since the
+     * header has no variable count (0: no such line). Otherwise, variables that occur in no clause are lost
+     * @return iCNF string
+     */
+    template<std::ranges::range R, std::ranges::range C>
+    std::string to_icnf(const R &clauses, const C &cubes, std::size_t numVariables = 0) {
+        static_assert(clause_like<std::ranges::range_value_t<R>> && clause_like<std::ranges::range_value_t<C>>,
+                      "The ranges you passed to this function do not hold elements that are clause-like");
+        std::stringstream ss;
+        ss << "p inccnf" << std::endl;
+        if (numVariables > 0) {
+            ss << "c variables " << numVariables << std::endl;
+        }
+
+        for (const auto &clause: clauses) {
+            for (auto l: clause) {
+                ss << to_dimacs(l) << " ";
+            }
+
+            ss << "0" << std::endl;
+        }
+
+        for (const auto &cube: cubes) {
+            ss << "a ";
+            for (auto l: cube) {
+                ss << to_dimacs(l) << " ";
+            }
+
+            ss << "0" << std::endl;
+        }
+
+        return ss.str();
+    }
+
     /**
      * Converts a range of literals to dimacs format
      * @tparam L Literal range type
@@ -0,0 +1,146 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "ipasir.h"
+#include "ClauseSharing.hpp"
+#include "inout.hpp"
+#include "Solver.hpp"
+
+namespace {
+    /**
+     * @brief Forwards the clauses learned by the solver to the IPASIR learn callback
+     */
+    class LearnCallback : public sat::ClauseSharing {
+        void *data;
+        std::size_t maxLength;
+        void (*learn)(void *, int32_t *);
+        std::vector<int32_t> buffer;
+
+    public:
+        LearnCallback(void *data, std::size_t maxLength, void (*learn)(void *, int32_t *))
+            : data(data), maxLength(maxLength), learn(learn) {}
+
+        void exportClause(const sat::Clause &clause, unsigned) override {
+            if (clause.size() > maxLength) {
+                return;
+            }
+
+            buffer.clear();
+            for (sat::Literal l: clause) {
+                buffer.emplace_back(sat::inout::to_dimacs(l));
+            }
+
+            buffer.emplace_back(0);
+            learn(data, buffer.data());
+        }
+
+        void importClauses(std::vector<SharedClause> &) override {}
+    };
+
+    /**
+     * @brief State of an IPASIR solver instance
+     */
+    struct IpasirSolver {
+        sat::Solver solver{0, sat::SolverConfig{.elimination = false}};
+        sat::Clause clause;
+        sat::Cube assumptions;
+        std::unique_ptr<LearnCallback> learnCallback;
+
+        sat::Literal literal(int32_t lit) {
+            const auto l = sat::inout::from_dimacs(lit);
+            while (var(l).get() >= solver.getNumVariables()) {
+                solver.addVariable();
+            }
+
+            return l;
+        }
+    };
+
+    IpasirSolver &get(void *solver) {
+        return *static_cast<IpasirSolver *>(solver);
+    }
+}
+
+extern "C" {
+    const char *ipasir_signature() {
+        return "SimpleSatSolver";
+    }
+
+    void *ipasir_init() {
+        return new IpasirSolver;
+    }
+
+    void ipasir_release(void *solver) {
+        delete static_cast<IpasirSolver *>(solver);
+    }
+
+    void ipasir_add(void *solver, int32_t lit_or_zero) {
+        auto &s = get(solver);
+        if (lit_or_zero != 0) {
+            s.clause.emplace_back(s.literal(lit_or_zero));
+            return;
+        }
+
+        s.solver.addClause(std::move(s.clause));
+        s.clause.clear();
+    }
+
+    void ipasir_assume(void *solver, int32_t lit) {
+        auto &s = get(solver);
+        s.assumptions.emplace_back(s.literal(lit));
+    }
+
+    int ipasir_solve(void *solver) {
+        auto &s = get(solver);
+        const auto result = s.solver.solve(s.assumptions);
+        s.assumptions.clear();
+        return result == sat::SolverResult::Sat ? 10 : result == sat::SolverResult::Unsat ? 20 : 0;
+    }
+
+    int32_t ipasir_val(void *solver, int32_t lit) {
+        auto &s = get(solver);
+        const auto l = sat::inout::from_dimacs(lit);
+        if (var(l).get() >= s.solver.getNumVariables()) {
+            return 0;
+        }
+
+        const auto value = s.solver.val(var(l));
+        if (value == sat::TruthValue::Undefined) {
+            return 0;
+        }
+
+        return (value == sat::TruthValue::True) == (lit > 0) ? lit : -lit;
+    }
+
+    int ipasir_failed(void *solver, int32_t lit) {
+        const auto &failed = get(solver).solver.getFailedAssumptions();
+        return std::ranges::find(failed, sat::inout::from_dimacs(lit)) != failed.end();
+    }
+
+    void ipasir_set_terminate(void *solver, void *data, int (*terminate)(void *data)) {
+        auto &s = get(solver);
+        if (terminate == nullptr) {
+            s.solver.setTerminationCallback({});
+            return;
+        }
+
+        s.solver.setTerminationCallback([data, terminate] { return terminate(data) != 0; });
+    }
+
+    void ipasir_set_learn(void *solver, void *data, int max_length, void (*learn)(void *data, int32_t *clause)) {
+        auto &s = get(solver);
+        s.learnCallback.reset();
+        if (learn != nullptr && max_length >= 0) {
+            s.learnCallback = std::make_unique<LearnCallback>(data, static_cast<std::size_t>(max_length), learn);
+        }
+
+        s.solver.setClauseSharing(s.learnCallback.get());
+    }
+}
@@ -0,0 +1,95 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @file ipasir.h
+* @brief C interface of the incremental solver following the IPASIR specification used by the SAT competition's
+* incremental track. Literals are non-zero dimacs integers, variables are created implicitly by their first use
+*/
+
+#ifndef IPASIR_H
+#define IPASIR_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Name and version of the solver
+ * @return null terminated string
+ */
+const char *ipasir_signature(void);
+
+/**
+ * Creates a new solver instance. Elimination is disabled since any variable may occur in later clauses
+ * @return pointer to the solver
+ */
+void *ipasir_init(void);
+
+/**
+ * Destroys a solver instance
+ * @param solver solver created by ipasir_init()
+ */
+void ipasir_release(void *solver);
+
+/**
+ * Adds a literal to the clause under construction. The clause is added to the solver when 0 is passed
+ * @param solver solver instance
+ * @param lit_or_zero dimacs literal or 0 to finish the clause
+ */
+void ipasir_add(void *solver, int32_t lit_or_zero);
+
+/**
+ * Adds an assumption for the next call to ipasir_solve(). Assumptions are cleared after each call
+ * @param solver solver instance
+ * @param lit dimacs literal assumed to be true
+ */
+void ipasir_assume(void *solver, int32_t lit);
+
+/**
+ * Solves the formula under the current assumptions
+ * @param solver solver instance
+ * @return 10 if satisfiable, 20 if unsatisfiable, 0 if interrupted by the termination callback
+ */
+int ipasir_solve(void *solver);
+
+/**
+ * Gets the value of a literal in the model. Only valid if the last call to ipasir_solve() returned 10 and no clause
+ * was added since
+ * @param solver solver instance
+ * @param lit dimacs literal
+ * @return lit if the literal is true, -lit if it is false, 0 if the value does not matter
+ */
+int32_t ipasir_val(void *solver, int32_t lit);
+
+/**
+ * Whether an assumption was used to refute the formula. Only valid if the last call to ipasir_solve() returned 20
+ * @param solver solver instance
+ * @param lit assumption of the last call
+ * @return 1 if the assumption is part of the refutation, 0 otherwise
+ */
+int ipasir_failed(void *solver, int32_t lit);
+
+/**
+ * Sets a callback that is polled during the search. The search is interrupted once it returns a non-zero value
+ * @param solver solver instance
+ * @param data argument passed to the callback
+ * @param terminate callback (null to disable)
+ */
+void ipasir_set_terminate(void *solver, void *data, int (*terminate)(void *data));
+
+/**
+ * Sets a callback that receives learned clauses up to the given length as zero terminated arrays
+ * @param solver solver instance
+ * @param data first argument passed to the callback
+ * @param max_length maximum length of reported clauses
+ * @param learn callback (null to disable)
+ */
+void ipasir_set_learn(void *solver, void *data, int max_length, void (*learn)(void *data, int32_t *clause));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //IPASIR_H
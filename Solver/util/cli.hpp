@@ -71,6 +71,13 @@ namespace cli {
             }
         };
 
+        template<>
+        struct TypeParse<std::string> {
+            std::string operator()(const std::string &s) const {
+                return s;
+            }
+        };
+
         template<std::integral T>
         struct TypeParse<T> {
             T operator()(const std::string &s) const {
@@ -25,6 +25,8 @@ TEST(structures, literal) {
     EXPECT_EQ(l.sign(), -1);
     EXPECT_EQ(l.negate(), 5);
     EXPECT_EQ(l.negate().sign(), 1);
+    EXPECT_EQ(l.negate().negate(), l);
+    EXPECT_EQ(Literal(5).negate(), 4);
 }
 
 TEST(structures, conversion_var_lit) {
@@ -0,0 +1,118 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "BitParallelSolver.hpp"
+#include "testing_utils.hpp"
+
+TEST(bit_parallel, mask_widths) {
+    using namespace sat;
+    // 3-SAT below the threshold is almost always satisfiable, variables are spread over all words of the masks
+    for (unsigned numVariables: {20u, 64u, 100u, 128u, 200u, 256u}) {
+        const auto clauses = test::random3Sat(numVariables, 3 * numVariables, numVariables);
+        const auto [result, model, stats] = solveBitParallel(clauses, numVariables);
+        ASSERT_EQ(result, SolverResult::Sat) << numVariables << " variables";
+        ASSERT_EQ(model.size(), numVariables);
+        EXPECT_TRUE(test::isModel(model, clauses)) << numVariables << " variables";
+        EXPECT_GT(stats.decisions + stats.propagations, 0);
+    }
+
+    EXPECT_THROW(solveBitParallel({{pos(0)}}, MaxBitParallelVariables + 1), std::invalid_argument);
+    EXPECT_THROW(BitParallelSolver<1>({{pos(0)}}, 65), std::invalid_argument);
+}
+
+TEST(bit_parallel, unsat_and_limits) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem2);
+    BitParallelSolver<1> solver(clauses, static_cast<unsigned>(numVariables));
+    EXPECT_EQ(solver.solve(10), SolverResult::Unknown);
+    EXPECT_EQ(solver.getStatistics().conflicts, 10);
+    EXPECT_EQ(solver.solve(), SolverResult::Unsat);
+    EXPECT_TRUE(solver.getModel().empty());
+
+    std::atomic_bool stop = true;
+    solver.setTerminationFlag(&stop);
+    EXPECT_EQ(solver.solve(), SolverResult::Unknown);
+
+    EXPECT_EQ(std::get<0>(solveBitParallel({{pos(0)}, {neg(0), pos(1)}, {neg(1)}}, 2)), SolverResult::Unsat);
+    EXPECT_EQ(std::get<0>(solveBitParallel({{pos(0)}, {}}, 1)), SolverResult::Unsat);
+    const auto [result, model, stats] = solveBitParallel({{pos(0), neg(0)}, {neg(1), neg(1)}}, 2);
+    ASSERT_EQ(result, SolverResult::Sat);
+    EXPECT_EQ(model[1], TruthValue::False);
+}
+
+TEST(bit_parallel, solver_dispatch) {
+    using namespace sat;
+    for (auto problem: {test::TestData::SatProblem1, test::TestData::UnsatProblem2}) {
+        auto [clauses, numVariables] = test::loadProblem(problem);
+        Solver s(static_cast<unsigned>(numVariables), {.cardinalityReasoning = false});
+        for (const auto &clause: clauses) {
+            s.addClause(clause);
+        }
+
+        const auto result = s.solve();
+        EXPECT_EQ(s.getStatistics().bitParallelCalls, 1);
+        EXPECT_EQ(s.getStatistics().decisions, 0) << "the CDCL search must not run";
+        if (problem == test::TestData::SatProblem1) {
+            ASSERT_EQ(result, SolverResult::Sat);
+            EXPECT_TRUE(test::isModel(s, clauses));
+            // the solver stays incremental, variable 0 has the same value in all models
+            s.addClause({s.satisfied(pos(0)) ? neg(0) : pos(0)});
+            EXPECT_EQ(s.solve(), SolverResult::Unsat);
+            EXPECT_EQ(s.getStatistics().bitParallelCalls, 2);
+        } else {
+            EXPECT_EQ(result, SolverResult::Unsat);
+        }
+    }
+}
+
+TEST(bit_parallel, solver_dispatch_limits) {
+    using namespace sat;
+    auto [unsatClauses, unsatVariables] = test::loadProblem(test::TestData::UnsatProblem2);
+    Solver limited(static_cast<unsigned>(unsatVariables), {.cardinalityReasoning = false});
+    for (const auto &clause: unsatClauses) {
+        limited.addClause(clause);
+    }
+
+    // the conflict limit of the call caps the bit-parallel search, its conflicts are counted
+    EXPECT_EQ(limited.solve({}, 10), SolverResult::Unknown);
+    EXPECT_EQ(limited.getStatistics().bitParallelCalls, 1);
+    EXPECT_EQ(limited.getStatistics().conflicts, 10);
+    EXPECT_EQ(limited.getStatistics().bitParallelConflicts, 10);
+    EXPECT_EQ(limited.getStatistics().decisions, 0) << "the CDCL search must not run";
+
+    // the model of the bit-parallel engine stays valid while the clauses do not change, the CDCL search takes over
+    // afterwards and keeps its learned clauses for the following calls
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem1);
+    Solver s(static_cast<unsigned>(numVariables), {.cardinalityReasoning = false});
+    for (const auto &clause: clauses) {
+        s.addClause(clause);
+    }
+
+    ASSERT_EQ(s.solve(), SolverResult::Sat);
+    ASSERT_EQ(s.solve(), SolverResult::Sat);
+    EXPECT_EQ(s.getStatistics().bitParallelCalls, 1) << "the clauses did not change";
+    EXPECT_GT(s.getStatistics().decisions, 0);
+    clauses.emplace_back(Clause{s.satisfied(pos(1)) ? neg(1) : pos(1), s.satisfied(pos(2)) ? neg(2) : pos(2)});
+    s.addClause(clauses.back());
+    if (s.solve() == SolverResult::Sat) {
+        EXPECT_TRUE(test::isModel(s, clauses));
+    }
+
+    EXPECT_EQ(s.getStatistics().bitParallelCalls, 1);
+}
+
+#ifndef __RUN_ALL_TESTS__
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#endif
@@ -0,0 +1,150 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <bit>
+#include <random>
+
+#include "CardinalityConstraints.hpp"
+#include "Preprocessor.hpp"
+#include "Solver.hpp"
+#include "testing_utils.hpp"
+
+namespace {
+    /**
+     * Direct encoding of l1 + ... + ln <= bound: one clause per subset of bound + 1 literals
+     */
+    void encode(const std::vector<sat::Literal> &literals, unsigned bound, std::vector<sat::Clause> &clauses) {
+        for (unsigned mask = 0; mask < 1u << literals.size(); ++mask) {
+            if (static_cast<unsigned>(std::popcount(mask)) != bound + 1) {
+                continue;
+            }
+
+            auto &clause = clauses.emplace_back();
+            for (std::size_t i = 0; i < literals.size(); ++i) {
+                if ((mask >> i) & 1) {
+                    clause.emplace_back(literals[i].negate());
+                }
+            }
+        }
+    }
+}
+
+TEST(cardinality_constraints, find_cardinalities) {
+    using namespace sat;
+    std::vector<Clause> clauses{{pos(0), pos(9)}};
+    encode({pos(0), neg(1), pos(2), neg(3)}, 1, clauses);
+    encode({pos(4), pos(5), neg(6), pos(7), pos(8)}, 2, clauses);
+    encode({pos(10), pos(11), pos(12)}, 1, clauses);
+    clauses.pop_back(); // incomplete encoding
+    clauses.push_back(clauses[1]); // duplicates are not needed twice
+    const auto constraints = findCardinalities(clauses, 3);
+    ASSERT_EQ(constraints.size(), 2);
+    EXPECT_THAT(constraints[0].literals, testing::UnorderedElementsAre(pos(0), neg(1), pos(2), neg(3)));
+    EXPECT_EQ(constraints[0].bound, 1);
+    EXPECT_THAT(constraints[0].clauses, testing::UnorderedElementsAre(1, 2, 3, 4, 5, 6));
+    EXPECT_THAT(constraints[1].literals, testing::UnorderedElementsAre(pos(4), pos(5), neg(6), pos(7), pos(8)));
+    EXPECT_EQ(constraints[1].bound, 2);
+    EXPECT_EQ(constraints[1].clauses.size(), 10);
+    EXPECT_EQ(findCardinalities(clauses, 1).size(), 1);
+}
+
+TEST(cardinality_constraints, counting_conflict) {
+    using namespace sat;
+    for (unsigned holes = 2; holes < 8; ++holes) {
+        const auto unsat = test::pigeonhole(holes + 1, holes);
+        const auto constraints = findCardinalities(unsat, 1);
+        ASSERT_EQ(constraints.size(), holes);
+        EXPECT_TRUE(countingConflict(constraints, unsat, {}));
+        const auto sat = test::pigeonhole(holes, holes);
+        EXPECT_FALSE(countingConflict(findCardinalities(sat, 1), sat, {}));
+    }
+
+    // pigeon 0 sits in hole 0, the other pigeons compete for the remaining holes
+    const auto clauses = test::pigeonhole(5, 5);
+    const auto constraints = findCardinalities(clauses, 1);
+    std::vector<TruthValue> model(25, TruthValue::Undefined);
+    model[0] = TruthValue::True;
+    EXPECT_FALSE(countingConflict(constraints, clauses, model));
+    for (unsigned p = 1; p < 5; ++p) {
+        model[p * 5 + 4] = TruthValue::False; // hole 4 is closed
+    }
+
+    EXPECT_TRUE(countingConflict(constraints, clauses, model));
+}
+
+TEST(cardinality_constraints, pigeonhole) {
+    using namespace sat;
+    for (unsigned holes: {6u, 9u, 12u}) {
+        const auto clauses = test::pigeonhole(holes + 1, holes);
+        Solver s(holes * (holes + 1));
+        for (const auto &clause: clauses) {
+            s.addClause(clause);
+        }
+
+        EXPECT_EQ(s.solve(), SolverResult::Unsat);
+        EXPECT_EQ(s.getStatistics().conflicts, 0);
+        EXPECT_EQ(s.getStatistics().cardinalityConstraints, holes);
+        Preprocessor preprocessor(clauses, holes * (holes + 1));
+        EXPECT_FALSE(preprocessor.run());
+    }
+
+    const auto clauses = test::pigeonhole(7, 7);
+    Solver s(49);
+    for (const auto &clause: clauses) {
+        s.addClause(clause);
+    }
+
+    ASSERT_EQ(s.solve(), SolverResult::Sat);
+    EXPECT_TRUE(test::isModel(s, clauses));
+}
+
+TEST(cardinality_constraints, agrees_with_clauses) {
+    using namespace sat;
+    constexpr unsigned NumVariables = 40;
+    for (unsigned seed = 0; seed < 30; ++seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<unsigned> variable(0, NumVariables - 1);
+        std::bernoulli_distribution sign;
+        auto clauses = test::random3Sat(NumVariables, 60 + seed, seed);
+        for (unsigned c = 0; c < 6; ++c) {
+            std::vector<Literal> literals;
+            for (unsigned x = variable(rng); literals.size() < 6; x = (x + 1 + variable(rng) % 3) % NumVariables) {
+                if (std::ranges::none_of(literals, [x](Literal l) { return var(l).get() == x; })) {
+                    literals.emplace_back(sign(rng) ? pos(x) : neg(x));
+                }
+            }
+
+            encode(literals, 1 + seed % 2, clauses);
+        }
+
+        SolverResult results[2];
+        for (bool cardinalityReasoning: {false, true}) {
+            Solver s(NumVariables, {.bitParallel = false, .cardinalityReasoning = cardinalityReasoning});
+            for (const auto &clause: clauses) {
+                s.addClause(clause);
+            }
+
+            results[cardinalityReasoning] = s.solve();
+            if (results[cardinalityReasoning] == SolverResult::Sat) {
+                EXPECT_TRUE(test::isModel(s, clauses)) << "seed " << seed;
+            }
+        }
+
+        EXPECT_EQ(results[0], results[1]) << "seed " << seed;
+    }
+}
+
+#ifndef __RUN_ALL_TESTS__
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#endif
@@ -0,0 +1,129 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <random>
+
+#include "ClauseEvaluator.hpp"
+#include "Solver.hpp"
+#include "testing_utils.hpp"
+
+namespace {
+    auto randomAssignment(std::size_t numVariables, std::mt19937 &rng) {
+        std::uniform_int_distribution<int> value(-1, 1);
+        std::vector<sat::TruthValue> assignment(numVariables);
+        for (auto &v: assignment) {
+            v = static_cast<sat::TruthValue>(value(rng));
+        }
+
+        return assignment;
+    }
+
+    bool satisfied(sat::Literal l, const std::vector<sat::TruthValue> &assignment) {
+        return sat::var(l).get() < assignment.size() && to_underlying(assignment[sat::var(l).get()]) == l.sign();
+    }
+}
+
+TEST(clause_evaluator, kernels_agree_with_scalar_loop) {
+    using namespace sat;
+    constexpr std::size_t NumVariables = 50;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<unsigned> variable(0, NumVariables - 1);
+    std::uniform_int_distribution<unsigned> size(0, 12);
+    std::bernoulli_distribution sign;
+    // clause sizes from 0 to 12 and a number of clauses that is not a multiple of the block size
+    std::vector<Clause> clauses(203);
+    for (auto &clause: clauses) {
+        for (auto i = size(rng); i > 0; --i) {
+            clause.emplace_back(sign(rng) ? pos(variable(rng)) : neg(variable(rng)));
+        }
+    }
+
+    for (auto kernel: {EvaluationKernel::Scalar, EvaluationKernel::Avx2}) {
+        if (!ClauseEvaluator::supported(kernel)) {
+            EXPECT_THROW(ClauseEvaluator(clauses, NumVariables, kernel), std::invalid_argument);
+            continue;
+        }
+
+        ClauseEvaluator evaluator(clauses, NumVariables, kernel);
+        EXPECT_EQ(evaluator.getKernel(), kernel);
+        std::vector<std::uint32_t> numTrue, trueVariables;
+        for (unsigned round = 0; round < 20; ++round) {
+            // missing variables count as undefined
+            auto assignment = randomAssignment(round == 0 ? NumVariables / 2 : NumVariables, rng);
+            std::size_t unsatisfied = 0;
+            evaluator.countTrueLiterals(assignment, numTrue, trueVariables);
+            ASSERT_EQ(numTrue.size(), clauses.size());
+            for (std::size_t c = 0; c < clauses.size(); ++c) {
+                std::uint32_t count = 0, variables = 0;
+                for (Literal l: clauses[c]) {
+                    if (satisfied(l, assignment)) {
+                        ++count;
+                        variables ^= var(l).get();
+                    }
+                }
+
+                unsatisfied += count == 0;
+                EXPECT_EQ(numTrue[c], count) << to_string(kernel) << " clause " << c;
+                EXPECT_EQ(trueVariables[c], variables) << to_string(kernel) << " clause " << c;
+            }
+
+            EXPECT_EQ(evaluator.countUnsatisfied(assignment), unsatisfied) << to_string(kernel);
+            EXPECT_EQ(evaluator.satisfies(assignment), unsatisfied == 0) << to_string(kernel);
+        }
+    }
+}
+
+TEST(clause_evaluator, verify_model) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem2);
+    Solver s(static_cast<unsigned>(numVariables));
+    for (const auto &clause: clauses) {
+        s.addClause(clause);
+    }
+
+    ASSERT_EQ(s.solve(), SolverResult::Sat);
+    auto model = s.getModel();
+    ClauseEvaluator evaluator(clauses, numVariables);
+    EXPECT_TRUE(evaluator.satisfies(model));
+    EXPECT_EQ(evaluator.countUnsatisfied(model), 0);
+    for (auto &value: model) {
+        value = value == TruthValue::True ? TruthValue::False : TruthValue::True;
+    }
+
+    EXPECT_FALSE(evaluator.satisfies(model));
+    EXPECT_FALSE(ClauseEvaluator({{pos(0)}, {}}, 1).satisfies({TruthValue::True}));
+    EXPECT_TRUE(ClauseEvaluator({}, 0).satisfies({}));
+}
+
+TEST(clause_evaluator, empty_clauses) {
+    using namespace sat;
+    for (auto kernel: {EvaluationKernel::Scalar, EvaluationKernel::Avx2}) {
+        if (!ClauseEvaluator::supported(kernel)) {
+            continue;
+        }
+
+        // the blocks of empty clauses are not full, their remaining lanes must not count as unsatisfied
+        EXPECT_EQ(ClauseEvaluator({{}}, 1, kernel).countUnsatisfied({TruthValue::True}), 1) << to_string(kernel);
+        ClauseEvaluator evaluator({{}, {pos(0)}, {}, {neg(0), pos(1)}}, 2, kernel);
+        EXPECT_EQ(evaluator.countUnsatisfied({TruthValue::True, TruthValue::True}), 2) << to_string(kernel);
+        EXPECT_EQ(evaluator.countUnsatisfied({TruthValue::False, TruthValue::False}), 3) << to_string(kernel);
+        std::vector<std::uint32_t> numTrue, trueVariables;
+        evaluator.countTrueLiterals({TruthValue::True, TruthValue::True}, numTrue, trueVariables);
+        EXPECT_EQ(numTrue, (std::vector<std::uint32_t>{0, 1, 0, 1})) << to_string(kernel);
+    }
+}
+
+#ifndef __RUN_ALL_TESTS__
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#endif
@@ -0,0 +1,171 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "ClauseExchange.hpp"
+#include "testing_utils.hpp"
+
+TEST(clause_exchange, publish_collect) {
+    using namespace sat;
+    ClauseExchange exchange(3);
+    std::vector<ClauseSharing::SharedClause> received;
+    EXPECT_TRUE(exchange.publish(0, {pos(0), neg(1), pos(2)}, 2));
+    EXPECT_TRUE(exchange.publish(0, {neg(3)}, 1));
+    exchange.collect(0, received);
+    EXPECT_TRUE(received.empty()) << "workers must not receive their own clauses";
+    exchange.collect(1, received);
+    ASSERT_EQ(received.size(), 2);
+    EXPECT_TRUE(test::setsEqual(received[0].literals, {pos(0), neg(1), pos(2)}));
+    EXPECT_EQ(received[0].lbd, 2);
+    EXPECT_TRUE(test::setsEqual(received[1].literals, {neg(3)}));
+    received.clear();
+    exchange.collect(1, received);
+    EXPECT_TRUE(received.empty());
+    exchange.collect(2, received);
+    EXPECT_EQ(received.size(), 2);
+}
+
+TEST(clause_exchange, duplicate_filter) {
+    using namespace sat;
+    EXPECT_EQ(ClauseExchange::hash({pos(0), neg(1), pos(2)}), ClauseExchange::hash({neg(1), pos(2), pos(0)}));
+    EXPECT_NE(ClauseExchange::hash({pos(0), neg(1)}), ClauseExchange::hash({neg(0), pos(1)}));
+    ClauseExchange exchange(3);
+    EXPECT_TRUE(exchange.publish(0, {pos(0), neg(1), pos(2)}, 2));
+    EXPECT_FALSE(exchange.publish(0, {pos(2), pos(0), neg(1)}, 2)) << "producer should filter its own duplicates";
+    EXPECT_TRUE(exchange.publish(1, {neg(1), pos(2), pos(0)}, 3));
+    std::vector<ClauseSharing::SharedClause> received;
+    exchange.collect(2, received);
+    EXPECT_EQ(received.size(), 1);
+    EXPECT_EQ(exchange.getStatistics().duplicates, 2);
+    received.clear();
+    exchange.collect(0, received);
+    EXPECT_TRUE(received.empty()) << "clause was already exported by worker 0";
+}
+
+TEST(clause_exchange, backpressure) {
+    using namespace sat;
+    ClauseExchange exchange(2, 64);
+    unsigned accepted = 0;
+    for (unsigned i = 0; i < 8; ++i) {
+        accepted += exchange.publish(0, {pos(i), pos(i + 1), pos(i + 2), pos(i + 3)}, 4);
+    }
+
+    EXPECT_EQ(accepted, 4) << "clauses with high LBD may only fill half of the buffer";
+    EXPECT_TRUE(exchange.publish(0, {neg(0), neg(1)}, 2)) << "glue clauses may use the whole buffer";
+    unsigned units = 0;
+    for (unsigned i = 0; i < 16; ++i) {
+        units += exchange.publish(0, {neg(i + 10)}, 1);
+    }
+
+    EXPECT_LT(units, 16) << "a full buffer must drop clauses";
+    EXPECT_GT(exchange.getStatistics().dropped, 0);
+    std::vector<ClauseSharing::SharedClause> received;
+    exchange.collect(1, received);
+    EXPECT_EQ(received.size(), accepted + 1 + units);
+    EXPECT_TRUE(exchange.publish(0, {pos(20), pos(21), pos(22), pos(23)}, 4)) << "space should be reclaimed";
+}
+
+namespace {
+    constexpr unsigned MaxSize = 8;
+
+    sat::Clause makeClause(unsigned id) {
+        sat::Clause clause;
+        for (unsigned j = 0; j < 1 + id % MaxSize; ++j) {
+            clause.emplace_back(2 * (id * MaxSize + j) + (j & 1));
+        }
+
+        return clause;
+    }
+
+    bool intact(const sat::Clause &clause) {
+        return not clause.empty() && clause == makeClause(clause.front().get() / 2 / MaxSize);
+    }
+}
+
+TEST(clause_exchange, stress) {
+    using namespace sat;
+    constexpr unsigned Workers = 8;
+    constexpr unsigned ClausesPerWorker = 20000;
+    ClauseExchange exchange(Workers, 1024);
+    std::atomic_uint running = Workers;
+    std::vector<std::vector<unsigned>> published(Workers);
+    std::vector<std::vector<unsigned>> received(Workers);
+    std::vector<unsigned> corrupted(Workers, 0);
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned w = 0; w < Workers; ++w) {
+            threads.emplace_back([&, w] {
+                std::vector<ClauseSharing::SharedClause> buffer;
+                const auto collect = [&] {
+                    buffer.clear();
+                    exchange.collect(w, buffer);
+                    for (const auto &[clause, lbd]: buffer) {
+                        if (intact(clause) && lbd == clause.size()) {
+                            received[w].emplace_back(clause.front().get() / 2 / MaxSize);
+                        } else {
+                            ++corrupted[w];
+                        }
+                    }
+                };
+
+                for (unsigned i = 0; i < ClausesPerWorker; ++i) {
+                    const auto id = w * ClausesPerWorker + i;
+                    const auto clause = makeClause(id);
+                    if (exchange.publish(w, clause, static_cast<unsigned>(clause.size()))) {
+                        published[w].emplace_back(id);
+                    }
+
+                    if (i % 16 == 0) {
+                        collect();
+                    }
+                }
+
+                --running;
+                while (running > 0) {
+                    collect();
+                    std::this_thread::yield();
+                }
+
+                collect();
+            });
+        }
+    }
+
+    std::uint64_t totalPublished = 0;
+    for (unsigned w = 0; w < Workers; ++w) {
+        totalPublished += published[w].size();
+        EXPECT_EQ(corrupted[w], 0);
+        std::vector<unsigned> expected;
+        for (unsigned p = 0; p < Workers; ++p) {
+            if (p != w) {
+                expected.insert(expected.end(), published[p].begin(), published[p].end());
+            }
+        }
+
+        std::ranges::sort(expected);
+        std::ranges::sort(received[w]);
+        EXPECT_EQ(received[w], expected) << "worker " << w << " missed or duplicated clauses";
+    }
+
+    const auto stats = exchange.getStatistics();
+    EXPECT_EQ(stats.published, totalPublished);
+    EXPECT_EQ(stats.published + stats.dropped, Workers * ClausesPerWorker);
+}
+
+#ifndef __RUN_ALL_TESTS__
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#endif
@@ -0,0 +1,116 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <sstream>
+
+#include "CubeAndConquer.hpp"
+#include "inout.hpp"
+#include "Solver.hpp"
+#include "testing_utils.hpp"
+
+TEST(cube_and_conquer, lookahead_cubes) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem2);
+    Solver solver(numVariables);
+    for (const auto &clause: clauses) {
+        solver.addClause(clause);
+    }
+
+    const Cube prefix{pos(0)};
+    std::vector<Cube> refuted;
+    const auto cubes = solver.cube(prefix, 3, &refuted);
+    EXPECT_FALSE(cubes.empty());
+    EXPECT_LE(cubes.size(), 8);
+    for (const auto &cube: cubes) {
+        ASSERT_FALSE(cube.empty());
+        EXPECT_EQ(cube.front(), pos(0)) << "cubes must extend the prefix";
+        test::LitSet variables;
+        for (Literal l: cube) {
+            EXPECT_TRUE(variables.emplace(pos(var(l))).second) << "variable occurs twice in cube";
+        }
+    }
+
+    EXPECT_EQ(solver.solve(), SolverResult::Sat) << "cubing must not change the solver state";
+    EXPECT_TRUE(test::isModel(solver, clauses));
+}
+
+TEST(cube_and_conquer, sat) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem2);
+    CubeAndConquer cubeAndConquer(clauses, static_cast<unsigned>(numVariables), {.threads = 3, .depth = 4});
+    ASSERT_EQ(cubeAndConquer.solve(), SolverResult::Sat);
+    EXPECT_TRUE(test::isModel(cubeAndConquer, clauses)) << "model does not satisfy the formula";
+}
+
+TEST(cube_and_conquer, sat_with_frequent_splits) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem3);
+    // a budget of one conflict splits almost every cube, thieves race the splitting worker for the parts
+    for (unsigned run = 0; run < 10; ++run) {
+        CubeAndConquer cubeAndConquer(clauses, static_cast<unsigned>(numVariables),
+                                      {.threads = 16, .depth = 1, .conflictBudget = 1});
+        ASSERT_EQ(cubeAndConquer.solve(), SolverResult::Sat) << "run " << run;
+        EXPECT_GT(cubeAndConquer.getStatistics().splits, 0);
+        EXPECT_TRUE(test::isModel(cubeAndConquer, clauses)) << "model does not satisfy the formula";
+    }
+}
+
+TEST(cube_and_conquer, unsat_refutes_all_cubes) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem2);
+    CubeAndConquer cubeAndConquer(clauses, static_cast<unsigned>(numVariables),
+                                  {.threads = 4, .depth = 4, .conflictBudget = 10});
+    ASSERT_EQ(cubeAndConquer.solve(), SolverResult::Unsat);
+    const auto &stats = cubeAndConquer.getStatistics();
+    EXPECT_GT(stats.cubes, 1);
+    EXPECT_EQ(stats.refutedCubes, cubeAndConquer.getRefutedCubes().size());
+    EXPECT_GE(stats.refutedCubes, stats.cubes - stats.splits);
+    // every refuted cube must actually be unsatisfiable
+    Solver check(numVariables, {.elimination = false});
+    for (const auto &clause: clauses) {
+        check.addClause(clause);
+    }
+
+    for (const auto &cube: cubeAndConquer.getRefutedCubes()) {
+        EXPECT_EQ(check.solve(cube), SolverResult::Unsat);
+    }
+}
+
+TEST(cube_and_conquer, icnf_round_trip) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem2);
+    Solver solver(numVariables);
+    for (const auto &clause: clauses) {
+        solver.addClause(clause);
+    }
+
+    const auto cubes = solver.cube({}, 3);
+    std::stringstream ss(inout::to_icnf(clauses, cubes));
+    const auto [readClauses, readCubes, readVariables] = inout::read_from_icnf(ss);
+    EXPECT_EQ(readClauses, clauses);
+    EXPECT_EQ(readCubes, cubes);
+    EXPECT_EQ(readVariables, numVariables);
+    for (const auto &cube: readCubes) {
+        EXPECT_EQ(solver.solve(cube), SolverResult::Unsat);
+    }
+
+    // variables that occur in no clause are only known from the written variable count
+    std::stringstream unused(inout::to_icnf(clauses, cubes, numVariables + 2));
+    EXPECT_EQ(std::get<2>(inout::read_from_icnf(unused)), numVariables + 2);
+}
+
+#ifndef __RUN_ALL_TESTS__
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#endif
@@ -0,0 +1,242 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <stdexcept>
+#include <vector>
+
+#include "ipasir.h"
+#include "inout.hpp"
+#include "Solver.hpp"
+#include "testing_utils.hpp"
+
+namespace {
+    sat::Clause blockingClause(const sat::Solver &solver) {
+        sat::Clause clause;
+        for (unsigned x = 0; x < solver.getNumVariables(); ++x) {
+            clause.emplace_back(solver.val(x) == sat::TruthValue::True ? sat::neg(x) : sat::pos(x));
+        }
+
+        return clause;
+    }
+}
+
+TEST(incremental, add_clauses_between_calls) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem2);
+    Solver s(numVariables);
+    for (const auto &clause: clauses) {
+        s.addClause(clause);
+    }
+
+    std::uint64_t conflicts = 0;
+    for (unsigned i = 0; i < 5; ++i) {
+        ASSERT_EQ(s.solve(), SolverResult::Sat);
+        EXPECT_TRUE(test::isModel(s, clauses));
+        EXPECT_GE(s.getStatistics().conflicts, conflicts) << "statistics must accumulate over calls";
+        conflicts = s.getStatistics().conflicts;
+        const auto blocking = blockingClause(s);
+        clauses.emplace_back(blocking);
+        if (!s.addClause(blocking)) {
+            break;
+        }
+    }
+}
+
+TEST(incremental, add_variables) {
+    using namespace sat;
+    Solver s(2);
+    s.addClause({pos(0), pos(1)});
+    s.addClause({neg(0), pos(1)});
+    ASSERT_EQ(s.solve(), SolverResult::Sat);
+    EXPECT_TRUE(s.satisfied(pos(1)));
+    const auto x = s.addVariable();
+    const auto y = s.addVariable();
+    EXPECT_EQ(x, 2);
+    EXPECT_EQ(y, 3);
+    EXPECT_EQ(s.getNumVariables(), 4);
+    s.addClause({neg(1), pos(x)});
+    s.addClause({neg(x), neg(y)});
+    ASSERT_EQ(s.solve({pos(y)}), SolverResult::Unsat);
+    ASSERT_EQ(s.solve(), SolverResult::Sat);
+    EXPECT_TRUE(s.satisfied(pos(x)) && s.satisfied(neg(y)));
+    s.addClause({pos(y), pos(0)});
+    s.addClause({pos(y), neg(0)});
+    EXPECT_EQ(s.solve(), SolverResult::Unsat);
+}
+
+TEST(incremental, frozen_variables) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem2);
+    clauses.pop_back();
+    // restart after every conflict and allow elimination at each restart
+    Solver s(numVariables, {.restartUnit = 1, .elimination = true, .eliminationTimeFraction = 1e6,
+                            .bitParallel = false, .cardinalityReasoning = false});
+    for (unsigned x = 0; x < numVariables; x += 2) {
+        s.freeze(x);
+    }
+
+    for (const auto &clause: clauses) {
+        s.addClause(clause);
+    }
+
+    const auto result = s.solve();
+    ASSERT_NE(result, SolverResult::Unknown);
+    ASSERT_GT(s.getStatistics().elimination.calls, 0);
+    unsigned removed = 0;
+    for (unsigned x = 0; x < numVariables; ++x) {
+        try {
+            s.addClause({pos(x), neg(x)});
+        } catch (const std::invalid_argument &) {
+            EXPECT_EQ(x % 2, 1) << "frozen variable " << x << " was eliminated";
+            ++removed;
+        }
+    }
+
+    EXPECT_GT(removed, 0);
+    EXPECT_THROW(s.solve({pos(1)}), std::invalid_argument);
+    EXPECT_NO_THROW(s.solve({pos(0), pos(2)}));
+}
+
+TEST(incremental, failed_assumptions) {
+    using namespace sat;
+    Solver s(8);
+    s.addClause({neg(0), pos(1)});
+    s.addClause({neg(1), pos(2)});
+    s.addClause({neg(3)});
+    ASSERT_EQ(s.solve({pos(5), pos(0), pos(6), neg(2)}), SolverResult::Unsat);
+    EXPECT_TRUE(test::setsEqual(s.getFailedAssumptions(), {pos(0), neg(2)}));
+    ASSERT_EQ(s.solve({pos(5), pos(3)}), SolverResult::Unsat);
+    EXPECT_TRUE(test::setsEqual(s.getFailedAssumptions(), {pos(3)})) << "assumption falsified at the root level";
+    ASSERT_EQ(s.solve({pos(7), pos(4), neg(7)}), SolverResult::Unsat);
+    EXPECT_TRUE(test::setsEqual(s.getFailedAssumptions(), {pos(7), neg(7)}));
+    ASSERT_EQ(s.solve({pos(4)}), SolverResult::Sat);
+    EXPECT_TRUE(s.getFailedAssumptions().empty());
+    s.addClause({pos(3)});
+    ASSERT_EQ(s.solve({pos(4)}), SolverResult::Unsat);
+    EXPECT_TRUE(s.getFailedAssumptions().empty()) << "the formula itself is unsatisfiable";
+}
+
+TEST(incremental, shrink_failed_assumptions) {
+    using namespace sat;
+    // a alone is unsatisfiable but needs conflicts to be refuted, b propagates c before a is decided
+    const Variable a = 0, b = 1, c = 2, d = 3;
+    Solver s(4, {.inprocessing = false});
+    s.addClause({neg(b), pos(c)});
+    s.addClause({neg(a), pos(c), pos(d)});
+    s.addClause({neg(a), neg(c), pos(d)});
+    s.addClause({neg(a), pos(c), neg(d)});
+    s.addClause({neg(a), neg(c), neg(d)});
+    ASSERT_EQ(s.solve({pos(b), pos(a)}), SolverResult::Unsat);
+    EXPECT_TRUE(test::setsEqual(s.getFailedAssumptions(), {pos(a), pos(b)}));
+    EXPECT_TRUE(test::setsEqual(s.shrinkFailedAssumptions(100), {pos(a)}));
+    EXPECT_TRUE(test::setsEqual(s.getFailedAssumptions(), {pos(a)}));
+}
+
+TEST(incremental, shrink_keeps_assumptions_with_elimination) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem3);
+    // the last check runs without assumptions and restarts after every conflict, allowing elimination at each restart
+    Solver s(numVariables + 4, {.restartUnit = 1, .probing = false, .elimination = true,
+                                .eliminationTimeFraction = 1e6, .bitParallel = false});
+    const Variable a = numVariables, b = numVariables + 1, d = numVariables + 2, e = numVariables + 3;
+    for (const auto &clause: clauses) {
+        s.addClause(clause);
+    }
+
+    // a is refuted on its own, d is not involved and can be eliminated without resolvents
+    s.addClause({neg(a), pos(b)});
+    s.addClause({neg(a), neg(b)});
+    s.addClause({pos(d), pos(e)});
+    s.addClause({neg(d), neg(e)});
+    const Cube assumptions{pos(d), pos(a)};
+    ASSERT_EQ(s.solve(assumptions), SolverResult::Unsat);
+    EXPECT_TRUE(test::setsEqual(s.shrinkFailedAssumptions(100000), {pos(a)}));
+    ASSERT_NO_THROW(s.solve(assumptions));
+    EXPECT_TRUE(test::setsEqual(s.getFailedAssumptions(), {pos(a)}));
+}
+
+TEST(incremental, ipasir) {
+    using sat::inout::to_dimacs;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem2);
+    void *solver = ipasir_init();
+    EXPECT_STREQ(ipasir_signature(), "SimpleSatSolver");
+    for (const auto &clause: clauses) {
+        for (auto l: clause) {
+            ipasir_add(solver, to_dimacs(l));
+        }
+
+        ipasir_add(solver, 0);
+    }
+
+    ASSERT_EQ(ipasir_solve(solver), 10);
+    for (const auto &clause: clauses) {
+        EXPECT_TRUE(std::ranges::any_of(clause, [solver](auto l) {
+            return ipasir_val(solver, to_dimacs(l)) == to_dimacs(l);
+        }));
+    }
+
+    // a fresh variable is created by its first use
+    const auto fresh = static_cast<int32_t>(numVariables) + 1;
+    ipasir_add(solver, fresh);
+    ipasir_add(solver, 1);
+    ipasir_add(solver, 0);
+    ipasir_assume(solver, fresh + 1);
+    ipasir_assume(solver, -fresh);
+    ipasir_assume(solver, -1);
+    EXPECT_EQ(ipasir_solve(solver), 20);
+    EXPECT_TRUE(ipasir_failed(solver, -fresh));
+    EXPECT_TRUE(ipasir_failed(solver, -1));
+    EXPECT_FALSE(ipasir_failed(solver, fresh + 1));
+    ipasir_assume(solver, -fresh);
+    ASSERT_EQ(ipasir_solve(solver), 10) << "assumptions are cleared after each call";
+    EXPECT_EQ(ipasir_val(solver, fresh), -fresh);
+    EXPECT_EQ(ipasir_val(solver, 1), 1);
+
+    ipasir_set_terminate(solver, nullptr, [](void *) { return 1; });
+    EXPECT_EQ(ipasir_solve(solver), 0);
+    ipasir_set_terminate(solver, nullptr, nullptr);
+    ipasir_release(solver);
+}
+
+TEST(incremental, ipasir_learn) {
+    using sat::inout::to_dimacs;
+    // the pigeonhole formula is refuted by counting without conflicts
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem1);
+    void *solver = ipasir_init();
+    for (const auto &clause: clauses) {
+        for (auto l: clause) {
+            ipasir_add(solver, to_dimacs(l));
+        }
+
+        ipasir_add(solver, 0);
+    }
+
+    std::vector<std::vector<int32_t>> learned;
+    ipasir_set_learn(solver, &learned, 3, [](void *data, int32_t *clause) {
+        auto &out = *static_cast<std::vector<std::vector<int32_t>> *>(data);
+        out.emplace_back();
+        for (; *clause != 0; ++clause) {
+            out.back().emplace_back(*clause);
+        }
+    });
+
+    EXPECT_EQ(ipasir_solve(solver), 20);
+    EXPECT_FALSE(learned.empty());
+    EXPECT_TRUE(std::ranges::all_of(learned, [](const auto &c) { return not c.empty() && c.size() <= 3; }));
+    ipasir_release(solver);
+}
+
+#ifndef __RUN_ALL_TESTS__
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#endif
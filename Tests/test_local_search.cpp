@@ -0,0 +1,108 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+
+#include "LocalSearch.hpp"
+#include "Preprocessor.hpp"
+#include "testing_utils.hpp"
+
+TEST(local_search, random_3sat) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem2);
+    for (auto algorithm: {LocalSearchAlgorithm::ProbSat, LocalSearchAlgorithm::WalkSat}) {
+        LocalSearch search(clauses, numVariables, {.algorithm = algorithm, .seed = 3});
+        ASSERT_EQ(search.solve(), SolverResult::Sat) << algorithm;
+        EXPECT_TRUE(test::isModel(search, clauses)) << algorithm;
+        EXPECT_EQ(search.numUnsatisfied(), 0);
+        const auto &stats = search.getStatistics();
+        EXPECT_GT(stats.flips, 0);
+        EXPECT_EQ(stats.bestUnsatisfied, 0);
+        EXPECT_GT(stats.flipsPerSecond(), 0);
+    }
+}
+
+TEST(local_search, preprocessed_formula) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem1);
+    Preprocessor preprocessor(clauses, numVariables, {.coveredClauses = true});
+    ASSERT_TRUE(preprocessor.run());
+    LocalSearch search(preprocessor.getClauses(), numVariables);
+    search.reconstructionStack() = preprocessor.getReconstructionStack();
+    ASSERT_EQ(search.solve(), SolverResult::Sat);
+    EXPECT_TRUE(test::isModel(search, clauses)) << "model does not satisfy the original formula";
+}
+
+TEST(local_search, budget_and_termination) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem2);
+    LocalSearch search(clauses, numVariables, {.algorithm = LocalSearchAlgorithm::WalkSat});
+    EXPECT_EQ(search.solve(5000), SolverResult::Unknown);
+    EXPECT_EQ(search.getStatistics().flips, 5000);
+    EXPECT_GT(search.numUnsatisfied(), 0);
+    EXPECT_GE(search.getStatistics().bestUnsatisfied, 1);
+    EXPECT_LE(search.getStatistics().bestUnsatisfied, search.numUnsatisfied());
+    EXPECT_TRUE(search.getModel().empty());
+
+    std::atomic_bool stop = true;
+    search.setTerminationFlag(&stop);
+    EXPECT_EQ(search.solve(), SolverResult::Unknown);
+    EXPECT_EQ(search.getStatistics().flips, 5000);
+
+    LocalSearch empty({{sat::pos(0)}, {}}, 1);
+    EXPECT_EQ(empty.solve(), SolverResult::Unknown);
+}
+
+TEST(local_search, best_assignment) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem2);
+    LocalSearch search(clauses, numVariables, {.seed = 7});
+    search.setAssignment(std::vector(numVariables, TruthValue::True));
+    const auto initial = search.numUnsatisfied();
+    EXPECT_EQ(search.getBestUnsatisfied(), initial);
+    search.solve(2000);
+    EXPECT_LE(search.getBestUnsatisfied(), initial);
+    EXPECT_LE(search.getBestUnsatisfied(), search.numUnsatisfied());
+    LocalSearch replay(clauses, numVariables);
+    replay.setAssignment(search.getBestAssignment());
+    EXPECT_EQ(replay.numUnsatisfied(), search.getBestUnsatisfied());
+}
+
+TEST(local_search, hybrid_solver) {
+    using namespace sat;
+    const SolverConfig config{.restartUnit = 5, .localSearch = true, .localSearchInterval = 0,
+                              .localSearchTimeFraction = 1, .localSearchFlips = 1000, .bitParallel = false,
+                              .cardinalityReasoning = false};
+    for (auto problem : {test::TestData::SatProblem2, test::TestData::UnsatProblem2}) {
+        auto [clauses, numVariables] = test::loadProblem(problem);
+        Solver s(numVariables, config);
+        for (const auto &clause : clauses) {
+            s.addClause(clause);
+        }
+
+        const auto result = s.solve();
+        EXPECT_GT(s.getStatistics().localSearch.calls, 0);
+        EXPECT_GT(s.getStatistics().flips, 0);
+        if (problem == test::TestData::SatProblem2) {
+            ASSERT_EQ(result, SolverResult::Sat);
+            EXPECT_TRUE(test::isModel(s, clauses)) << "model does not satisfy the formula";
+        } else {
+            EXPECT_EQ(result, SolverResult::Unsat);
+        }
+    }
+}
+
+#ifndef __RUN_ALL_TESTS__
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#endif
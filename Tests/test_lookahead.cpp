@@ -0,0 +1,126 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "LookaheadSolver.hpp"
+#include "Solver.hpp"
+#include "testing_utils.hpp"
+
+TEST(lookahead, small_formulas) {
+    using namespace sat;
+    const std::vector<Clause> chain{{pos(0)}, {neg(0), pos(1)}, {neg(1), pos(2), pos(3)}, {neg(2), neg(3)},
+                                    {pos(4), neg(4)}};
+    LookaheadSolver sat(chain, 5);
+    ASSERT_EQ(sat.solve(), SolverResult::Sat);
+    EXPECT_TRUE(test::isModel(sat, chain));
+    EXPECT_EQ(sat.val(0), TruthValue::True);
+    EXPECT_THROW(sat.val(5), std::out_of_range);
+
+    LookaheadSolver conflicting({{pos(0)}, {neg(0), pos(1)}, {neg(1)}}, 2);
+    EXPECT_EQ(conflicting.solve(), SolverResult::Unsat);
+    EXPECT_TRUE(conflicting.getModel().empty());
+    LookaheadSolver empty({{pos(0)}, {}}, 1);
+    EXPECT_EQ(empty.solve(), SolverResult::Unsat);
+
+    // all four combinations of x0 and x1 are excluded, each polarity of x1 fails below either polarity of x0
+    const std::vector<Clause> square{{pos(0), pos(1), pos(2)}, {pos(0), neg(1), pos(2)}, {neg(0), pos(1), pos(2)},
+                                     {neg(0), neg(1), pos(2)}, {neg(2), pos(3)}, {neg(2), neg(3)}};
+    LookaheadSolver unsat(square, 4);
+    EXPECT_EQ(unsat.solve(), SolverResult::Unsat);
+    EXPECT_GT(unsat.getStatistics().failedLiterals, 0);
+}
+
+TEST(lookahead, problems) {
+    using namespace sat;
+    for (const auto &[file, expected]: {std::pair{"hole6.cnf", SolverResult::Unsat},
+                                        {"unsat1.cnf", SolverResult::Unsat}, {"sat1.cnf", SolverResult::Sat},
+                                        {"sat2.cnf", SolverResult::Sat}}) {
+        const auto [clauses, numVariables] = test::loadProblem(std::string(__TEST_DATA_DIR__) + file);
+        LookaheadSolver engine(clauses, numVariables);
+        ASSERT_EQ(engine.solve(), expected) << file;
+        if (expected == SolverResult::Sat) {
+            EXPECT_TRUE(test::isModel(engine, clauses)) << file;
+        }
+    }
+}
+
+TEST(lookahead, random_3sat) {
+    using namespace sat;
+    constexpr unsigned NumVariables = 80;
+    constexpr unsigned NumClauses = 341;
+    std::size_t numSat = 0;
+    LookaheadStatistics total;
+    for (unsigned seed = 0; seed < 30; ++seed) {
+        const auto clauses = test::random3Sat(NumVariables, NumClauses, seed);
+        Solver reference(NumVariables, {.bitParallel = false});
+        for (const auto &clause: clauses) {
+            reference.addClause(clause);
+        }
+
+        const auto expected = reference.solve();
+        LookaheadSolver engine(clauses, NumVariables);
+        ASSERT_EQ(engine.solve(), expected) << "seed " << seed;
+        if (expected == SolverResult::Sat) {
+            ++numSat;
+            EXPECT_TRUE(test::isModel(engine, clauses)) << "seed " << seed;
+        }
+
+        const auto &stats = engine.getStatistics();
+        total.necessaryAssignments += stats.necessaryAssignments;
+        total.doubleLookaheads += stats.doubleLookaheads;
+        total.learnedImplications += stats.learnedImplications;
+        EXPECT_GE(stats.lookaheads, stats.nodes);
+    }
+
+    // near the threshold both outcomes occur
+    EXPECT_GT(numSat, 0);
+    EXPECT_LT(numSat, 30);
+    EXPECT_GT(total.necessaryAssignments, 0);
+    EXPECT_GT(total.doubleLookaheads, 0);
+    EXPECT_GT(total.learnedImplications, 0);
+}
+
+TEST(lookahead, configurations_agree) {
+    using namespace sat;
+    constexpr unsigned NumVariables = 50;
+    for (unsigned seed = 0; seed < 10; ++seed) {
+        const auto clauses = test::random3Sat(NumVariables, 213, seed + 100);
+        LookaheadSolver full(clauses, NumVariables);
+        const auto expected = full.solve();
+        for (const auto &config: {LookaheadConfig{.doubleLookahead = false},
+                                  LookaheadConfig{.localLearning = false, .necessaryAssignments = false},
+                                  LookaheadConfig{.candidateFraction = 1, .weightIterations = 0}}) {
+            LookaheadSolver engine(clauses, NumVariables, config);
+            const auto result = engine.solve();
+            ASSERT_EQ(result, expected) << "seed " << seed;
+            if (result == SolverResult::Sat) {
+                EXPECT_TRUE(test::isModel(engine, clauses)) << "seed " << seed;
+            }
+        }
+    }
+}
+
+TEST(lookahead, termination) {
+    using namespace sat;
+    std::atomic_bool flag = true;
+    const auto clauses = test::random3Sat(100, 426, 7);
+    LookaheadSolver engine(clauses, 100);
+    engine.setTerminationFlag(&flag);
+    EXPECT_EQ(engine.solve(), SolverResult::Unknown);
+    EXPECT_TRUE(engine.getModel().empty());
+}
+
+#ifndef __RUN_ALL_TESTS__
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#endif
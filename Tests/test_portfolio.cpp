@@ -0,0 +1,113 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <numeric>
+
+#include "Portfolio.hpp"
+#include "Preprocessor.hpp"
+#include "Solver.hpp"
+#include "testing_utils.hpp"
+
+TEST(portfolio, sat) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem2);
+    Portfolio portfolio(clauses, static_cast<unsigned>(numVariables), {.threads = 4});
+    ASSERT_EQ(portfolio.solve(), SolverResult::Sat);
+    EXPECT_TRUE(test::isModel(portfolio, clauses)) << "model does not satisfy the formula";
+    ASSERT_TRUE(portfolio.getWinner().has_value());
+    EXPECT_LT(*portfolio.getWinner(), 4);
+    EXPECT_EQ(portfolio.getStatistics().size(), 4);
+}
+
+TEST(portfolio, unsat_with_sharing) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem2);
+    Portfolio portfolio(clauses, static_cast<unsigned>(numVariables),
+                        {.threads = 3, .solverConfig = {.cardinalityReasoning = false}});
+    ASSERT_EQ(portfolio.solve(), SolverResult::Unsat);
+    const auto &stats = portfolio.getStatistics();
+    const auto exported = std::accumulate(stats.begin(), stats.end(), std::uint64_t(0),
+                                          [](auto sum, const auto &s) { return sum + s.exportedClauses; });
+    EXPECT_GT(exported, 0);
+}
+
+TEST(portfolio, preprocessed_formula) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem2);
+    Preprocessor preprocessor(clauses, numVariables);
+    ASSERT_TRUE(preprocessor.run());
+    Portfolio portfolio(preprocessor.getClauses(), static_cast<unsigned>(numVariables), {.threads = 2});
+    portfolio.reconstructionStack() = preprocessor.getReconstructionStack();
+    ASSERT_EQ(portfolio.solve(), SolverResult::Sat);
+    EXPECT_TRUE(test::isModel(portfolio, clauses)) << "model does not satisfy the original formula";
+}
+
+TEST(portfolio, termination_flag) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem2);
+    Solver solver(numVariables, {.cardinalityReasoning = false});
+    for (const auto &clause: clauses) {
+        solver.addClause(clause);
+    }
+
+    std::atomic_bool stop = true;
+    solver.setTerminationFlag(&stop);
+    EXPECT_EQ(solver.solve(), SolverResult::Unknown);
+    stop = false;
+    EXPECT_EQ(solver.solve(), SolverResult::Unsat);
+}
+
+TEST(portfolio, diversification) {
+    using namespace sat;
+    const SolverConfig base;
+    const auto first = Portfolio::diversify(base, 0);
+    EXPECT_EQ(first.seed, base.seed);
+    EXPECT_EQ(first.variableDecay, base.variableDecay);
+    for (unsigned worker = 1; worker < 8; ++worker) {
+        const auto config = Portfolio::diversify(base, worker);
+        EXPECT_EQ(config.seed, worker);
+        const auto other = Portfolio::diversify(base, worker - 1);
+        EXPECT_TRUE(config.variableDecay != other.variableDecay || config.restartUnit != other.restartUnit ||
+                    config.initialPhase != other.initialPhase);
+    }
+}
+
+TEST(portfolio, deterministic) {
+    using namespace sat;
+    for (auto problem : {test::TestData::SatProblem2, test::TestData::UnsatProblem2}) {
+        auto [clauses, numVariables] = test::loadProblem(problem);
+        const PortfolioConfig config{.threads = 3, .deterministic = true, .syncInterval = 200};
+        Portfolio first(clauses, static_cast<unsigned>(numVariables), config);
+        Portfolio second(clauses, static_cast<unsigned>(numVariables), config);
+        const auto result = first.solve();
+        ASSERT_EQ(second.solve(), result);
+        EXPECT_EQ(result, problem == test::TestData::SatProblem2 ? SolverResult::Sat : SolverResult::Unsat);
+        EXPECT_EQ(first.getWinner(), second.getWinner());
+        EXPECT_EQ(first.getModel(), second.getModel());
+        for (unsigned worker = 0; worker < 3; ++worker) {
+            EXPECT_EQ(first.getStatistics()[worker].conflicts, second.getStatistics()[worker].conflicts);
+            EXPECT_EQ(first.getStatistics()[worker].decisions, second.getStatistics()[worker].decisions);
+            EXPECT_EQ(first.getStatistics()[worker].importedClauses, second.getStatistics()[worker].importedClauses);
+        }
+
+        if (result == SolverResult::Sat) {
+            EXPECT_TRUE(test::isModel(first, clauses));
+        }
+    }
+}
+
+#ifndef __RUN_ALL_TESTS__
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#endif
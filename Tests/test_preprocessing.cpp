@@ -0,0 +1,186 @@
+/**
+* @author Tim Luchterhand
+* @date 18.10.26
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "Preprocessor.hpp"
+#include "Solver.hpp"
+#include "inout.hpp"
+#include "testing_utils.hpp"
+
+TEST(preprocessing, variable_elimination) {
+    using namespace sat;
+    std::vector clauses{Clause{pos(0), pos(1)}, Clause{neg(0), pos(2)}, Clause{pos(1), pos(2), pos(3)},
+                        Clause{neg(1), neg(3)}, Clause{neg(2), pos(3)}};
+    Preprocessor preprocessor(clauses, 4);
+    ASSERT_TRUE(preprocessor.run());
+    EXPECT_TRUE(preprocessor.isEliminated(0));
+    const auto simplified = preprocessor.getClauses();
+    EXPECT_LT(simplified.size(), clauses.size());
+    for (const auto &clause : simplified) {
+        EXPECT_TRUE(std::ranges::none_of(clause, [](Literal l) { return var(l) == 0; }))
+            << "eliminated variable still occurs in " << clause;
+    }
+}
+
+TEST(preprocessing, frozen_variable) {
+    using namespace sat;
+    std::vector clauses{Clause{pos(0), pos(1)}, Clause{neg(0), pos(2)}};
+    Preprocessor preprocessor(clauses, 3);
+    preprocessor.freeze(0);
+    ASSERT_TRUE(preprocessor.run());
+    EXPECT_FALSE(preprocessor.isEliminated(0));
+}
+
+TEST(preprocessing, unsat_detection) {
+    using namespace sat;
+    std::vector clauses{Clause{pos(0), pos(1)}, Clause{pos(0), neg(1)}, Clause{neg(0), pos(1)},
+                        Clause{neg(0), neg(1)}};
+    Preprocessor preprocessor(clauses, 2);
+    EXPECT_FALSE(preprocessor.run());
+    Solver solver(2);
+    EXPECT_FALSE(preprocessor.transferTo(solver));
+    EXPECT_EQ(solver.solve(), SolverResult::Unsat);
+}
+
+TEST(preprocessing, model_reconstruction) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem1);
+    Preprocessor preprocessor(clauses, numVariables);
+    ASSERT_TRUE(preprocessor.run());
+    EXPECT_GT(preprocessor.getStatistics().eliminatedVariables, 0);
+    Solver solver(numVariables);
+    ASSERT_TRUE(preprocessor.transferTo(solver));
+    ASSERT_EQ(solver.solve(), SolverResult::Sat);
+    EXPECT_TRUE(test::isModel(solver, clauses)) << "extended model does not satisfy the original formula";
+}
+
+TEST(preprocessing, preserves_unsat) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem1);
+    Preprocessor preprocessor(clauses, numVariables);
+    Solver solver(numVariables);
+    if (preprocessor.run() && preprocessor.transferTo(solver)) {
+        EXPECT_EQ(solver.solve(), SolverResult::Unsat);
+    }
+}
+
+TEST(preprocessing, subsumption_check) {
+    using namespace sat;
+    using enum SubsumptionChecker::Result;
+    SubsumptionChecker checker(4);
+    checker.mark({pos(0), neg(1), pos(2)});
+    EXPECT_EQ(checker.check({pos(0), pos(2)}).first, Subsumes);
+    EXPECT_EQ(checker.check({pos(0), pos(1)}), std::pair(Strengthens, neg(1)));
+    EXPECT_EQ(checker.check({pos(0), pos(3)}).first, None);
+    EXPECT_EQ(checker.check({neg(0), pos(1)}).first, None);
+    EXPECT_EQ(signature({pos(0), neg(0)}), signature({pos(0)}));
+}
+
+TEST(preprocessing, subsumption) {
+    using namespace sat;
+    std::vector clauses{Clause{pos(0), pos(1)}, Clause{pos(0), pos(1), pos(2)}, Clause{pos(1), pos(0)},
+                        Clause{neg(0), pos(1), pos(3)}, Clause{pos(2), pos(3)}};
+    Preprocessor preprocessor(clauses, 4, PreprocessorConfig{.variableElimination = false});
+    ASSERT_TRUE(preprocessor.subsume());
+    EXPECT_EQ(preprocessor.getStatistics().subsumedClauses, 2);
+    EXPECT_EQ(preprocessor.getStatistics().strengthenedClauses, 1);
+    EXPECT_THAT(preprocessor.getClauses(), testing::UnorderedElementsAre(
+                    testing::UnorderedElementsAre(pos(0), pos(1)), testing::UnorderedElementsAre(pos(1), pos(3)),
+                    testing::UnorderedElementsAre(pos(2), pos(3))));
+}
+
+TEST(preprocessing, strengthening_to_unit) {
+    using namespace sat;
+    std::vector clauses{Clause{pos(0), pos(1)}, Clause{pos(0), neg(1)}, Clause{neg(0), pos(2), pos(3)}};
+    Preprocessor preprocessor(clauses, 4, PreprocessorConfig{.variableElimination = false});
+    ASSERT_TRUE(preprocessor.run());
+    EXPECT_THAT(preprocessor.getClauses(), testing::Contains(Clause{pos(0)}));
+}
+
+TEST(preprocessing, equivalent_literal_substitution) {
+    using namespace sat;
+    // 0 -> 1 -> -2 -> 0, 3 <-> 4
+    std::vector clauses{Clause{neg(0), pos(1)}, Clause{neg(1), neg(2)}, Clause{pos(2), pos(0)},
+                        Clause{neg(3), pos(4)}, Clause{pos(3), neg(4)}, Clause{pos(0), pos(3), pos(5)},
+                        Clause{neg(2), neg(4), neg(5)}, Clause{pos(1), pos(2), pos(5)}};
+    Preprocessor preprocessor(clauses, 6, PreprocessorConfig{.variableElimination = false});
+    ASSERT_TRUE(preprocessor.substituteEquivalences());
+    EXPECT_EQ(preprocessor.getStatistics().substitutedVariables, 3);
+    EXPECT_EQ(preprocessor.getStatistics().substitutionsPerRound, std::vector<std::uint64_t>{3});
+    for (unsigned x : {1, 2, 4}) {
+        EXPECT_TRUE(preprocessor.isEliminated(x));
+    }
+
+    EXPECT_THAT(preprocessor.getClauses(), testing::UnorderedElementsAre(
+                    testing::UnorderedElementsAre(pos(0), pos(3), pos(5)),
+                    testing::UnorderedElementsAre(pos(0), neg(3), neg(5))));
+    Solver solver(6);
+    ASSERT_TRUE(preprocessor.transferTo(solver));
+    ASSERT_EQ(solver.solve(), SolverResult::Sat);
+    EXPECT_TRUE(test::isModel(solver, clauses));
+}
+
+TEST(preprocessing, equivalence_with_negation) {
+    using namespace sat;
+    std::vector clauses{Clause{neg(0), pos(1)}, Clause{neg(1), neg(0)}, Clause{pos(0), neg(1)},
+                        Clause{pos(1), pos(0)}};
+    Preprocessor preprocessor(clauses, 2, PreprocessorConfig{.subsumption = false, .variableElimination = false});
+    EXPECT_FALSE(preprocessor.substituteEquivalences());
+}
+
+TEST(preprocessing, blocked_clause_elimination) {
+    using namespace sat;
+    // (0 v 1) is blocked on 0: its only resolution partner (-0 v -1 v 2) produces a tautology
+    std::vector clauses{Clause{pos(0), pos(1)}, Clause{neg(0), neg(1), pos(2)}, Clause{neg(2), pos(1)},
+                        Clause{pos(2), neg(1)}};
+    Preprocessor preprocessor(clauses, 3, PreprocessorConfig{.subsumption = false, .equivalentLiterals = false,
+                                                              .variableElimination = false});
+    ASSERT_TRUE(preprocessor.eliminateBlocked());
+    EXPECT_GE(preprocessor.getStatistics().blockedClauses, 1);
+    Solver solver(3);
+    ASSERT_TRUE(preprocessor.transferTo(solver));
+    ASSERT_EQ(solver.solve(), SolverResult::Sat);
+    EXPECT_TRUE(test::isModel(solver, clauses));
+}
+
+TEST(preprocessing, covered_clause_elimination) {
+    using namespace sat;
+    // (0 v 1) is not blocked, but 2 is covered on 0 and (0 v 1 v 2) is blocked on 2
+    std::vector clauses{Clause{pos(0), pos(1)}, Clause{neg(0), pos(2), pos(3)}, Clause{neg(0), pos(2), pos(4)},
+                        Clause{neg(2), neg(1)}, Clause{neg(3), neg(4)}, Clause{pos(3), pos(4), neg(1)}};
+    const PreprocessorConfig config{.subsumption = false, .equivalentLiterals = false, .variableElimination = false,
+                                    .blockedClauses = false, .coveredClauses = true};
+    Preprocessor preprocessor(clauses, 5, config);
+    ASSERT_TRUE(preprocessor.eliminateCovered());
+    EXPECT_GE(preprocessor.getStatistics().coveredClauses, 1);
+    EXPECT_THAT(preprocessor.getClauses(), testing::Not(testing::Contains(Clause{pos(0), pos(1)})));
+    Solver solver(5);
+    ASSERT_TRUE(preprocessor.transferTo(solver));
+    ASSERT_EQ(solver.solve(), SolverResult::Sat);
+    EXPECT_TRUE(test::isModel(solver, clauses));
+}
+
+TEST(preprocessing, duplicate_clauses_in_solver) {
+    using namespace sat;
+    Solver solver(3);
+    EXPECT_TRUE(solver.addClause({pos(0), neg(1), pos(2)}));
+    EXPECT_TRUE(solver.addClause({pos(2), pos(0), neg(1)}));
+    EXPECT_TRUE(solver.addClause({pos(0), neg(1), neg(2)}));
+    EXPECT_EQ(solver.getStatistics().duplicateClauses, 1);
+    EXPECT_EQ(solver.rebase().size(), 2);
+}
+
+#ifndef __RUN_ALL_TESTS__
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#endif
@@ -0,0 +1,468 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Preprocessor.hpp"
+#include "ProofWriter.hpp"
+#include "Solver.hpp"
+#include "inout.hpp"
+#include "testing_utils.hpp"
+
+namespace {
+    struct Step {
+        bool deletion;
+        sat::Clause clause;
+    };
+
+    auto parseText(const std::string &proof) -> std::vector<Step> {
+        std::vector<Step> steps;
+        std::istringstream in(proof);
+        std::string token;
+        Step current{false, {}};
+        while (in >> token) {
+            if (token == "d") {
+                current.deletion = true;
+            } else if (token == "0") {
+                steps.emplace_back(std::move(current));
+                current = {false, {}};
+            } else {
+                current.clause.emplace_back(sat::inout::from_dimacs(std::stoi(token)));
+            }
+        }
+
+        return steps;
+    }
+
+    auto parseBinary(const std::string &proof) -> std::vector<Step> {
+        std::vector<Step> steps;
+        for (std::size_t i = 0; i < proof.size();) {
+            Step step{proof[i++] == 'd', {}};
+            while (true) {
+                std::uint64_t value = 0;
+                unsigned shift = 0;
+                unsigned char byte;
+                do {
+                    byte = static_cast<unsigned char>(proof[i++]);
+                    value |= static_cast<std::uint64_t>(byte & 127) << shift;
+                    shift += 7;
+                } while (byte & 128);
+
+                if (value == 0) {
+                    break;
+                }
+
+                const auto x = static_cast<unsigned>(value / 2 - 1);
+                step.clause.emplace_back(value % 2 ? sat::neg(x) : sat::pos(x));
+            }
+
+            steps.emplace_back(std::move(step));
+        }
+
+        return steps;
+    }
+
+    /**
+     * Naive forward DRAT checker that only accepts RUP lemmas
+     */
+    class Checker {
+        std::vector<sat::Clause> database;
+        std::vector<char> live;
+        std::multimap<std::vector<unsigned>, std::size_t> lookup;
+        std::size_t numVariables;
+
+        static std::vector<unsigned> key(const sat::Clause &clause) {
+            std::vector<unsigned> ids;
+            for (auto l: clause) {
+                ids.emplace_back(l.get());
+            }
+
+            std::ranges::sort(ids);
+            const auto [first, last] = std::ranges::unique(ids);
+            ids.erase(first, last);
+            return ids;
+        }
+
+        bool rup(const sat::Clause &lemma) const {
+            std::vector<sat::TruthValue> values(numVariables, sat::TruthValue::Undefined);
+            auto value = [&values](sat::Literal l) {
+                const auto v = values[var(l).get()];
+                return v == sat::TruthValue::Undefined ? v : (v == sat::TruthValue::True) == (l.sign() > 0) ?
+                       sat::TruthValue::True : sat::TruthValue::False;
+            };
+
+            auto assign = [&values](sat::Literal l) {
+                values[var(l).get()] = l.sign() > 0 ? sat::TruthValue::True : sat::TruthValue::False;
+            };
+
+            for (auto l: lemma) {
+                if (value(l) == sat::TruthValue::True) {
+                    return true; // tautology
+                }
+
+                assign(l.negate());
+            }
+
+            for (bool changed = true; changed;) {
+                changed = false;
+                for (std::size_t i = 0; i < database.size(); ++i) {
+                    if (not live[i]) {
+                        continue;
+                    }
+
+                    std::optional<sat::Literal> open;
+                    unsigned numOpen = 0;
+                    bool satisfied = false;
+                    for (auto l: database[i]) {
+                        const auto v = value(l);
+                        satisfied |= v == sat::TruthValue::True;
+                        if (v == sat::TruthValue::Undefined) {
+                            open = l;
+                            ++numOpen;
+                        }
+                    }
+
+                    if (satisfied || numOpen > 1) {
+                        continue;
+                    }
+
+                    if (numOpen == 0) {
+                        return true;
+                    }
+
+                    assign(*open);
+                    changed = true;
+                }
+            }
+
+            return false;
+        }
+
+        void insert(const sat::Clause &clause) {
+            lookup.emplace(key(clause), database.size());
+            auto &stored = database.emplace_back();
+            for (auto l: clause) {
+                if (std::ranges::find(stored, l) == stored.end()) {
+                    stored.emplace_back(l);
+                }
+            }
+
+            live.emplace_back(1);
+        }
+
+    public:
+        Checker(const std::vector<sat::Clause> &formula, std::size_t numVariables) : numVariables(numVariables) {
+            for (const auto &clause: formula) {
+                insert(clause);
+            }
+        }
+
+        testing::AssertionResult check(const std::vector<Step> &steps) {
+            bool refuted = false;
+            for (std::size_t i = 0; i < steps.size(); ++i) {
+                const auto &[deletion, clause] = steps[i];
+                if (deletion) {
+                    const auto it = lookup.find(key(clause));
+                    if (it == lookup.end()) {
+                        return testing::AssertionFailure() << "step " << i << ": deleted clause does not exist";
+                    }
+
+                    live[it->second] = 0;
+                    lookup.erase(it);
+                    continue;
+                }
+
+                if (not rup(clause)) {
+                    return testing::AssertionFailure() << "step " << i << ": lemma is not RUP";
+                }
+
+                refuted |= clause.empty();
+                insert(clause);
+            }
+
+            if (not refuted) {
+                return testing::AssertionFailure() << "proof does not contain the empty clause";
+            }
+
+            return testing::AssertionSuccess();
+        }
+    };
+
+    /**
+     * LRAT checker. Each lemma must be refuted by unit propagation over its hints in the given order
+     */
+    class LratChecker {
+        std::unordered_map<sat::ClauseId, sat::Clause> database;
+        sat::ClauseId lastId = 0;
+        std::size_t numVariables;
+
+        static sat::Clause deduplicate(const sat::Clause &clause) {
+            sat::Clause result;
+            for (auto l: clause) {
+                if (std::ranges::find(result, l) == result.end()) {
+                    result.emplace_back(l);
+                }
+            }
+
+            return result;
+        }
+
+        bool implied(const sat::Clause &lemma, const std::vector<sat::ClauseId> &hints) const {
+            std::vector<int> values(numVariables, 0);
+            auto value = [&values](sat::Literal l) { return values[var(l).get()] * l.sign(); };
+            for (auto l: lemma) {
+                values[var(l).get()] = -l.sign();
+            }
+
+            for (auto id: hints) {
+                const auto it = database.find(id);
+                if (it == database.end()) {
+                    return false;
+                }
+
+                std::optional<sat::Literal> open;
+                unsigned numOpen = 0;
+                for (auto l: it->second) {
+                    if (value(l) > 0) {
+                        return false;
+                    }
+
+                    if (value(l) == 0) {
+                        open = l;
+                        ++numOpen;
+                    }
+                }
+
+                if (numOpen == 0) {
+                    return true;
+                }
+
+                if (numOpen > 1) {
+                    return false;
+                }
+
+                values[var(*open).get()] = open->sign();
+            }
+
+            return false;
+        }
+
+    public:
+        LratChecker(const std::vector<sat::Clause> &formula, std::size_t numVariables) : numVariables(numVariables) {
+            for (const auto &clause: formula) {
+                database.emplace(++lastId, deduplicate(clause));
+            }
+        }
+
+        testing::AssertionResult check(const std::string &proof) {
+            bool refuted = false;
+            std::istringstream in(proof);
+            std::string line;
+            while (std::getline(in, line)) {
+                std::istringstream tokens(line);
+                sat::ClauseId id;
+                tokens >> id;
+                std::string token;
+                std::vector<long> numbers;
+                bool deletion = false;
+                while (tokens >> token) {
+                    if (token == "d") {
+                        deletion = true;
+                    } else {
+                        numbers.emplace_back(std::stol(token));
+                    }
+                }
+
+                if (deletion) {
+                    for (auto it = numbers.begin(); *it != 0; ++it) {
+                        if (database.erase(static_cast<sat::ClauseId>(*it)) == 0) {
+                            return testing::AssertionFailure() << line << ": deleted clause does not exist";
+                        }
+                    }
+
+                    continue;
+                }
+
+                const auto separator = std::ranges::find(numbers, 0);
+                sat::Clause lemma;
+                std::transform(numbers.begin(), separator, std::back_inserter(lemma), [](long l) {
+                    return sat::inout::from_dimacs(static_cast<int>(l));
+                });
+
+                const std::vector<sat::ClauseId> hints(separator + 1, numbers.end() - 1);
+                if (id <= lastId) {
+                    return testing::AssertionFailure() << line << ": identifiers must increase";
+                }
+
+                if (not implied(lemma, hints)) {
+                    return testing::AssertionFailure() << line << ": lemma is not implied by its hints";
+                }
+
+                lastId = id;
+                refuted |= lemma.empty();
+                database.emplace(id, deduplicate(lemma));
+            }
+
+            if (not refuted) {
+                return testing::AssertionFailure() << "proof does not contain the empty clause";
+            }
+
+            return testing::AssertionSuccess();
+        }
+    };
+}
+
+TEST(proof, writer_encodings) {
+    using namespace sat;
+    std::ostringstream text;
+    std::ostringstream binary;
+    {
+        ProofWriter textWriter(text, ProofFormat::Text, 8);
+        ProofWriter binaryWriter(binary, ProofFormat::Binary, 8);
+        for (auto *writer: {&textWriter, &binaryWriter}) {
+            writer->addClause({pos(0), neg(99)});
+            writer->deleteClause({pos(0), pos(1), neg(2)});
+            writer->deleteClause({neg(4)});
+            writer->addClause({});
+        }
+
+        EXPECT_EQ(textWriter.getStatistics().additions, 2);
+        EXPECT_EQ(textWriter.getStatistics().deletions, 1) << "unit deletions are not written";
+    }
+
+    EXPECT_EQ(text.str(), "1 -100 0\nd 1 2 -3 0\n0\n");
+    const std::string expected{'a', 2, static_cast<char>(201), 1, 0, 'd', 2, 4, 7, 0, 'a', 0};
+    EXPECT_EQ(binary.str(), expected);
+    const auto steps = parseBinary(binary.str());
+    ASSERT_EQ(steps.size(), 3);
+    EXPECT_EQ(steps[0].clause, Clause({pos(0), neg(99)}));
+    EXPECT_TRUE(steps[1].deletion);
+}
+
+TEST(proof, lrat_encoding) {
+    using namespace sat;
+    std::ostringstream out;
+    {
+        ProofWriter writer(out, ProofFormat::Lrat, 8);
+        EXPECT_TRUE(writer.needsHints());
+        EXPECT_EQ(writer.addInput(), 1);
+        EXPECT_EQ(writer.addInput(), 2);
+        EXPECT_EQ(writer.addClause({pos(0)}, {1, 2}), 3);
+        EXPECT_THROW(writer.addInput(), std::logic_error);
+        writer.deleteClause({pos(0), pos(1)}, 1);
+        EXPECT_EQ(writer.addClause({}, {3, 2}), 4);
+    }
+
+    EXPECT_EQ(out.str(), "3 1 0 1 2 0\n3 d 1 0\n4 0 3 2 0\n");
+    std::ostringstream reserved;
+    ProofWriter writer(reserved, ProofFormat::Lrat);
+    writer.reserveInputs(2);
+    EXPECT_EQ(writer.addInput(), 1);
+    EXPECT_EQ(writer.addClause({pos(0)}, {1}), 3);
+    EXPECT_EQ(writer.addInput(), 2);
+}
+
+TEST(proof, solver_with_inprocessing) {
+    using namespace sat;
+    for (auto format: {ProofFormat::Text, ProofFormat::Binary}) {
+        auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem2);
+        std::ostringstream out;
+        {
+            ProofWriter proof(out, format, 256);
+            // frequent restarts and generous budgets make sure that all inprocessing techniques run
+            Solver solver(numVariables, {.restartUnit = 2, .reduceInterval = 100, .subsumptionTimeFraction = 1e6,
+                                         .probingTimeFraction = 1e6, .elimination = true,
+                                         .eliminationTimeFraction = 1e6, .vivificationTimeFraction = 1e6});
+            solver.setProof(&proof);
+            for (const auto &clause: clauses) {
+                solver.addClause(clause);
+            }
+
+            ASSERT_EQ(solver.solve(), SolverResult::Unsat);
+            EXPECT_GT(solver.getStatistics().elimination.calls, 0);
+        }
+
+        const auto steps = format == ProofFormat::Text ? parseText(out.str()) : parseBinary(out.str());
+        EXPECT_TRUE(Checker(clauses, numVariables).check(steps)) << format;
+    }
+}
+
+TEST(proof, lrat_solver_with_inprocessing) {
+    using namespace sat;
+    for (auto problem: {test::TestData::UnsatProblem1, test::TestData::UnsatProblem2}) {
+        auto [clauses, numVariables] = test::loadProblem(problem);
+        std::ostringstream out;
+        {
+            ProofWriter proof(out, ProofFormat::Lrat, 256);
+            proof.reserveInputs(clauses.size());
+            Solver solver(numVariables, {.restartUnit = 2, .reduceInterval = 100, .subsumptionTimeFraction = 1e6,
+                                         .probingTimeFraction = 1e6, .elimination = true,
+                                         .eliminationTimeFraction = 1e6, .vivificationTimeFraction = 1e6});
+            solver.setProof(&proof);
+            for (const auto &clause: clauses) {
+                solver.addClause(clause);
+            }
+
+            ASSERT_EQ(solver.solve(), SolverResult::Unsat);
+        }
+
+        EXPECT_TRUE(LratChecker(clauses, numVariables).check(out.str()));
+    }
+}
+
+TEST(proof, lrat_preprocessing) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem2);
+    std::ostringstream out;
+    {
+        ProofWriter proof(out, ProofFormat::Lrat);
+        Preprocessor preprocessor(clauses, numVariables, {.eliminationGrowth = 4, .coveredClauses = true}, &proof);
+        ASSERT_TRUE(preprocessor.run());
+        EXPECT_EQ(preprocessor.getStatistics().substitutedVariables, 0) << "substitution is skipped for LRAT";
+        Solver solver(numVariables, {.elimination = true, .eliminationTimeFraction = 1e6});
+        solver.setProof(&proof);
+        ASSERT_TRUE(preprocessor.transferTo(solver));
+        ASSERT_EQ(solver.solve(), SolverResult::Unsat);
+    }
+
+    EXPECT_TRUE(LratChecker(clauses, numVariables).check(out.str()));
+}
+
+TEST(proof, preprocessing) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem1);
+    std::ostringstream out;
+    {
+        ProofWriter proof(out, ProofFormat::Text);
+        Preprocessor preprocessor(clauses, numVariables, {.eliminationGrowth = 4, .coveredClauses = true}, &proof);
+        ASSERT_TRUE(preprocessor.run()) << "the formula is not refuted by preprocessing alone";
+        Solver solver(numVariables);
+        solver.setProof(&proof);
+        ASSERT_TRUE(preprocessor.transferTo(solver));
+        ASSERT_EQ(solver.solve(), SolverResult::Unsat);
+    }
+
+    EXPECT_TRUE(Checker(clauses, numVariables).check(parseText(out.str())));
+}
+
+#ifndef __RUN_ALL_TESTS__
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#endif
@@ -122,6 +122,117 @@ TEST(solver, rebase) {
         << "Clause " << Clause({neg(1), pos(2)}) << " was not found";
 }
 
+TEST(solver, solve_sat) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem1);
+    Solver s(numVariables);
+    for (const auto &clause : clauses) {
+        ASSERT_TRUE(s.addClause(clause));
+    }
+
+    ASSERT_EQ(s.solve(), SolverResult::Sat);
+    EXPECT_TRUE(test::isModel(s, clauses)) << "model does not satisfy the formula";
+}
+
+TEST(solver, solve_unsat) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem1);
+    Solver s(numVariables);
+    for (const auto &clause : clauses) {
+        s.addClause(clause);
+    }
+
+    EXPECT_EQ(s.solve(), SolverResult::Unsat);
+}
+
+TEST(solver, failed_literal_probing) {
+    using namespace sat;
+    Solver s(5);
+    // 0 -> 1, 0 -> 2, 1 & 2 -> 3, 3 -> -0
+    for (const auto &clause : {Clause{neg(0), pos(1)}, Clause{neg(0), pos(2)}, Clause{neg(1), neg(2), pos(3)},
+                               Clause{neg(3), neg(0)}, Clause{pos(3), pos(4)}}) {
+        ASSERT_TRUE(s.addClause(clause));
+    }
+
+    ASSERT_TRUE(s.probe());
+    EXPECT_EQ(s.val(0), TruthValue::False);
+    EXPECT_EQ(s.getStatistics().failedLiterals, 1);
+}
+
+TEST(solver, hyper_binary_resolution) {
+    using namespace sat;
+    Solver s(5);
+    for (const auto &clause : {Clause{neg(0), pos(1)}, Clause{neg(0), pos(2)}, Clause{neg(1), neg(2), pos(3)},
+                               Clause{neg(3), pos(4)}}) {
+        ASSERT_TRUE(s.addClause(clause));
+    }
+
+    ASSERT_TRUE(s.probe());
+    EXPECT_EQ(s.getStatistics().failedLiterals, 0);
+    EXPECT_EQ(s.getStatistics().hyperBinaries, 1);
+    EXPECT_EQ(s.val(0), TruthValue::Undefined);
+    ASSERT_EQ(s.solve(), SolverResult::Sat);
+}
+
+TEST(solver, vivification) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::UnsatProblem2);
+    Solver s(numVariables, SolverConfig{.restartUnit = 10, .reduceInterval = 50, .reduceIncrement = 10,
+                                        .probing = false, .vivificationTimeFraction = 1, .bitParallel = false,
+                                        .cardinalityReasoning = false});
+    for (const auto &clause : clauses) {
+        s.addClause(clause);
+    }
+
+    EXPECT_EQ(s.solve(), SolverResult::Unsat);
+    EXPECT_GT(s.getStatistics().vivifiedClauses, 0);
+    EXPECT_GE(s.getStatistics().vivifiedLiterals, s.getStatistics().vivifiedClauses);
+}
+
+TEST(solver, inprocessing) {
+    using namespace sat;
+    const SolverConfig config{.restartUnit = 5, .reduceInterval = 20, .reduceIncrement = 5,
+                              .subsumptionTimeFraction = 1, .probingTimeFraction = 1, .elimination = true,
+                              .eliminationTimeFraction = 1, .vivificationTimeFraction = 1, .bitParallel = false,
+                              .cardinalityReasoning = false};
+    for (auto problem : {test::TestData::SatProblem2, test::TestData::UnsatProblem2}) {
+        auto [clauses, numVariables] = test::loadProblem(problem);
+        Solver s(numVariables, config);
+        for (const auto &clause : clauses) {
+            s.addClause(clause);
+        }
+
+        const auto result = s.solve();
+        const auto &stats = s.getStatistics();
+        EXPECT_GT(stats.subsumption.calls + stats.probing.calls + stats.elimination.calls + stats.vivification.calls,
+                  0);
+        if (problem == test::TestData::SatProblem2) {
+            ASSERT_EQ(result, SolverResult::Sat);
+            EXPECT_TRUE(test::isModel(s, clauses)) << "model does not satisfy the formula";
+        } else {
+            EXPECT_EQ(result, SolverResult::Unsat);
+        }
+    }
+}
+
+TEST(solver, assumptions) {
+    using namespace sat;
+    auto [clauses, numVariables] = test::loadProblem(test::TestData::SatProblem2);
+    Solver s(numVariables, {.elimination = false});
+    for (const auto &clause : clauses) {
+        s.addClause(clause);
+    }
+
+    ASSERT_EQ(s.solve({neg(0), pos(1)}), SolverResult::Sat);
+    EXPECT_TRUE(s.satisfied(neg(0)) && s.satisfied(pos(1)));
+    EXPECT_TRUE(test::isModel(s, clauses));
+    ASSERT_EQ(s.solve({pos(0), pos(1)}), SolverResult::Sat);
+    EXPECT_TRUE(s.satisfied(pos(0)) && s.satisfied(pos(1)));
+    EXPECT_EQ(s.solve({pos(2), neg(2)}), SolverResult::Unsat);
+    EXPECT_EQ(s.solve(), SolverResult::Sat) << "unsatisfiable assumptions must not make the formula unsatisfiable";
+    EXPECT_EQ(s.solve({pos(3)}, 0), SolverResult::Unknown);
+}
+
 #ifndef __RUN_ALL_TESTS__
 
 int main(int argc, char **argv) {
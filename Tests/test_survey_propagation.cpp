@@ -0,0 +1,67 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "SurveyPropagation.hpp"
+#include "testing_utils.hpp"
+
+TEST(survey_propagation, random_3sat) {
+    using namespace sat;
+    // above clause density 3.92 the surveys are non-trivial, a formula of this size is satisfiable with high probability
+    constexpr unsigned NumVariables = 3000;
+    constexpr unsigned NumClauses = 12000;
+    const auto clauses = test::random3Sat(NumVariables, NumClauses, 42);
+    SurveyPropagation decimation(clauses, NumVariables);
+    ASSERT_EQ(decimation.solve(), SolverResult::Sat);
+    EXPECT_TRUE(test::isModel(decimation, clauses)) << "model does not satisfy the formula";
+    const auto &stats = decimation.getStatistics();
+    EXPECT_GT(stats.decimationSteps, 0);
+    EXPECT_GT(stats.fixedVariables, 0);
+    EXPECT_LT(stats.residualClauses, NumClauses);
+    EXPECT_FALSE(stats.contradiction);
+    for (unsigned x = 0; x < NumVariables; ++x) {
+        const auto fixed = decimation.getAssignment()[x];
+        EXPECT_TRUE(fixed == TruthValue::Undefined || fixed == decimation.val(x));
+    }
+}
+
+TEST(survey_propagation, residual_formula) {
+    using namespace sat;
+    const std::vector<Clause> clauses{{pos(0)}, {neg(0), pos(1)}, {neg(1), pos(2), pos(3)}, {pos(4), neg(4)}};
+    SurveyPropagation decimation(clauses, 5);
+    ASSERT_EQ(decimation.solve(), SolverResult::Sat);
+    EXPECT_TRUE(test::isModel(decimation, clauses));
+    EXPECT_EQ(decimation.getAssignment()[0], TruthValue::True);
+    EXPECT_EQ(decimation.getAssignment()[1], TruthValue::True);
+    EXPECT_EQ(decimation.getStatistics().propagatedVariables, 2);
+    EXPECT_EQ(decimation.getStatistics().decimationSteps, 0) << "the surveys of a single clause are trivial";
+    const auto residual = decimation.getClauses();
+    ASSERT_EQ(residual.size(), 1);
+    EXPECT_TRUE(test::setsEqual(residual.front(), {pos(2), pos(3)}));
+    EXPECT_EQ(decimation.getStatistics().residualVariables, 2);
+}
+
+TEST(survey_propagation, contradiction) {
+    using namespace sat;
+    SurveyPropagation conflicting({{pos(0)}, {neg(0), pos(1)}, {neg(1)}}, 2);
+    EXPECT_EQ(conflicting.solve(), SolverResult::Unknown);
+    EXPECT_TRUE(conflicting.getStatistics().contradiction);
+    EXPECT_TRUE(conflicting.getModel().empty());
+    SurveyPropagation empty({{pos(0)}, {}}, 1);
+    EXPECT_EQ(empty.solve(), SolverResult::Unknown);
+}
+
+#ifndef __RUN_ALL_TESTS__
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#endif
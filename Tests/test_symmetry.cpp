@@ -0,0 +1,212 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <numeric>
+#include <random>
+
+#include "Symmetry.hpp"
+#include "Preprocessor.hpp"
+#include "Solver.hpp"
+#include "testing_utils.hpp"
+
+namespace {
+    bool isSymmetry(const sat::LiteralPermutation &permutation, const std::vector<sat::Clause> &clauses) {
+        for (unsigned l = 0; l < permutation.size(); ++l) {
+            if (permutation[l ^ 1].get() != (permutation[l].get() ^ 1)) {
+                return false;
+            }
+        }
+
+        return std::ranges::all_of(clauses, [&](const sat::Clause &clause) {
+            sat::Clause image;
+            for (sat::Literal l: clause) {
+                image.emplace_back(permutation[l.get()]);
+            }
+
+            return test::findClause(image, clauses);
+        });
+    }
+
+    /**
+     * Whether some assignment of the auxiliary variables satisfies the clauses under the given assignment
+     */
+    bool extensible(const std::vector<sat::Clause> &clauses, unsigned assignment, unsigned numVariables,
+                    std::size_t total) {
+        for (unsigned aux = 0; aux < 1u << (total - numVariables); ++aux) {
+            const auto values = assignment | aux << numVariables;
+            if (std::ranges::all_of(clauses, [values](const sat::Clause &clause) {
+                return std::ranges::any_of(clause, [values](sat::Literal l) {
+                    return ((values >> var(l).get()) & 1) == (l.sign() > 0);
+                });
+            })) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
+
+TEST(symmetry, find_symmetries) {
+    using namespace sat;
+    constexpr unsigned Holes = 4;
+    const auto clauses = test::pigeonhole(Holes + 1, Holes);
+    const auto symmetries = findSymmetries(clauses, Holes * (Holes + 1), {}, 10'000'000);
+    ASSERT_FALSE(symmetries.empty());
+    std::vector<unsigned> orbits(2 * Holes * (Holes + 1));
+    std::iota(orbits.begin(), orbits.end(), 0u);
+    const auto find = [&orbits](unsigned l) {
+        while (orbits[l] != l) {
+            l = orbits[l];
+        }
+
+        return l;
+    };
+
+    for (const auto &symmetry: symmetries) {
+        EXPECT_TRUE(isSymmetry(symmetry, clauses));
+        for (unsigned l = 0; l < symmetry.size(); ++l) {
+            orbits[find(l)] = find(symmetry[l].get());
+        }
+    }
+
+    // pigeons and holes can be permuted arbitrarily, all positive literals are in one orbit
+    for (unsigned x = 0; x < Holes * (Holes + 1); ++x) {
+        EXPECT_EQ(find(pos(x).get()), find(pos(0).get()));
+        EXPECT_NE(find(neg(x).get()), find(pos(0).get()));
+    }
+
+    std::vector<char> fixed(Holes * (Holes + 1), 0);
+    fixed[0] = 1;
+    for (const auto &symmetry: findSymmetries(clauses, Holes * (Holes + 1), fixed, 10'000'000)) {
+        EXPECT_TRUE(isSymmetry(symmetry, clauses));
+        EXPECT_EQ(symmetry[pos(0).get()], pos(0));
+    }
+
+    // the ternary clause breaks the symmetries of the implication cycle
+    const std::vector<Clause> chain{{neg(0), pos(1)}, {neg(1), pos(2)}, {neg(2), pos(0)}, {pos(0), pos(1), pos(3)}};
+    EXPECT_TRUE(findSymmetries(chain, 4, {}, 10'000'000).empty());
+}
+
+TEST(symmetry, lex_leader) {
+    using namespace sat;
+    std::size_t numVariables = 4;
+    LiteralPermutation swap{neg(1), pos(1), neg(0), pos(0), neg(2), pos(2), neg(3), pos(3)};
+    EXPECT_THAT(lexLeaderClauses(swap, numVariables, 100), testing::ElementsAre(Clause{neg(0), pos(1)}));
+    EXPECT_EQ(numVariables, 4);
+
+    // x0 -> x1 -> ¬x2 -> x0 with x3 fixed
+    const LiteralPermutation cycle{neg(1), pos(1), pos(2), neg(2), pos(0), neg(0), neg(3), pos(3)};
+    for (unsigned maxLength: {1u, 2u, 100u}) {
+        numVariables = 4;
+        const auto clauses = lexLeaderClauses(cycle, numVariables, maxLength);
+        EXPECT_EQ(numVariables, 4 + std::min(maxLength, 3u) - 1);
+        for (unsigned assignment = 0; assignment < 16; ++assignment) {
+            const auto value = [assignment](Literal l) { return ((assignment >> var(l).get()) & 1) == (l.sign() > 0); };
+            bool lexLeader = true;
+            for (unsigned x = 0; x < std::min(maxLength, 3u); ++x) {
+                const auto image = value(cycle[pos(x).get()]);
+                if (value(pos(x)) != image) {
+                    lexLeader = image;
+                    break;
+                }
+            }
+
+            EXPECT_EQ(extensible(clauses, assignment, 4, numVariables), lexLeader) << assignment;
+        }
+    }
+}
+
+TEST(symmetry, pigeonhole) {
+    using namespace sat;
+    for (unsigned holes: {6u, 8u, 10u}) {
+        for (unsigned pigeons: {holes, holes + 1}) {
+            const auto clauses = test::pigeonhole(pigeons, holes);
+            Preprocessor preprocessor(clauses, pigeons * holes,
+                                      {.cardinalityCounting = false, .symmetryBreaking = true});
+            preprocessor.run();
+            EXPECT_GT(preprocessor.getStatistics().symmetryGenerators, 0);
+            EXPECT_EQ(preprocessor.getNumVariables(),
+                      pigeons * holes + preprocessor.getStatistics().auxiliaryVariables);
+            Solver s(static_cast<unsigned>(preprocessor.getNumVariables()), {.cardinalityReasoning = false});
+            preprocessor.transferTo(s);
+            const auto result = s.solve();
+            if (pigeons > holes) {
+                EXPECT_EQ(result, SolverResult::Unsat);
+            } else {
+                ASSERT_EQ(result, SolverResult::Sat);
+                EXPECT_TRUE(test::isModel(s, clauses));
+            }
+        }
+    }
+}
+
+TEST(symmetry, agrees_with_clauses) {
+    using namespace sat;
+    constexpr unsigned NumVariables = 30;
+    for (unsigned seed = 0; seed < 30; ++seed) {
+        // random clauses closed under a random involution of the literals
+        std::mt19937 rng(seed);
+        std::vector<unsigned> variables(NumVariables);
+        std::iota(variables.begin(), variables.end(), 0u);
+        std::ranges::shuffle(variables, rng);
+        LiteralPermutation involution;
+        for (unsigned l = 0; l < 2 * NumVariables; ++l) {
+            involution.emplace_back(l);
+        }
+
+        std::bernoulli_distribution sign;
+        for (unsigned i = 0; i + 1 < NumVariables / 2; i += 2) {
+            const bool flip = sign(rng);
+            const Literal a = pos(variables[i]);
+            const Literal b = flip ? neg(variables[i + 1]) : pos(variables[i + 1]);
+            involution[a.get()] = b;
+            involution[b.get()] = a;
+            involution[a.negate().get()] = b.negate();
+            involution[b.negate().get()] = a.negate();
+        }
+
+        auto clauses = test::random3Sat(NumVariables, 60 + 2 * seed, seed);
+        for (std::size_t c = 0, numClauses = clauses.size(); c < numClauses; ++c) {
+            Clause image;
+            for (Literal l: clauses[c]) {
+                image.emplace_back(involution[l.get()]);
+            }
+
+            clauses.emplace_back(std::move(image));
+        }
+
+        SolverResult results[2];
+        for (bool symmetryBreaking: {false, true}) {
+            Preprocessor preprocessor(clauses, NumVariables, {.symmetryBreaking = symmetryBreaking});
+            preprocessor.run();
+            if (symmetryBreaking) {
+                EXPECT_GT(preprocessor.getStatistics().symmetryGenerators, 0) << "seed " << seed;
+            }
+
+            Solver s(static_cast<unsigned>(preprocessor.getNumVariables()), {.bitParallel = false});
+            preprocessor.transferTo(s);
+            results[symmetryBreaking] = s.solve();
+            if (results[symmetryBreaking] == SolverResult::Sat) {
+                EXPECT_TRUE(test::isModel(s, clauses)) << "seed " << seed;
+            }
+        }
+
+        EXPECT_EQ(results[0], results[1]) << "seed " << seed;
+    }
+}
+
+#ifndef __RUN_ALL_TESTS__
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#endif
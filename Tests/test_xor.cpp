@@ -0,0 +1,173 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <bit>
+#include <random>
+
+#include "XorConstraints.hpp"
+#include "Solver.hpp"
+#include "testing_utils.hpp"
+
+namespace {
+    /**
+     * Direct encoding of x1 ^ ... ^ xk = parity: one clause per assignment of the wrong parity
+     */
+    void encode(const std::vector<unsigned> &variables, bool parity, std::vector<sat::Clause> &clauses) {
+        using namespace sat;
+        for (unsigned mask = 0; mask < 1u << variables.size(); ++mask) {
+            if ((std::popcount(mask) % 2 == 1) == parity) {
+                continue;
+            }
+
+            auto &clause = clauses.emplace_back();
+            for (std::size_t i = 0; i < variables.size(); ++i) {
+                clause.emplace_back((mask >> i) & 1 ? neg(variables[i]) : pos(variables[i]));
+            }
+        }
+    }
+
+    auto randomXors(unsigned numVariables, unsigned numConstraints, unsigned numClauses, unsigned seed) {
+        using namespace sat;
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<unsigned> variable(0, numVariables - 1);
+        std::bernoulli_distribution sign;
+        auto clauses = test::random3Sat(numVariables, numClauses, seed);
+        for (unsigned c = 0; c < numConstraints; ++c) {
+            std::vector<unsigned> variables;
+            while (variables.size() < 3) {
+                const auto x = variable(rng);
+                if (std::ranges::find(variables, x) == variables.end()) {
+                    variables.emplace_back(x);
+                }
+            }
+
+            encode(variables, sign(rng), clauses);
+        }
+
+        return clauses;
+    }
+}
+
+TEST(xor_constraints, find_xors) {
+    using namespace sat;
+    std::vector<Clause> clauses{{pos(0), pos(5)}};
+    encode({3, 1, 2}, true, clauses);
+    encode({4, 5, 6, 7}, false, clauses);
+    encode({0, 1, 7}, false, clauses);
+    clauses.pop_back(); // incomplete encoding
+    clauses.push_back(clauses[2]); // duplicates are not needed twice
+    const auto xors = findXors(clauses, 6);
+    ASSERT_EQ(xors.size(), 2);
+    EXPECT_EQ(xors[0].variables, (std::vector<unsigned>{1, 2, 3}));
+    EXPECT_TRUE(xors[0].parity);
+    EXPECT_THAT(xors[0].clauses, testing::UnorderedElementsAre(1, 2, 3, 4));
+    EXPECT_EQ(xors[1].variables, (std::vector<unsigned>{4, 5, 6, 7}));
+    EXPECT_FALSE(xors[1].parity);
+    EXPECT_EQ(xors[1].clauses.size(), 8);
+    EXPECT_TRUE(findXors(clauses, 3).size() == 1);
+}
+
+TEST(xor_constraints, gaussian_elimination) {
+    using namespace sat;
+    // x0 ^ x1 ^ x2 = 1 and x1 ^ x2 ^ x3 = 0 imply x0 ^ x3 = 1
+    GaussianElimination gauss({{.variables = {0, 1, 2}, .parity = true, .clauses = {}},
+                               {.variables = {1, 2, 3}, .parity = false, .clauses = {}}}, 5);
+    EXPECT_EQ(gauss.size(), 2);
+    EXPECT_TRUE(gauss.contains(3));
+    EXPECT_FALSE(gauss.contains(4));
+    std::vector<Clause> implications;
+    Clause conflict;
+    EXPECT_TRUE(gauss.propagate(implications, conflict));
+    EXPECT_TRUE(implications.empty());
+    gauss.assign(pos(0));
+    EXPECT_TRUE(gauss.propagate(implications, conflict));
+    ASSERT_EQ(implications.size(), 1);
+    EXPECT_EQ(implications.front(), (Clause{neg(3), neg(0)}));
+    gauss.assign(pos(3));
+    EXPECT_FALSE(gauss.propagate(implications, conflict));
+    EXPECT_THAT(conflict, testing::UnorderedElementsAre(neg(0), neg(3)));
+    gauss.unassign(3);
+    gauss.assign(neg(3));
+    gauss.assign(pos(1));
+    EXPECT_TRUE(gauss.propagate(implications, conflict));
+    ASSERT_EQ(implications.size(), 1);
+    EXPECT_EQ(implications.front()[0], pos(2));
+    // the matrix keeps its pivots on backtracking, x3 is basic now and gives way to x0
+    gauss.unassign(1);
+    gauss.unassign(3);
+    gauss.unassign(0);
+    EXPECT_TRUE(gauss.propagate(implications, conflict));
+    EXPECT_TRUE(implications.empty());
+    gauss.assign(pos(3));
+    EXPECT_TRUE(gauss.propagate(implications, conflict));
+    ASSERT_EQ(implications.size(), 1);
+    EXPECT_EQ(implications.front(), (Clause{neg(0), neg(3)}));
+}
+
+TEST(xor_constraints, parity_chain) {
+    using namespace sat;
+    // x0 ^ x1 ^ x2 = 0, x1 ^ x2 ^ x3 = 0, ..., closed with inconsistent parity like the dubois instances
+    constexpr unsigned NumVariables = 300;
+    for (bool consistent: {true, false}) {
+        std::vector<Clause> clauses;
+        for (unsigned x = 0; x + 2 < NumVariables; ++x) {
+            encode({x, x + 1, x + 2}, false, clauses);
+        }
+
+        encode({0, NumVariables - 2, NumVariables - 1}, !consistent, clauses);
+        Solver s(NumVariables);
+        for (const auto &clause: clauses) {
+            s.addClause(clause);
+        }
+
+        const auto result = s.solve();
+        EXPECT_EQ(s.getStatistics().xorConstraints, NumVariables - 1);
+        if (consistent) {
+            ASSERT_EQ(result, SolverResult::Sat);
+            EXPECT_TRUE(test::isModel(s, clauses));
+        } else {
+            EXPECT_EQ(result, SolverResult::Unsat);
+            EXPECT_EQ(s.getStatistics().decisions, 0) << "the elimination refutes the chain without search";
+        }
+    }
+}
+
+TEST(xor_constraints, agrees_with_clauses) {
+    using namespace sat;
+    for (unsigned seed = 0; seed < 20; ++seed) {
+        const auto clauses = randomXors(60, 30 + seed, 40, seed);
+        SolverResult results[2];
+        for (bool xorReasoning: {false, true}) {
+            Solver s(60, {.bitParallel = false, .xorReasoning = xorReasoning});
+            for (const auto &clause: clauses) {
+                s.addClause(clause);
+            }
+
+            results[xorReasoning] = s.solve();
+            if (results[xorReasoning] == SolverResult::Sat) {
+                EXPECT_TRUE(test::isModel(s, clauses)) << "seed " << seed;
+            }
+
+            if (xorReasoning) {
+                EXPECT_GT(s.getStatistics().xorConstraints, 0);
+            }
+        }
+
+        EXPECT_EQ(results[0], results[1]) << "seed " << seed;
+    }
+}
+
+#ifndef __RUN_ALL_TESTS__
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#endif
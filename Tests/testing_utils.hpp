@@ -8,10 +8,16 @@
 #define TESTING_UTILS_HPP
 
 #include <unordered_set>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
 
 #include "util/concepts.hpp"
+#include "util/enum.hpp"
 #include "basic_structures.hpp"
 #include "Clause.hpp"
+#include "inout.hpp"
 
 /**
  * @brief Namespace containing testing helpers
@@ -27,6 +33,11 @@ namespace test {
         static constexpr auto UnitPropagationSolution2 = __TEST_DATA_DIR__ "res2.cnf";
         static constexpr auto UnitPropagationSolution3 = __TEST_DATA_DIR__ "res3.cnf";
         static constexpr auto UnitPropagationSolution4 = __TEST_DATA_DIR__ "res4.cnf";
+        static constexpr auto SatProblem1 = __TEST_DATA_DIR__ "sat1.cnf";
+        static constexpr auto SatProblem2 = __TEST_DATA_DIR__ "sat2.cnf";
+        static constexpr auto SatProblem3 = __TEST_DATA_DIR__ "sat3.cnf";
+        static constexpr auto UnsatProblem1 = __TEST_DATA_DIR__ "unsat1.cnf";
+        static constexpr auto UnsatProblem2 = __TEST_DATA_DIR__ "hole6.cnf";
     };
 
     template<typename T>
@@ -64,6 +75,105 @@ namespace test {
 
         return res != clauses.end();
     }
+
+    /**
+     * Checks whether the assignment of the solver satisfies all given clauses
+     * @tparam S solver type
+     * @param solver solver holding the assignment
+     * @param clauses clauses to check
+     * @return true if every clause contains a satisfied literal
+     */
+    template<typename S, sat::clause_like Cl>
+    bool isModel(const S &solver, const std::vector<Cl> &clauses) {
+        return std::ranges::all_of(clauses, [&solver](const auto &clause) {
+            return std::ranges::any_of(clause, [&solver](sat::Literal l) { return solver.satisfied(l); });
+        });
+    }
+
+    /**
+     * Checks whether an assignment satisfies all given clauses
+     * @param assignment value of each variable
+     * @param clauses clauses to check
+     * @return true if every clause contains a true literal
+     */
+    template<sat::clause_like Cl>
+    bool isModel(const std::vector<sat::TruthValue> &assignment, const std::vector<Cl> &clauses) {
+        return std::ranges::all_of(clauses, [&assignment](const auto &clause) {
+            return std::ranges::any_of(clause, [&assignment](sat::Literal l) {
+                return to_underlying(assignment[sat::var(l).get()]) == l.sign();
+            });
+        });
+    }
+
+    /**
+     * Generates a uniform random 3-SAT formula
+     * @param numVariables number of variables
+     * @param numClauses number of clauses
+     * @param seed seed of the random number generator
+     * @return clauses over three distinct variables each
+     */
+    inline auto random3Sat(unsigned numVariables, unsigned numClauses, unsigned seed) {
+        using namespace sat;
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<unsigned> variable(0, numVariables - 1);
+        std::bernoulli_distribution sign;
+        std::vector<Clause> clauses;
+        while (clauses.size() < numClauses) {
+            Clause clause;
+            while (clause.size() < 3) {
+                const auto x = variable(rng);
+                if (std::ranges::none_of(clause, [x](Literal l) { return var(l).get() == x; })) {
+                    clause.emplace_back(sign(rng) ? pos(x) : neg(x));
+                }
+            }
+
+            clauses.emplace_back(std::move(clause));
+        }
+
+        return clauses;
+    }
+
+    /**
+     * Pigeonhole formula: every pigeon sits in one of the holes, no two pigeons share a hole
+     * @param pigeons number of pigeons
+     * @param holes number of holes
+     * @return clauses over the variables p * holes + h (pigeon p sits in hole h)
+     */
+    inline auto pigeonhole(unsigned pigeons, unsigned holes) {
+        using namespace sat;
+        std::vector<Clause> clauses;
+        for (unsigned p = 0; p < pigeons; ++p) {
+            auto &clause = clauses.emplace_back();
+            for (unsigned h = 0; h < holes; ++h) {
+                clause.emplace_back(pos(p * holes + h));
+            }
+        }
+
+        for (unsigned h = 0; h < holes; ++h) {
+            for (unsigned p = 0; p < pigeons; ++p) {
+                for (unsigned q = p + 1; q < pigeons; ++q) {
+                    clauses.emplace_back(Clause{neg(p * holes + h), neg(q * holes + h)});
+                }
+            }
+        }
+
+        return clauses;
+    }
+
+    /**
+     * Loads clauses from a file in dimacs format
+     * @param cnfFile path to the file
+     * @return pair of (clauses, number of variables)
+     */
+    inline auto loadProblem(const std::string &cnfFile) {
+        std::ifstream ifs(cnfFile);
+        if (not ifs.is_open()) {
+            std::cerr << "Could not open file " << cnfFile  <<". This should never happen" << std::endl;
+            std::exit(1);
+        }
+
+        return sat::inout::read_from_dimacs(ifs);
+    }
 }
 
 #endif //TESTING_UTILS_HPP
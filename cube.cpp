@@ -0,0 +1,63 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief Offline cube generation. Reads a problem in DIMACS format, splits it into cubes by lookahead and writes the
+* formula together with the cubes in iCNF format. The cubes can then be solved independently (e.g. on different
+* machines) using run_cubes
+*/
+
+#include <iostream>
+#include <fstream>
+
+#include "Solver/Preprocessor.hpp"
+#include "Solver/Solver.hpp"
+#include "Solver/inout.hpp"
+#include "Solver/util/cli.hpp"
+
+int main(int argc, char *argv[]) {
+    using namespace sat;
+    std::string output;
+    unsigned depth = 10;
+    const auto file = cli::parse(argc, argv, cli::ValueArg("-o", output), cli::ValueArg("-depth", depth));
+    std::ifstream in(file);
+    if (not in.is_open()) {
+        std::cerr << "Could not open file " << file << std::endl;
+        return 1;
+    }
+
+    auto [clauses, numVariables] = inout::read_from_dimacs(in);
+    // only equivalence preserving simplifications, models of the written formula are models of the original formula
+    Preprocessor preprocessor(std::move(clauses), numVariables,
+                              {.equivalentLiterals = false, .variableElimination = false, .blockedClauses = false});
+    preprocessor.run();
+    const auto simplified = preprocessor.getClauses();
+    Solver solver(static_cast<unsigned>(numVariables), {.elimination = false});
+    for (const auto &clause: simplified) {
+        if (not solver.addClause(clause)) {
+            break;
+        }
+    }
+
+    std::vector<Cube> refuted;
+    const auto cubes = solver.cube({}, depth, &refuted);
+    std::cout << "c generated " << cubes.size() << " cubes, " << refuted.size() << " cubes refuted by lookahead"
+              << std::endl;
+    if (cubes.empty()) {
+        std::cout << "c all cubes refuted, the formula is unsatisfiable" << std::endl;
+    }
+
+    // the simplified clauses may not contain the last variables, their count is written along
+    if (output.empty()) {
+        std::cout << inout::to_icnf(simplified, cubes, numVariables);
+        return 0;
+    }
+
+    std::ofstream out(output);
+    if (not out.is_open()) {
+        std::cerr << "Could not open output file " << output << std::endl;
+        return 1;
+    }
+
+    out << inout::to_icnf(simplified, cubes, numVariables);
+    return 0;
+}
@@ -0,0 +1,103 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief Throughput benchmark of the model verification. Compares the scalar loop over satisfied() that verified
+* models before with the scalar and AVX2 kernels of the ClauseEvaluator, on a given problem in DIMACS format or (with
+* "random" instead of a file) on a random 3-SAT formula
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Solver/ClauseEvaluator.hpp"
+#include "Solver/inout.hpp"
+#include "Solver/util/cli.hpp"
+
+namespace {
+    template<typename Check>
+    void run(const std::string &name, std::size_t numLiterals, unsigned rounds, Check &&check) {
+        std::size_t unsatisfied = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned r = 0; r < rounds; ++r) {
+            unsatisfied += check();
+        }
+
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << name << ": " << seconds / rounds * 1e6 << "us per check, "
+                  << static_cast<double>(numLiterals) * rounds / seconds / 1e9 << " G literals/s ("
+                  << unsatisfied / rounds << " unsatisfied clauses)" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    using namespace sat;
+    unsigned variables = 1000000;
+    unsigned rounds = 20;
+    const auto file = cli::parse(argc, argv, cli::ValueArg("-variables", variables),
+                                 cli::ValueArg("-rounds", rounds));
+    std::vector<Clause> clauses;
+    std::size_t numVariables = variables;
+    std::mt19937 rng(0);
+    std::bernoulli_distribution sign;
+    if (file != "random") {
+        std::ifstream in(file);
+        if (not in.is_open()) {
+            std::cerr << "Could not open file " << file << std::endl;
+            return 1;
+        }
+
+        std::tie(clauses, numVariables) = inout::read_from_dimacs(in);
+    }
+
+    std::vector<TruthValue> assignment(numVariables);
+    for (auto &value: assignment) {
+        value = sign(rng) ? TruthValue::True : TruthValue::False;
+    }
+
+    const auto satisfied = [&assignment](Literal l) { return to_underlying(assignment[var(l).get()]) == l.sign(); };
+    if (file == "random") {
+        // planted formula: clauses falsified by the assignment are redrawn, like the verification of a model
+        std::uniform_int_distribution<unsigned> variable(0, variables - 1);
+        clauses.resize(4 * static_cast<std::size_t>(variables));
+        for (auto &clause: clauses) {
+            do {
+                clause.clear();
+                for (unsigned i = 0; i < 3; ++i) {
+                    clause.emplace_back(sign(rng) ? pos(variable(rng)) : neg(variable(rng)));
+                }
+            } while (std::ranges::none_of(clause, satisfied));
+        }
+    }
+
+    std::size_t numLiterals = 0;
+    for (const auto &clause: clauses) {
+        numLiterals += clause.size();
+    }
+
+    std::cout << "c " << clauses.size() << " clauses, " << numLiterals << " literals" << std::endl;
+    // all variants evaluate every clause, no check stops early
+    run("satisfied() loop", numLiterals, rounds, [&] {
+        return static_cast<std::size_t>(std::ranges::count_if(clauses, [&satisfied](const auto &clause) {
+            return std::ranges::none_of(clause, satisfied);
+        }));
+    });
+
+    for (auto kernel: {EvaluationKernel::Scalar, EvaluationKernel::Avx2}) {
+        if (not ClauseEvaluator::supported(kernel)) {
+            std::cout << to_string(kernel) << ": not supported" << std::endl;
+            continue;
+        }
+
+        ClauseEvaluator evaluator(clauses, numVariables, kernel);
+        run(to_string(kernel) + " kernel", numLiterals, rounds, [&] {
+            return evaluator.countUnsatisfied(assignment);
+        });
+    }
+
+    return 0;
+}
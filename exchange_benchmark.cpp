@@ -0,0 +1,115 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief Throughput benchmark of the lock-free clause exchange against a mutex protected clause pool. Every thread
+* publishes clauses and collects the clauses of the other threads in between, like the portfolio workers do
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Solver/ClauseExchange.hpp"
+#include "Solver/util/cli.hpp"
+
+namespace {
+    /**
+     * @brief Baseline: shared deque protected by a mutex with per-consumer cursors
+     */
+    class MutexPool {
+        struct Entry {
+            sat::Clause literals;
+            unsigned lbd;
+            unsigned source;
+        };
+
+        std::mutex mutex;
+        std::deque<Entry> entries;
+        std::size_t offset = 0;
+        std::vector<std::size_t> cursors;
+
+    public:
+        explicit MutexPool(unsigned workers) : cursors(workers, 0) {}
+
+        bool publish(unsigned producer, const sat::Clause &clause, unsigned lbd) {
+            std::lock_guard lock(mutex);
+            entries.emplace_back(clause, lbd, producer);
+            return true;
+        }
+
+        void collect(unsigned consumer, std::vector<sat::ClauseSharing::SharedClause> &clauses) {
+            std::lock_guard lock(mutex);
+            auto &cursor = cursors[consumer];
+            for (; cursor < offset + entries.size(); ++cursor) {
+                const auto &entry = entries[cursor - offset];
+                if (entry.source != consumer) {
+                    clauses.emplace_back(entry.literals, entry.lbd);
+                }
+            }
+
+            for (const auto oldest = *std::ranges::min_element(cursors); offset < oldest; ++offset) {
+                entries.pop_front();
+            }
+        }
+    };
+
+    template<typename Exchange>
+    void run(const std::string &name, Exchange &exchange, unsigned threads, unsigned clauses) {
+        std::atomic_uint64_t received = 0;
+        std::atomic_uint64_t published = 0;
+        const auto start = std::chrono::steady_clock::now();
+        {
+            std::vector<std::jthread> workers;
+            for (unsigned w = 0; w < threads; ++w) {
+                workers.emplace_back([&, w] {
+                    std::vector<sat::ClauseSharing::SharedClause> buffer;
+                    std::uint64_t localReceived = 0;
+                    std::uint64_t localPublished = 0;
+                    sat::Clause clause;
+                    for (unsigned i = 0; i < clauses; ++i) {
+                        clause.clear();
+                        const auto id = w * clauses + i;
+                        for (unsigned j = 0; j < 2 + id % 7; ++j) {
+                            clause.emplace_back(2 * (id * 8 + j));
+                        }
+
+                        localPublished += exchange.publish(w, clause, 2 + i % 4);
+                        if (i % 16 == 15) {
+                            buffer.clear();
+                            exchange.collect(w, buffer);
+                            localReceived += buffer.size();
+                        }
+                    }
+
+                    received += localReceived;
+                    published += localPublished;
+                });
+            }
+        }
+
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << name << ": " << threads << " threads, published " << published << " of "
+                  << static_cast<std::uint64_t>(threads) * clauses << ", received " << received << " in " << seconds
+                  << "s, " << static_cast<double>(published + received) / seconds / 1e6 << " M clauses/s" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    unsigned clauses = 200000;
+    std::size_t capacity = 1 << 16;
+    const auto threads = static_cast<unsigned>(std::stoul(
+        cli::parse(argc, argv, cli::ValueArg("-clauses", clauses), cli::ValueArg("-capacity", capacity))));
+    sat::ClauseExchange exchange(threads, capacity);
+    run("lock-free exchange", exchange, threads, clauses);
+    const auto stats = exchange.getStatistics();
+    std::cout << "c dropped: " << stats.dropped << ", duplicates: " << stats.duplicates << std::endl;
+    MutexPool pool(threads);
+    run("mutex pool", pool, threads, clauses);
+    return 0;
+}
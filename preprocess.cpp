@@ -0,0 +1,59 @@
+/**
+* @author Tim Luchterhand
+* @date 18.10.26
+* @brief Standalone preprocessor. Reads a problem in DIMACS format and writes the simplified problem in DIMACS format
+*/
+
+#include <iostream>
+#include <fstream>
+
+#include "Solver/Preprocessor.hpp"
+#include "Solver/inout.hpp"
+#include "Solver/util/cli.hpp"
+
+int main(int argc, char *argv[]) {
+    using namespace sat;
+    std::string output;
+    unsigned growth = 0;
+    unsigned occurrenceLimit = PreprocessorConfig{}.occurrenceLimit;
+    bool coveredClauses = false;
+    const auto file = cli::parse(argc, argv, cli::ValueArg("-o", output), cli::ValueArg("-grow", growth),
+                                 cli::ValueArg("-occ-limit", occurrenceLimit), cli::Switch("-cce", coveredClauses));
+    std::ifstream in(file);
+    if (not in.is_open()) {
+        std::cerr << "Could not open file " << file << std::endl;
+        return 1;
+    }
+
+    auto [clauses, numVariables] = inout::read_from_dimacs(in);
+    const auto numClauses = clauses.size();
+    Preprocessor preprocessor(std::move(clauses), numVariables,
+                              {.eliminationGrowth = growth, .occurrenceLimit = occurrenceLimit,
+                               .coveredClauses = coveredClauses});
+    preprocessor.run();
+    const auto simplified = preprocessor.getClauses();
+    const auto &stats = preprocessor.getStatistics();
+    std::cout << "c eliminated " << stats.eliminatedVariables << " and substituted " << stats.substitutedVariables << " of "
+              << numVariables << " variables, "
+              << numClauses << " -> " << simplified.size() << " clauses" << std::endl;
+    std::cout << "c removed " << stats.blockedClauses << " blocked and " << stats.coveredClauses << " covered clauses"
+              << std::endl;
+    for (std::size_t round = 0; round < stats.substitutionsPerRound.size(); ++round) {
+        std::cout << "c equivalent literal substitution round " << round + 1 << ": removed "
+                  << stats.substitutionsPerRound[round] << " variables" << std::endl;
+    }
+
+    if (output.empty()) {
+        std::cout << inout::to_dimacs(simplified);
+        return 0;
+    }
+
+    std::ofstream out(output);
+    if (not out.is_open()) {
+        std::cerr << "Could not open output file " << output << std::endl;
+        return 1;
+    }
+
+    out << inout::to_dimacs(simplified);
+    return 0;
+}
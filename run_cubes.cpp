@@ -0,0 +1,75 @@
+/**
+* @author Tim Luchterhand
+* @date 19.10.26
+* @brief Cube runner. Reads a problem in iCNF format (e.g. written by the cube executable) and solves the cubes of the
+* given range one after another with a single incremental solver. Prints the model in DIMACS format as soon as a cube
+* is satisfiable, otherwise REFUTED if all cubes of the range were refuted or UNKNOWN if a cube exceeded the conflict
+* limit
+*/
+
+#include <iostream>
+#include <fstream>
+#include <limits>
+
+#include "Solver/Solver.hpp"
+#include "Solver/ClauseEvaluator.hpp"
+#include "Solver/inout.hpp"
+#include "Solver/util/cli.hpp"
+
+int main(int argc, char *argv[]) {
+    using namespace sat;
+    std::size_t from = 1;
+    std::size_t to = 0;
+    std::uint64_t conflicts = 0;
+    const auto file = cli::parse(argc, argv, cli::ValueArg("-from", from), cli::ValueArg("-to", to),
+                                 cli::ValueArg("-conflicts", conflicts));
+    std::ifstream in(file);
+    if (not in.is_open()) {
+        std::cerr << "Could not open file " << file << std::endl;
+        return 1;
+    }
+
+    auto [clauses, cubes, numVariables] = inout::read_from_icnf(in);
+    // cube indices count the assumption lines of the file starting from 1, 0 denotes the last cube
+    to = to == 0 ? cubes.size() : to;
+    if (from == 0 || from > to || to > cubes.size()) {
+        std::cerr << "Invalid cube range " << from << " to " << to << ", the file contains " << cubes.size()
+                  << " cubes" << std::endl;
+        return 1;
+    }
+
+    Solver solver(static_cast<unsigned>(numVariables), {.elimination = false});
+    for (const auto &clause: clauses) {
+        if (not solver.addClause(clause)) {
+            break;
+        }
+    }
+
+    const auto limit = conflicts == 0 ? std::numeric_limits<std::uint64_t>::max() : conflicts;
+    bool unknown = false;
+    for (auto index = from; index <= to; ++index) {
+        const auto result = solver.solve(cubes[index - 1], limit);
+        if (result == SolverResult::Sat) {
+            std::cout << "c cube " << index << " satisfiable" << std::endl;
+            std::vector<Literal> literals;
+            literals.reserve(numVariables);
+            for (unsigned x = 0; x < numVariables; ++x) {
+                literals.emplace_back(solver.val(x) == TruthValue::True ? pos(x) : neg(x));
+            }
+
+            if (not ClauseEvaluator(clauses, numVariables).satisfies(solver.getModel())) {
+                std::cerr << "c model verification failed" << std::endl;
+                return 1;
+            }
+
+            std::cout << inout::to_dimacs(literals);
+            return 0;
+        }
+
+        std::cout << "c cube " << index << (result == SolverResult::Unsat ? " refuted" : " unknown") << std::endl;
+        unknown |= result == SolverResult::Unknown;
+    }
+
+    std::cout << (unknown ? "UNKNOWN" : "REFUTED") << std::endl;
+    return 0;
+}
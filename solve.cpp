@@ -0,0 +1,315 @@
+/**
+* @author Tim Luchterhand
+* @date 18.10.26
+* @brief Solver executable. Reads a problem in DIMACS format, simplifies it and runs the CDCL search. Prints UNSAT or
+* the model in DIMACS format. Optionally writes a DRAT or LRAT proof for unsatisfiable problems or runs stochastic local
+* search before the systematic search
+*/
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+#include "Solver/Solver.hpp"
+#include "Solver/ClauseEvaluator.hpp"
+#include "Solver/CubeAndConquer.hpp"
+#include "Solver/LocalSearch.hpp"
+#include "Solver/LookaheadSolver.hpp"
+#include "Solver/Portfolio.hpp"
+#include "Solver/Preprocessor.hpp"
+#include "Solver/ProofWriter.hpp"
+#include "Solver/SurveyPropagation.hpp"
+#include "Solver/inout.hpp"
+#include "Solver/util/cli.hpp"
+
+int main(int argc, char *argv[]) {
+    using namespace sat;
+    bool noPreprocessing = false;
+    bool printStatistics = false;
+    bool coveredClauses = false;
+    bool symmetryBreaking = false;
+    bool reportCubes = false;
+    bool deterministic = false;
+    bool binaryProof = false;
+    bool lratProof = false;
+    bool hybrid = false;
+    bool surveyPropagation = false;
+    bool lookahead = false;
+    unsigned threads = 1;
+    unsigned cubeDepth = 0;
+    int maxFlips = -1;
+    std::string proofFile;
+    std::string localSearch;
+    const auto file = cli::parse(argc, argv, cli::Switch("-no-preprocessing", noPreprocessing),
+                                 cli::Switch("-stats", printStatistics), cli::Switch("-cce", coveredClauses),
+                                 cli::Switch("-symmetry", symmetryBreaking),
+                                 cli::ValueArg("-threads", threads), cli::ValueArg("-cubes", cubeDepth),
+                                 cli::Switch("-report-cubes", reportCubes),
+                                 cli::Switch("-deterministic", deterministic), cli::ValueArg("-proof", proofFile),
+                                 cli::Switch("-binary-proof", binaryProof), cli::Switch("-lrat", lratProof),
+                                 cli::ValueArg("-local-search", localSearch), cli::ValueArg("-flips", maxFlips),
+                                 cli::Switch("-hybrid", hybrid), cli::Switch("-sp", surveyPropagation),
+                                 cli::Switch("-lookahead", lookahead));
+    std::ifstream in(file);
+    if (not in.is_open()) {
+        std::cerr << "Could not open file " << file << std::endl;
+        return 1;
+    }
+
+    if (not localSearch.empty() and localSearch != "probsat" and localSearch != "walksat") {
+        std::cerr << "Unknown local search algorithm " << localSearch << " (probsat or walksat)" << std::endl;
+        return 1;
+    }
+
+    // the walks of the hybrid mode run as inprocessing, which the deterministic portfolio disables
+    if (hybrid and deterministic and threads > 1) {
+        std::cerr << "Hybrid mode is not available in the deterministic portfolio" << std::endl;
+        return 1;
+    }
+
+    std::ofstream proofOut;
+    std::optional<ProofWriter> proof;
+    if (not proofFile.empty()) {
+        // clauses imported from other workers are not derived in the proof of the receiving solver
+        if (threads > 1 or cubeDepth > 0 or lookahead) {
+            std::cerr << "Proofs are only supported by the sequential solver" << std::endl;
+            return 1;
+        }
+
+        if (binaryProof and lratProof) {
+            std::cerr << "LRAT proofs are only written in text format" << std::endl;
+            return 1;
+        }
+
+        proofOut.open(proofFile, std::ios::binary);
+        if (not proofOut.is_open()) {
+            std::cerr << "Could not open file " << proofFile << std::endl;
+            return 1;
+        }
+
+        proof.emplace(proofOut, lratProof ? ProofFormat::Lrat : binaryProof ? ProofFormat::Binary : ProofFormat::Text);
+    }
+
+    ProofWriter *proofWriter = proof ? &*proof : nullptr;
+
+    auto [clauses, numVariables] = inout::read_from_dimacs(in);
+    if (proof) {
+        // the solver may derive root level units while the input clauses are still being added
+        proof->reserveInputs(clauses.size());
+    }
+
+    std::vector<Clause> simplified;
+    ReconstructionStack reconstruction;
+    // symmetry breaking introduces auxiliary variables
+    auto simplifiedVariables = numVariables;
+    // the sequential solver takes over the simplified formula directly such that proof identifiers are preserved
+    std::optional<Preprocessor> preprocessor;
+    if (noPreprocessing) {
+        simplified = clauses;
+    } else {
+        preprocessor.emplace(clauses, numVariables,
+                             PreprocessorConfig{.coveredClauses = coveredClauses, .symmetryBreaking = symmetryBreaking},
+                             proofWriter);
+        preprocessor->run();
+        simplifiedVariables = preprocessor->getNumVariables();
+        const auto &stats = preprocessor->getStatistics();
+        std::cout << "c preprocessing: eliminated " << stats.eliminatedVariables << " variables, removed "
+                  << stats.removedClauses << " clauses, added " << stats.resolvents << " resolvents, subsumed "
+                  << stats.subsumedClauses << " and strengthened " << stats.strengthenedClauses << " clauses, substituted "
+                  << stats.substitutedVariables << " equivalent variables, removed " << stats.blockedClauses
+                  << " blocked and " << stats.coveredClauses << " covered clauses" << std::endl;
+        if (symmetryBreaking) {
+            std::cout << "c symmetry breaking: " << stats.symmetryGenerators << " generators, "
+                      << stats.symmetryBreakingClauses << " clauses over " << stats.auxiliaryVariables
+                      << " auxiliary variables in " << stats.symmetryTime << "s" << std::endl;
+        }
+
+        if (threads > 1 or cubeDepth > 0 or not localSearch.empty() or surveyPropagation or lookahead) {
+            simplified = preprocessor->getClauses();
+            reconstruction = preprocessor->getReconstructionStack();
+        }
+    }
+
+    const auto report = [&clauses, numVariables](SolverResult result, const auto &solver) {
+        if (result == SolverResult::Unsat) {
+            std::cout << "UNSAT" << std::endl;
+            return 0;
+        }
+
+        if (not ClauseEvaluator(clauses, numVariables).satisfies(solver.getModel())) {
+            std::cerr << "c model verification failed" << std::endl;
+            return 1;
+        }
+
+        std::vector<Literal> literals;
+        literals.reserve(numVariables);
+        for (unsigned x = 0; x < numVariables; ++x) {
+            literals.emplace_back(solver.val(x) == TruthValue::True ? pos(x) : neg(x));
+        }
+
+        std::cout << inout::to_dimacs(literals);
+        return 0;
+    };
+
+    if (surveyPropagation) {
+        SurveyPropagation decimation(simplified, simplifiedVariables);
+        decimation.reconstructionStack() = reconstruction;
+        const auto result = decimation.solve();
+        const auto &stats = decimation.getStatistics();
+        std::cout << "c survey propagation: " << stats.sweeps << " sweeps, " << stats.decimationSteps
+                  << " decimation steps, fixed " << stats.fixedVariables << " variables (+" << stats.propagatedVariables
+                  << " propagated) in " << stats.time << "s" << (stats.converged ? "" : ", surveys diverged")
+                  << (stats.contradiction ? ", contradiction" : "") << ", residual formula: " << stats.residualClauses
+                  << " clauses over " << stats.residualVariables << " variables" << std::endl;
+        if (result == SolverResult::Sat) {
+            return report(result, decimation);
+        }
+
+        // the decimation may fix variables inconsistently, the systematic search on the whole formula takes over
+    }
+
+    if (not localSearch.empty()) {
+        const auto algorithm = localSearch == "walksat" ? LocalSearchAlgorithm::WalkSat : LocalSearchAlgorithm::ProbSat;
+        LocalSearch search(simplified, simplifiedVariables, {.algorithm = algorithm});
+        search.reconstructionStack() = reconstruction;
+        // local search cannot refute the formula, without an explicit budget it gets 1000 flips per clause
+        const auto budget = maxFlips < 0 ? 1000 * static_cast<std::uint64_t>(simplified.size())
+                            : maxFlips > 0 ? static_cast<std::uint64_t>(maxFlips)
+                            : std::numeric_limits<std::uint64_t>::max();
+        const auto result = search.solve(budget);
+        const auto &stats = search.getStatistics();
+        std::cout << "c local search: " << stats.flips << " flips in " << stats.time << "s ("
+                  << static_cast<std::uint64_t>(stats.flipsPerSecond()) << " flips/s), fewest unsatisfied clauses: "
+                  << stats.bestUnsatisfied << std::endl;
+        if (result == SolverResult::Sat) {
+            return report(result, search);
+        }
+
+        // local search cannot refute the formula, the systematic search takes over once the flip budget is exhausted
+    }
+
+    if (lookahead) {
+        LookaheadSolver engine(simplified, simplifiedVariables);
+        engine.reconstructionStack() = reconstruction;
+        const auto result = engine.solve();
+        const auto &stats = engine.getStatistics();
+        std::cout << "c lookahead: " << stats.nodes << " nodes, " << stats.lookaheads << " lookaheads, "
+                  << stats.failedLiterals << " failed literals, " << stats.necessaryAssignments
+                  << " necessary assignments, " << stats.doubleLookaheads << " double lookaheads ("
+                  << stats.doubleLookaheadFailures << " failed literals), " << stats.learnedImplications
+                  << " learned implications in " << stats.time << "s" << std::endl;
+        return report(result, engine);
+    }
+
+    if (cubeDepth > 0) {
+        CubeAndConquer cubeAndConquer(std::move(simplified), static_cast<unsigned>(simplifiedVariables),
+                                      {.threads = threads, .depth = cubeDepth});
+        cubeAndConquer.reconstructionStack() = std::move(reconstruction);
+        const auto result = cubeAndConquer.solve();
+        const auto &stats = cubeAndConquer.getStatistics();
+        std::cout << "c cubes: " << stats.cubes << ", refuted: " << stats.refutedCubes << ", steals: " << stats.steals
+                  << ", splits: " << stats.splits << ", cubing time: " << stats.cubingTime << "s" << std::endl;
+        if (reportCubes) {
+            for (const auto &cube: cubeAndConquer.getRefutedCubes()) {
+                std::cout << "c refuted";
+                for (Literal l: cube) {
+                    std::cout << " " << inout::to_dimacs(l);
+                }
+
+                std::cout << " 0" << std::endl;
+            }
+        }
+
+        return report(result, cubeAndConquer);
+    }
+
+    if (threads > 1) {
+        Portfolio portfolio(std::move(simplified), static_cast<unsigned>(simplifiedVariables),
+                            {.threads = threads, .deterministic = deterministic,
+                             .solverConfig = {.elimination = true, .localSearch = hybrid}});
+        portfolio.reconstructionStack() = std::move(reconstruction);
+        const auto result = portfolio.solve();
+        std::cout << "c result found by worker " << portfolio.getWinner().value_or(0) << std::endl;
+        if (printStatistics) {
+            const auto &statistics = portfolio.getStatistics();
+            for (std::size_t worker = 0; worker < statistics.size(); ++worker) {
+                const auto &stats = statistics[worker];
+                std::cout << "c worker " << worker << ": decisions: " << stats.decisions << ", conflicts: "
+                          << stats.conflicts << ", restarts: " << stats.restarts << ", exported: "
+                          << stats.exportedClauses << ", imported: " << stats.importedClauses << std::endl;
+            }
+
+            const auto &exchange = portfolio.getExchangeStatistics();
+            std::cout << "c clause exchange: published: " << exchange.published << ", dropped: " << exchange.dropped
+                      << ", duplicates: " << exchange.duplicates << std::endl;
+        }
+
+        return report(result, portfolio);
+    }
+
+    Solver solver(static_cast<unsigned>(simplifiedVariables), {.elimination = true, .localSearch = hybrid});
+    solver.setProof(proofWriter);
+    if (preprocessor) {
+        preprocessor->transferTo(solver);
+        preprocessor.reset();
+    } else {
+        for (const auto &clause: simplified) {
+            if (not solver.addClause(clause)) {
+                break;
+            }
+        }
+    }
+
+    const auto result = solver.solve();
+    if (printStatistics) {
+        const auto &stats = solver.getStatistics();
+        std::cout << "c decisions: " << stats.decisions << ", conflicts: " << stats.conflicts << ", propagations: "
+                  << stats.propagations << ", restarts: " << stats.restarts << ", learned: " << stats.learnedClauses
+                  << ", deleted: " << stats.deletedClauses << ", subsumed learned: " << stats.subsumedClauses
+                  << ", strengthened learned: " << stats.strengthenedClauses << std::endl;
+        std::cout << "c probed: " << stats.probedLiterals << ", failed literals: " << stats.failedLiterals
+                  << ", hyper-binary resolvents: " << stats.hyperBinaries << std::endl;
+        std::cout << "c vivified: " << stats.vivifiedClauses << " clauses, removed literals: " << stats.vivifiedLiterals
+                  << std::endl;
+        std::cout << "c search time: " << stats.searchTime << "s" << std::endl;
+        if (stats.bitParallelCalls > 0) {
+            std::cout << "c bit-parallel search: " << stats.bitParallelConflicts << " conflicts" << std::endl;
+        }
+
+        if (stats.xorConstraints > 0) {
+            std::cout << "c xor constraints: " << stats.xorConstraints << ", propagations: " << stats.xorPropagations
+                      << ", conflicts: " << stats.xorConflicts << std::endl;
+        }
+
+        if (stats.cardinalityConstraints > 0) {
+            std::cout << "c at-most-k constraints: " << stats.cardinalityConstraints << " replacing "
+                      << stats.cardinalityClauses << " clauses, propagations: " << stats.cardinalityPropagations
+                      << ", conflicts: " << stats.cardinalityConflicts << std::endl;
+        }
+
+        if (hybrid) {
+            std::cout << "c local search: " << stats.flips << " flips, " << stats.walkImprovement
+                      << " clauses repaired in the saved phases" << std::endl;
+        }
+
+        const std::pair<const char *, const InprocessingStatistics &> techniques[] = {
+            {"subsumption", stats.subsumption}, {"probing", stats.probing}, {"elimination", stats.elimination},
+            {"vivification", stats.vivification}, {"local search", stats.localSearch}};
+        for (const auto &[name, technique]: techniques) {
+            std::cout << "c " << name << ": " << technique.calls << " calls, " << technique.time << "s ("
+                      << (stats.searchTime > 0 ? 100 * technique.time / stats.searchTime : 0)
+                      << "% of search), effect: " << technique.effect << std::endl;
+        }
+
+        if (proof) {
+            proof->flush();
+            const auto &proofStats = proof->getStatistics();
+            std::cout << "c proof: " << proofStats.additions << " additions, " << proofStats.deletions
+                      << " deletions, " << proofStats.bytes << " bytes" << std::endl;
+        }
+    }
+
+    return report(result, solver);
+}